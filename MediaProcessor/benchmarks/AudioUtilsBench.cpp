@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/AudioProcessor.h"
+#include "../src/AudioUtils.h"
+#include "BenchUtils.h"
+
+namespace MediaProcessor::Bench {
+
+namespace {
+
+constexpr size_t OVERLAP_SAMPLES = static_cast<size_t>(DEFAULT_OVERLAP_DURATION * 48000);
+
+void BM_Crossfade(benchmark::State& state) {
+    const size_t numSamples = static_cast<size_t>(state.range(0));
+    std::vector<float> fadeOut = generateSignal(numSamples);
+    std::vector<float> fadeIn(fadeOut.rbegin(), fadeOut.rend());
+    std::vector<float> output(numSamples);
+
+    for (auto _ : state) {
+        AudioUtils::crossfade(fadeOut.data(), fadeIn.data(), output.data(), numSamples);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numSamples);
+}
+BENCHMARK(BM_Crossfade)->Arg(OVERLAP_SAMPLES)->Arg(1 << 20);
+
+}  // namespace
+
+}  // namespace MediaProcessor::Bench
@@ -0,0 +1,50 @@
+#ifndef BENCHUTILS_H
+#define BENCHUTILS_H
+
+#include <filesystem>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+#include "../src/AudioDecoder.h"
+#include "../src/ConfigManager.h"
+#include "../src/SignalGenerator.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor::Bench {
+
+/**
+ * @brief Mono speech-over-music test signal, see SignalGenerator.h.
+ *
+ * Deterministic for a given length, so runs on different commits filter the same audio.
+ */
+inline std::vector<float> generateSignal(size_t numSamples,
+                                         int sampleRate = DEFAULT_DECODE_SAMPLE_RATE) {
+    std::vector<float> samples(numSamples);
+    SignalGenerator(sampleRate, 1).generate(samples.data(), numSamples);
+    return samples;
+}
+
+/**
+ * @brief Loads a configuration pointing at the repository's model, written to `configPath`.
+ *
+ * @return false if the model has not been downloaded, benchmarks needing it are skipped.
+ */
+inline bool loadBenchConfig(const fs::path& configPath) {
+    const nlohmann::json config = {{"deep_filter_path", ""},
+                                   {"deep_filter_tarball_path", BENCH_MODEL_PATH},
+                                   {"deep_filter_encoder_path", ""},
+                                   {"deep_filter_decoder_path", ""},
+                                   {"ffmpeg_path", "/usr/bin/ffmpeg"},
+                                   {"use_thread_cap", false},
+                                   {"max_threads_if_capped", 1},
+                                   {"filter_attenuation_limit", 100.0f}};
+    std::ofstream(configPath) << config.dump(4);
+
+    return ConfigManager::getInstance().loadConfig(configPath) && fs::exists(BENCH_MODEL_PATH);
+}
+
+}  // namespace MediaProcessor::Bench
+
+#endif  // BENCHUTILS_H
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/AudioProcessor.h"
+#include "../src/DFStatePool.h"
+#include "../src/WavFileWriter.h"
+#include "BenchUtils.h"
+
+namespace MediaProcessor::Bench {
+
+namespace {
+
+const fs::path BENCH_DIR = fs::temp_directory_path() / "MediaProcessorBench";
+
+bool prepareModel(benchmark::State& state) {
+    fs::create_directories(BENCH_DIR);
+    if (!loadBenchConfig(BENCH_DIR / "config.json")) {
+        state.SkipWithError("DeepFilterNet model not found, see README.md.");
+        return false;
+    }
+    return true;
+}
+
+// DeepFilterNet frame loop over a 10s work unit on a warm pooled state
+void BM_DFStatePool_Process(benchmark::State& state) {
+    if (!prepareModel(state)) {
+        return;
+    }
+    const std::vector<float> samples = generateSignal(10 * DEFAULT_DECODE_SAMPLE_RATE);
+    std::vector<float> processedSamples(samples.size());
+    const fs::path modelPath = ConfigManager::getInstance().getDeepFilterTarballPath();
+
+    for (auto _ : state) {
+        DFStatePool::Lease lease = DFStatePool::getInstance().acquire(modelPath, 100.0f);
+        lease.process(samples, processedSamples);
+        benchmark::DoNotOptimize(processedSamples.data());
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    state.counters["RTF"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * samples.size()) / DEFAULT_DECODE_SAMPLE_RATE,
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_DFStatePool_Process)->Unit(benchmark::kMillisecond);
+
+// Whole job on state.range(0) seconds of generated audio: decode, filter, merge and write
+void BM_AudioProcessor_IsolateVocals(benchmark::State& state) {
+    if (!prepareModel(state)) {
+        return;
+    }
+    const size_t numSamples = static_cast<size_t>(state.range(0)) * DEFAULT_DECODE_SAMPLE_RATE;
+    const std::vector<float> samples = generateSignal(numSamples);
+    const fs::path inputPath = BENCH_DIR / "input.wav";
+    const fs::path outputPath = BENCH_DIR / "output" / "output.wav";
+    try {
+        WavFileWriter writer(inputPath, DEFAULT_DECODE_SAMPLE_RATE);
+        writer.write(samples.data(), samples.size());
+    } catch (const std::runtime_error& ex) {
+        state.SkipWithError(ex.what());
+        return;
+    }
+
+    for (auto _ : state) {
+        AudioProcessor audioProcessor(inputPath, outputPath);
+        if (!audioProcessor.isolateVocals()) {
+            state.SkipWithError("Processing failed.");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numSamples);
+    state.counters["RTF"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * state.range(0)),
+        benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_AudioProcessor_IsolateVocals)->Arg(60)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+}  // namespace
+
+}  // namespace MediaProcessor::Bench
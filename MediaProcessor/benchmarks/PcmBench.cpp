@@ -0,0 +1,167 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/AudioDecoder.h"
+#include "../src/PcmKernels.h"
+#include "../src/PolyphaseResampler.h"
+#include "../src/WavFileWriter.h"
+#include "BenchUtils.h"
+
+namespace MediaProcessor::Bench {
+
+namespace {
+
+/**
+ * @brief Selects the kernels of `state.range(0)` for one benchmark, skipping unsupported ones.
+ *
+ * @return false if the CPU lacks the instruction set.
+ */
+bool selectSimdLevel(benchmark::State& state) {
+    const auto level = static_cast<PcmKernels::SimdLevel>(state.range(0));
+    if (!PcmKernels::setSimdLevel(level)) {
+        state.SkipWithError("Instruction set not supported by this CPU.");
+        return false;
+    }
+    state.SetLabel(PcmKernels::getSimdLevelName(level));
+    return true;
+}
+
+void addSimdLevels(benchmark::internal::Benchmark* benchmark) {
+    for (auto level : {PcmKernels::SimdLevel::Scalar, PcmKernels::SimdLevel::SSE2,
+                       PcmKernels::SimdLevel::AVX2, PcmKernels::SimdLevel::AVX512,
+                       PcmKernels::SimdLevel::NEON}) {
+        benchmark->Arg(static_cast<int64_t>(level));
+    }
+}
+
+// Float to 16-bit PCM per instruction set, one second of 5.1 audio
+void BM_PcmKernels_FloatToS16(benchmark::State& state) {
+    const std::vector<float> samples = generateSignal(6 * DEFAULT_DECODE_SAMPLE_RATE);
+    std::vector<int16_t> output(samples.size());
+    if (!selectSimdLevel(state)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        PcmKernels::convertFromFloat(samples, PcmKernels::SampleFormat::S16, output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    PcmKernels::setSimdLevel(PcmKernels::getSupportedSimdLevel());
+}
+BENCHMARK(BM_PcmKernels_FloatToS16)->Apply(addSimdLevels);
+
+// Interleaved 16-bit 5.1 to planar float, as multi-channel input is split per channel
+void BM_PcmKernels_DeinterleaveS16(benchmark::State& state) {
+    constexpr size_t channels = 6;
+    const size_t numFrames = DEFAULT_DECODE_SAMPLE_RATE;
+    std::vector<int16_t> interleaved(channels * numFrames);
+    PcmKernels::convertFromFloat(generateSignal(interleaved.size()),
+                                 PcmKernels::SampleFormat::S16, interleaved.data());
+
+    std::vector<std::vector<float>> planes(channels, std::vector<float>(numFrames));
+    std::vector<float*> outputs;
+    for (auto& plane : planes) {
+        outputs.push_back(plane.data());
+    }
+    if (!selectSimdLevel(state)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        PcmKernels::deinterleaveToFloat(interleaved.data(), PcmKernels::SampleFormat::S16,
+                                        numFrames, outputs);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * interleaved.size());
+    PcmKernels::setSimdLevel(PcmKernels::getSupportedSimdLevel());
+}
+BENCHMARK(BM_PcmKernels_DeinterleaveS16)->Apply(addSimdLevels);
+
+// Downmix accumulation, one channel added to another with a gain
+void BM_PcmKernels_Mix(benchmark::State& state) {
+    const std::vector<float> input = generateSignal(DEFAULT_DECODE_SAMPLE_RATE);
+    std::vector<float> output(input.size(), 0.0f);
+    if (!selectSimdLevel(state)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        PcmKernels::mix(output, input, 0.7071f);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+    PcmKernels::setSimdLevel(PcmKernels::getSupportedSimdLevel());
+}
+BENCHMARK(BM_PcmKernels_Mix)->Apply(addSimdLevels);
+
+// 44.1kHz to 48kHz per instruction set, one second of a podcast channel in blocks of 4096
+void BM_PolyphaseResampler_44100To48000(benchmark::State& state) {
+    constexpr size_t blockFrames = 4096;
+    const std::vector<float> input = generateSignal(44100, 44100);
+    PolyphaseResampler resampler(44100, DEFAULT_DECODE_SAMPLE_RATE);
+    std::vector<float> output;
+    if (!selectSimdLevel(state)) {
+        return;
+    }
+
+    for (auto _ : state) {
+        for (size_t offset = 0; offset < input.size(); offset += blockFrames) {
+            const std::span<const float> block(input.data() + offset,
+                                               std::min(blockFrames, input.size() - offset));
+            output.resize(resampler.getMaxOutputFrames(block.size()));
+            resampler.process(block, output.data());
+        }
+        output.resize(resampler.getMaxOutputFrames(0));
+        resampler.flush(output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * input.size());
+    PcmKernels::setSimdLevel(PcmKernels::getSupportedSimdLevel());
+}
+BENCHMARK(BM_PolyphaseResampler_44100To48000)->Apply(addSimdLevels);
+
+// Float to 16-bit PCM, as the processed audio is written
+void BM_WavFileWriter_Write(benchmark::State& state) {
+    const std::vector<float> samples = generateSignal(10 * DEFAULT_DECODE_SAMPLE_RATE);
+    const fs::path outputPath = fs::temp_directory_path() / "MediaProcessorBench_write.wav";
+
+    for (auto _ : state) {
+        WavFileWriter writer(outputPath, DEFAULT_DECODE_SAMPLE_RATE);
+        writer.write(samples.data(), samples.size());
+        writer.close();
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    fs::remove(outputPath);
+}
+BENCHMARK(BM_WavFileWriter_Write)->Unit(benchmark::kMillisecond);
+
+// 16-bit PCM to mono float at 48kHz in 10s blocks as the pipeline reads it, resampled if the
+// input rate differs
+void BM_AudioDecoder_Read(benchmark::State& state) {
+    const int inputSampleRate = static_cast<int>(state.range(0));
+    const std::vector<float> samples = generateSignal(10 * inputSampleRate, inputSampleRate);
+    const fs::path inputPath = fs::temp_directory_path() / "MediaProcessorBench_read.wav";
+    try {
+        WavFileWriter writer(inputPath, inputSampleRate);
+        writer.write(samples.data(), samples.size());
+    } catch (const std::runtime_error& ex) {
+        state.SkipWithError(ex.what());
+        return;
+    }
+
+    std::vector<float> decoded(10 * DEFAULT_DECODE_SAMPLE_RATE);
+    for (auto _ : state) {
+        AudioDecoder decoder(DEFAULT_DECODE_SAMPLE_RATE);
+        decoder.open(inputPath);
+        while (decoder.read(decoded.data(), decoded.size()) > 0) {
+            benchmark::DoNotOptimize(decoded.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * samples.size());
+    fs::remove(inputPath);
+}
+BENCHMARK(BM_AudioDecoder_Read)->Arg(48000)->Arg(44100)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace MediaProcessor::Bench
@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace MediaProcessor::Bench {
+
+namespace {
+
+constexpr size_t TASKS_PER_ITERATION = 10000;
+
+// Enqueue and dispatch overhead of empty tasks on state.range(0) workers
+void BM_ThreadPool_Submit(benchmark::State& state) {
+    ThreadPool pool(state.range(0));
+    std::atomic<size_t> completed = 0;
+
+    for (auto _ : state) {
+        completed.store(0, std::memory_order_relaxed);
+        for (size_t i = 0; i < TASKS_PER_ITERATION; ++i) {
+            pool.submit([&completed]() { completed.fetch_add(1, std::memory_order_release); });
+        }
+        while (completed.load(std::memory_order_acquire) < TASKS_PER_ITERATION) {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+BENCHMARK(BM_ThreadPool_Submit)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+void BM_ThreadPool_Enqueue(benchmark::State& state) {
+    ThreadPool pool(state.range(0));
+    std::vector<std::future<size_t>> results;
+    results.reserve(TASKS_PER_ITERATION);
+
+    for (auto _ : state) {
+        results.clear();
+        for (size_t i = 0; i < TASKS_PER_ITERATION; ++i) {
+            results.push_back(pool.enqueue([i]() { return i; }));
+        }
+        for (auto& result : results) {
+            benchmark::DoNotOptimize(result.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * TASKS_PER_ITERATION);
+}
+BENCHMARK(BM_ThreadPool_Enqueue)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+void BM_ThreadPool_ParallelFor(benchmark::State& state) {
+    ThreadPool pool(state.range(0));
+    std::vector<float> values(1 << 20, 1.0f);
+
+    for (auto _ : state) {
+        pool.parallel_for(0, values.size(), 4096, [&values](size_t i) { values[i] *= 1.0001f; });
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_ThreadPool_ParallelFor)->Arg(1)->Arg(4)->Arg(16)->UseRealTime();
+
+}  // namespace
+
+}  // namespace MediaProcessor::Bench
@@ -0,0 +1,77 @@
+# CMake configuration for the MediaProcessorBench microbenchmarks
+#
+# Results can be saved as JSON and compared between commits with Google Benchmark's compare.py:
+#   ./MediaProcessorBench --benchmark_out=bench.json --benchmark_out_format=json
+#   compare.py benchmarks baseline.json bench.json
+
+include(FetchContent)
+
+find_package(benchmark QUIET)
+if(NOT benchmark_FOUND)
+    # Fetch Google Benchmark if not found
+    FetchContent_Declare(
+        googlebenchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG v1.8.3
+    )
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(googlebenchmark)
+endif()
+
+add_executable(MediaProcessorBench
+    ${CMAKE_SOURCE_DIR}/benchmarks/AudioUtilsBench.cpp
+    ${CMAKE_SOURCE_DIR}/benchmarks/PcmBench.cpp
+    ${CMAKE_SOURCE_DIR}/benchmarks/ThreadPoolBench.cpp
+    ${CMAKE_SOURCE_DIR}/benchmarks/DeepFilterBench.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioProcessor.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp
+    ${CMAKE_SOURCE_DIR}/src/SignalGenerator.cpp
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp
+    ${CMAKE_SOURCE_DIR}/src/WavFileWriter.cpp
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp
+    ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp
+    ${CMAKE_SOURCE_DIR}/src/Utils.cpp
+    ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp
+    ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp
+)
+
+target_compile_definitions(MediaProcessorBench PRIVATE
+    BENCH_MODEL_PATH="${CMAKE_SOURCE_DIR}/res/DeepFilterNet3_ll_onnx.tar.gz")
+
+target_link_libraries(MediaProcessorBench PRIVATE
+    benchmark::benchmark_main
+    Threads::Threads
+    ${CMAKE_SOURCE_DIR}/lib/libdf.so
+    nlohmann_json::nlohmann_json
+    fmt::fmt
+    ${SNDFILE_LIBRARIES}
+    ${LIBAV_LINK_LIBRARIES}
+)
+
+set_target_properties(MediaProcessorBench PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}"
+    BUILD_RPATH "${CMAKE_SOURCE_DIR}/lib"
+)
+
+# Runs the whole suite and saves the results for comparison
+add_custom_target(bench
+    COMMAND MediaProcessorBench --benchmark_out=${CMAKE_BINARY_DIR}/bench.json
+            --benchmark_out_format=json
+    DEPENDS MediaProcessorBench
+    WORKING_DIRECTORY ${CMAKE_BINARY_DIR}
+    COMMENT "Running MediaProcessorBench, results in ${CMAKE_BINARY_DIR}/bench.json"
+)
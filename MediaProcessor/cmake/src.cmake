@@ -4,10 +4,33 @@ add_executable(MediaProcessor
     ${CMAKE_SOURCE_DIR}/src/main.cpp
     ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp
     ${CMAKE_SOURCE_DIR}/src/AudioProcessor.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp
+    ${CMAKE_SOURCE_DIR}/src/WavFileWriter.cpp
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp
     ${CMAKE_SOURCE_DIR}/src/VideoProcessor.cpp
+    ${CMAKE_SOURCE_DIR}/src/MediaMuxer.cpp
     ${CMAKE_SOURCE_DIR}/src/Engine.cpp
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp
+    ${CMAKE_SOURCE_DIR}/src/ResultCache.cpp
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp
+    ${CMAKE_SOURCE_DIR}/src/JobServer.cpp
+    ${CMAKE_SOURCE_DIR}/src/JobScheduler.cpp
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp
+    ${CMAKE_SOURCE_DIR}/src/WorkerServer.cpp
+    ${CMAKE_SOURCE_DIR}/src/BatchProcessor.cpp
     ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp
     ${CMAKE_SOURCE_DIR}/src/FFmpegSettingsManager.cpp
     ${CMAKE_SOURCE_DIR}/src/DeepFilterCommandBuilder.cpp
@@ -49,6 +72,7 @@ set(LIBRARIES
     ${DF_LIBRARY}
     nlohmann_json::nlohmann_json
     fmt::fmt
+    ${LIBAV_LINK_LIBRARIES}
 )
 
 # macos-specific library fixes 
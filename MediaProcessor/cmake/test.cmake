@@ -23,7 +23,7 @@ FetchContent_Declare(
 FetchContent_MakeAvailable(fmt)
 
 # Common libraries for all test targets
-set(COMMON_LIBRARIES gtest_main ${CMAKE_SOURCE_DIR}/lib/libdf.so ${SNDFILE_LIBRARIES} fmt::fmt)
+set(COMMON_LIBRARIES gtest_main ${CMAKE_SOURCE_DIR}/lib/libdf.so ${SNDFILE_LIBRARIES} fmt::fmt ${LIBAV_LINK_LIBRARIES})
 
 # Macro for adding a test executable
 macro(add_test_executable name)
@@ -40,20 +40,49 @@ add_test_executable(ConfigManagerTester
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
     ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
     ${CMAKE_SOURCE_DIR}/tests/TestUtils.cpp
 )
 
 add_test_executable(UtilsTester 
     ${CMAKE_SOURCE_DIR}/tests/UtilsTester.cpp 
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
 )
 
+add_test_executable(AudioUtilsTester
+    ${CMAKE_SOURCE_DIR}/tests/AudioUtilsTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp 
+)
+
+add_test_executable(ThreadPoolTester
+    ${CMAKE_SOURCE_DIR}/tests/ThreadPoolTester.cpp 
+)
+
 add_test_executable(AudioProcessorTester
     ${CMAKE_SOURCE_DIR}/tests/AudioProcessorTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SignalGenerator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp 
     ${CMAKE_SOURCE_DIR}/src/AudioProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WavFileWriter.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp 
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
     ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
     ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp 
     ${CMAKE_SOURCE_DIR}/tests/TestUtils.cpp
@@ -61,17 +90,175 @@ add_test_executable(AudioProcessorTester
 
 add_test_executable(VideoProcessorTester
     ${CMAKE_SOURCE_DIR}/tests/VideoProcessorTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp 
     ${CMAKE_SOURCE_DIR}/src/VideoProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaMuxer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SignalGenerator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp 
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp 
+    ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/tests/TestUtils.cpp
+)
+
+add_test_executable(CommandRunnerTester
+    ${CMAKE_SOURCE_DIR}/tests/CommandRunnerTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Utils.cpp
+)
+
+add_test_executable(SocketUtilsTester
+    ${CMAKE_SOURCE_DIR}/tests/SocketUtilsTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp
+)
+
+add_test_executable(WorkCoordinatorTester
+    ${CMAKE_SOURCE_DIR}/tests/WorkCoordinatorTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WorkerServer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp 
     ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp 
     ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
     ${CMAKE_SOURCE_DIR}/tests/TestUtils.cpp
 )
 
+add_test_executable(JobSchedulerTester
+    ${CMAKE_SOURCE_DIR}/tests/JobSchedulerTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobScheduler.cpp
+)
+
+add_test_executable(JobServerTester
+    ${CMAKE_SOURCE_DIR}/tests/JobServerTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobServer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Engine.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ResultCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobScheduler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/VideoProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaMuxer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WavFileWriter.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Utils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp
+)
+
+add_test_executable(BatchProcessorTester
+    ${CMAKE_SOURCE_DIR}/tests/BatchProcessorTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/BatchProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Engine.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ResultCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobScheduler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WorkCoordinator.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SocketUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/VideoProcessor.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaMuxer.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DFStatePool.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioDecoder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/WavFileWriter.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp 
+    ${CMAKE_SOURCE_DIR}/src/MediaInfo.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Utils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/HardwareUtils.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ConfigManager.cpp
+)
+
+add_test_executable(ContentHashTester
+    ${CMAKE_SOURCE_DIR}/tests/ContentHashTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp
+)
+
+add_test_executable(DiskCacheTester
+    ${CMAKE_SOURCE_DIR}/tests/DiskCacheTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp
+)
+
+add_test_executable(ChunkStoreTester
+    ${CMAKE_SOURCE_DIR}/tests/ChunkStoreTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ChunkStore.cpp 
+    ${CMAKE_SOURCE_DIR}/src/DiskCache.cpp 
+    ${CMAKE_SOURCE_DIR}/src/ContentHash.cpp
+)
+
+add_test_executable(TracerTester
+    ${CMAKE_SOURCE_DIR}/tests/TracerTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/Tracer.cpp
+)
+
+add_test_executable(JobMetricsTester
+    ${CMAKE_SOURCE_DIR}/tests/JobMetricsTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/JobMetrics.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp
+)
+
+add_test_executable(PerfCountersTester
+    ${CMAKE_SOURCE_DIR}/tests/PerfCountersTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PerfCounters.cpp
+)
+
+add_test_executable(SignalGeneratorTester
+    ${CMAKE_SOURCE_DIR}/tests/SignalGeneratorTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/SignalGenerator.cpp
+)
+
+add_test_executable(AudioBufferTester
+    ${CMAKE_SOURCE_DIR}/tests/AudioBufferTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/AudioBuffer.cpp
+)
+
+add_test_executable(PcmKernelsTester
+    ${CMAKE_SOURCE_DIR}/tests/PcmKernelsTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp
+)
+
+add_test_executable(PolyphaseResamplerTester
+    ${CMAKE_SOURCE_DIR}/tests/PolyphaseResamplerTester.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PolyphaseResampler.cpp 
+    ${CMAKE_SOURCE_DIR}/src/PcmKernels.cpp
+)
+
 add_test_executable(CommandBuilderTester
     ${CMAKE_SOURCE_DIR}/tests/CommandBuilderTester.cpp 
     ${CMAKE_SOURCE_DIR}/src/CommandBuilder.cpp 
     ${CMAKE_SOURCE_DIR}/src/Utils.cpp
+    ${CMAKE_SOURCE_DIR}/src/CommandRunner.cpp
 )
 
@@ -0,0 +1,18 @@
+# CMake configuration for developer tools
+
+# Synthetic test input generator, e.g. for multi-hour soak tests:
+#   ./MediaProcessorSignalGen --duration 36000 --channels 6 ten_hours_5.1.wav
+add_executable(MediaProcessorSignalGen
+    ${CMAKE_SOURCE_DIR}/tools/SignalGen.cpp
+    ${CMAKE_SOURCE_DIR}/src/SignalGenerator.cpp
+)
+
+if(APPLE)
+    target_link_libraries(MediaProcessorSignalGen PRIVATE /opt/homebrew/lib/libsndfile.dylib)
+else()
+    target_link_libraries(MediaProcessorSignalGen PRIVATE ${SNDFILE_LIBRARIES})
+endif()
+
+set_target_properties(MediaProcessorSignalGen PROPERTIES
+    RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}"
+)
@@ -3,86 +3,573 @@
 #ifndef THREAD_POOL_H
 #define THREAD_POOL_H
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+/**
+ * @brief Move-only callable with inline storage for small closures.
+ *
+ * Closures up to `INLINE_SIZE` bytes are stored in place, so queueing them does not allocate.
+ * Larger closures fall back to the heap.
+ */
+class PoolTask {
+   public:
+    static constexpr size_t INLINE_SIZE = 64;
+
+    PoolTask() = default;
+
+    template <class F, class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, PoolTask>>>
+    PoolTask(F&& f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            new (m_storage) Fn(std::forward<F>(f));
+        } else {
+            *reinterpret_cast<Fn**>(m_storage) = new Fn(std::forward<F>(f));
+        }
+        m_ops = opsFor<Fn>();
+    }
+
+    PoolTask(PoolTask&& other) noexcept { moveFrom(other); }
+
+    PoolTask& operator=(PoolTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    PoolTask(const PoolTask&) = delete;
+    PoolTask& operator=(const PoolTask&) = delete;
+
+    ~PoolTask() { reset(); }
+
+    explicit operator bool() const { return m_ops != nullptr; }
+
+    void operator()() { m_ops->invoke(m_storage); }
+
+    void reset() {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+   private:
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*destroy)(void* storage);
+        void (*move)(void* destination, void* source);
+    };
+
+    template <class Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= INLINE_SIZE && alignof(Fn) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <class Fn>
+    static const Ops* opsFor() {
+        if constexpr (fitsInline<Fn>()) {
+            static constexpr Ops ops{
+                [](void* storage) { (*std::launder(static_cast<Fn*>(storage)))(); },
+                [](void* storage) { std::launder(static_cast<Fn*>(storage))->~Fn(); },
+                [](void* destination, void* source) {
+                    Fn* fn = std::launder(static_cast<Fn*>(source));
+                    new (destination) Fn(std::move(*fn));
+                    fn->~Fn();
+                }};
+            return &ops;
+        } else {
+            static constexpr Ops ops{
+                [](void* storage) { (**static_cast<Fn**>(storage))(); },
+                [](void* storage) { delete *static_cast<Fn**>(storage); },
+                [](void* destination, void* source) {
+                    *static_cast<Fn**>(destination) = *static_cast<Fn**>(source);
+                }};
+            return &ops;
+        }
+    }
+
+    void moveFrom(PoolTask& other) {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char m_storage[INLINE_SIZE];
+    const Ops* m_ops = nullptr;
+};
+
+/**
+ * @brief Bounded Chase-Lev deque of tasks owned by a single worker.
+ *
+ * The owner pushes and pops at the bottom, other threads steal from the top. Tasks live in
+ * preallocated slots; a slot is only reused once the thread that claimed it has moved the task
+ * out, which lets claimers move the task after winning the race instead of copying it before.
+ */
+class WorkStealingDeque {
+   public:
+    static constexpr int64_t CAPACITY = 1024;
+
+    WorkStealingDeque() : m_slots(std::make_unique<Slot[]>(CAPACITY)) {}
+
+    /**
+     * @brief Pushes a task at the bottom. Owner only.
+     *
+     * @return false if the deque is full, in which case `task` is left untouched.
+     */
+    bool push(PoolTask& task) {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        Slot& slot = m_slots[bottom & MASK];
+        if (bottom - top >= CAPACITY || slot.occupied.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        slot.task = std::move(task);
+        slot.occupied.store(true, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pops the most recently pushed task. Owner only.
+     */
+    bool pop(PoolTask& task) {
+        // Sequentially consistent operations instead of a standalone fence, which also keeps
+        // the deque visible to ThreadSanitizer
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.exchange(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        if (top == bottom) {
+            // Last task, race the thieves for it
+            bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            if (!won) {
+                return false;
+            }
+        }
+
+        take(bottom, task);
+        return true;
+    }
+
+    /**
+     * @brief Steals the oldest task. Safe to call from any thread.
+     */
+    bool steal(PoolTask& task) {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom || !m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                            std::memory_order_relaxed)) {
+            return false;
+        }
+
+        take(top, task);
+        return true;
+    }
+
+   private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+    struct Slot {
+        PoolTask task;
+        std::atomic<bool> occupied{false};
+    };
+
+    alignas(64) std::atomic<int64_t> m_top{0};
+    alignas(64) std::atomic<int64_t> m_bottom{0};
+    std::unique_ptr<Slot[]> m_slots;
+
+    void take(int64_t index, PoolTask& task) {
+        Slot& slot = m_slots[index & MASK];
+        task = std::move(slot.task);
+        slot.occupied.store(false, std::memory_order_release);
+    }
+};
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue for tasks submitted from outside
+ *        the pool.
+ *
+ * Each cell carries a sequence number that tells producers and consumers whose turn it is, so
+ * tasks are moved in and out of their cell without locking.
+ */
+class InjectionQueue {
+   public:
+    static constexpr size_t CAPACITY = 1024;
+
+    InjectionQueue() : m_cells(std::make_unique<Cell[]>(CAPACITY)) {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @return false if the queue is full, in which case `task` is left untouched.
+     */
+    bool push(PoolTask& task) {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = m_cells[position & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    cell.task = std::move(task);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(PoolTask& task) {
+        size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = m_cells[position & MASK];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (diff == 0) {
+                if (m_dequeuePosition.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    task = std::move(cell.task);
+                    cell.sequence.store(position + CAPACITY, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                position = m_dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+   private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of two");
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        PoolTask task;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(64) std::atomic<size_t> m_dequeuePosition{0};
+};
+
+/**
+ * @brief Work-stealing thread pool.
+ *
+ * Every worker owns a lock-free deque. Tasks submitted from a worker go to its own deque, tasks
+ * submitted from other threads go through a shared lock-free injection queue. Idle workers first
+ * drain their own deque, then the injection queue, then steal from the other workers, and only
+ * sleep once all of them are empty.
+ *
+ * Queued tasks, including those they queue in turn, still run when the pool is destroyed; the
+ * destructor waits for them.
+ */
 class ThreadPool {
    public:
-    ThreadPool(size_t);
-    template <class F, class... Args>
-    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type>;
+    /**
+     * @param workerInit Runs on every worker thread before it takes tasks, e.g. to lower its
+     *        scheduling priority.
+     */
+    explicit ThreadPool(size_t threads, std::function<void()> workerInit = {});
     ~ThreadPool();
 
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues `f(args...)` and returns a future for its result.
+     *
+     * @throws std::runtime_error if the pool is being destroyed.
+     */
+    template <class F, class... Args>
+    auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
+
+    /**
+     * @brief Queues a fire-and-forget task. Does not allocate if the closure fits inline.
+     *
+     * The task must not throw.
+     *
+     * @throws std::runtime_error if the pool is being destroyed.
+     */
+    template <class F>
+    void submit(F&& f);
+
+    /**
+     * @brief Calls `f(i)` for every i in [begin, end) and waits for completion.
+     *
+     * Indices are handed out in blocks of `grainSize` to the pool's workers and the calling
+     * thread. The first exception thrown by `f` cancels the remaining blocks and is rethrown.
+     */
+    template <class F>
+    void parallel_for(size_t begin, size_t end, size_t grainSize, F&& f);
+
+    size_t size() const { return m_workers.size(); }
+
    private:
-    // need to keep track of threads so we can join them
-    std::vector<std::thread> workers;
-    // the task queue
-    std::queue<std::function<void()> > tasks;
-
-    // synchronization
-    std::mutex queue_mutex;
-    std::condition_variable condition;
-    bool stop;
+    struct Worker {
+        WorkStealingDeque deque;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    InjectionQueue m_injectionQueue;
+
+    // Bumped on every push, sleeping workers wait for it to change
+    std::atomic<uint32_t> m_epoch{0};
+    std::atomic<uint32_t> m_sleepers{0};
+    std::atomic<bool> m_stop{false};
+
+    // Identifies the pool and worker the current thread belongs to, if any
+    static inline thread_local ThreadPool* t_pool = nullptr;
+    static inline thread_local size_t t_workerIndex = 0;
+
+    void push(PoolTask task);
+    bool findTask(size_t workerIndex, PoolTask& task);
+    void workerLoop(size_t workerIndex);
+    void notify();
 };
 
-// the constructor just launches some amount of workers
-inline ThreadPool::ThreadPool(size_t threads) : stop(false) {
-    for (size_t i = 0; i < threads; ++i)
-        workers.emplace_back([this] {
-            for (;;) {
-                std::function<void()> task;
-
-                {
-                    std::unique_lock<std::mutex> lock(this->queue_mutex);
-                    this->condition.wait(lock,
-                                         [this] { return this->stop || !this->tasks.empty(); });
-                    if (this->stop && this->tasks.empty()) return;
-                    task = std::move(this->tasks.front());
-                    this->tasks.pop();
-                }
+inline ThreadPool::ThreadPool(size_t threads, std::function<void()> workerInit) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
 
-                task();
+    // Start only once every deque exists, workers steal from each other right away
+    for (size_t i = 0; i < threads; ++i) {
+        m_workers[i]->thread = std::thread([this, i, workerInit] {
+            if (workerInit) {
+                workerInit();
             }
+            workerLoop(i);
         });
+    }
+}
+
+inline ThreadPool::~ThreadPool() {
+    m_stop.store(true, std::memory_order_seq_cst);
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    m_epoch.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker->thread.join();
+    }
 }
 
-// add new work item to the pool
 template <class F, class... Args>
-auto ThreadPool::enqueue(F&& f,
-                         Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type> {
-    using return_type = typename std::invoke_result<F, Args...>::type;
+auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+    using return_type = std::invoke_result_t<F, Args...>;
 
-    auto task = std::make_shared<std::packaged_task<return_type()> >(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    // packaged_task is move-only, it is stored in the task directly
+    std::packaged_task<return_type()> task(
+        [f = std::forward<F>(f), ... args = std::forward<Args>(args)]() mutable -> return_type {
+            return std::invoke(std::move(f), std::move(args)...);
+        });
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex);
+    std::future<return_type> res = task.get_future();
+    push(PoolTask(std::move(task)));
+    return res;
+}
 
-        // don't allow enqueueing after stopping the pool
-        if (stop) throw std::runtime_error("enqueue on stopped ThreadPool");
+template <class F>
+void ThreadPool::submit(F&& f) {
+    push(PoolTask(std::forward<F>(f)));
+}
 
-        tasks.emplace([task]() { (*task)(); });
+template <class F>
+void ThreadPool::parallel_for(size_t begin, size_t end, size_t grainSize, F&& f) {
+    if (begin >= end) {
+        return;
+    }
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    // Shared by the caller and its helpers, lives on the caller's stack until all helpers ran
+    struct RangeJob {
+        std::atomic<size_t> next;
+        size_t end;
+        size_t grainSize;
+        std::remove_reference_t<F>* fn;
+
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t pendingHelpers;
+        std::exception_ptr error;
+
+        void runBlocks() {
+            while (true) {
+                size_t first = next.fetch_add(grainSize, std::memory_order_relaxed);
+                if (first >= end) {
+                    return;
+                }
+
+                size_t last = std::min(first + grainSize, end);
+                try {
+                    for (size_t i = first; i < last; ++i) {
+                        (*fn)(i);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    next.store(end, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    const size_t numBlocks = (end - begin + grainSize - 1) / grainSize;
+    const size_t numHelpers = std::min(numBlocks - 1, size());
+
+    RangeJob job{{begin}, end, grainSize, &f, {}, {}, numHelpers, {}};
+
+    for (size_t i = 0; i < numHelpers; ++i) {
+        push(PoolTask([&job] {
+            job.runBlocks();
+
+            // Notify under the lock, the caller may destroy the job as soon as it is released
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (--job.pendingHelpers == 0) {
+                job.done.notify_all();
+            }
+        }));
+    }
+
+    job.runBlocks();
+
+    // A worker caller runs queued tasks meanwhile, its helpers may be sitting in its own deque
+    if (t_pool == this) {
+        PoolTask task;
+        while (findTask(t_workerIndex, task)) {
+            task();
+            task.reset();
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(job.mutex);
+    job.done.wait(lock, [&job] { return job.pendingHelpers == 0; });
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
     }
-    condition.notify_one();
-    return res;
 }
 
-// the destructor joins all threads
-inline ThreadPool::~ThreadPool() {
-    {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        stop = true;
+inline void ThreadPool::push(PoolTask task) {
+    // Workers may still queue follow-up tasks while the pool drains on destruction
+    if (t_pool != this && m_stop.load(std::memory_order_acquire)) {
+        throw std::runtime_error("enqueue on stopped ThreadPool");
+    }
+
+    if (t_pool == this) {
+        // Run inline rather than block a worker on its own full deque
+        if (!m_workers[t_workerIndex]->deque.push(task)) {
+            task();
+            return;
+        }
+    } else {
+        while (!m_injectionQueue.push(task)) {
+            std::this_thread::yield();
+        }
+    }
+
+    notify();
+}
+
+inline void ThreadPool::notify() {
+    m_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_seq_cst) > 0) {
+        m_epoch.notify_one();
+    }
+}
+
+inline bool ThreadPool::findTask(size_t workerIndex, PoolTask& task) {
+    return m_workers[workerIndex]->deque.pop(task) || m_injectionQueue.pop(task) ||
+           [&] {
+               for (size_t i = 1; i < m_workers.size(); ++i) {
+                   if (m_workers[(workerIndex + i) % m_workers.size()]->deque.steal(task)) {
+                       return true;
+                   }
+               }
+               return false;
+           }();
+}
+
+inline void ThreadPool::workerLoop(size_t workerIndex) {
+    t_pool = this;
+    t_workerIndex = workerIndex;
+
+    constexpr int SPIN_ATTEMPTS = 64;
+    PoolTask task;
+
+    while (true) {
+        bool found = false;
+        for (int attempt = 0; attempt < SPIN_ATTEMPTS && !found; ++attempt) {
+            found = findTask(workerIndex, task);
+            if (!found) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (!found) {
+            // Announce the intent to sleep, then check once more so a concurrent push is not
+            // missed: it either shows up here or changes the epoch we are about to wait on
+            uint32_t epoch = m_epoch.load(std::memory_order_seq_cst);
+            m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+            found = findTask(workerIndex, task);
+            if (!found) {
+                if (m_stop.load(std::memory_order_seq_cst)) {
+                    m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+                    return;
+                }
+                m_epoch.wait(epoch, std::memory_order_seq_cst);
+            }
+            m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+
+        if (found) {
+            task();
+            task.reset();
+        }
     }
-    condition.notify_all();
-    for (std::thread& worker : workers) worker.join();
 }
 
 #endif
@@ -90,6 +577,8 @@ inline ThreadPool::~ThreadPool() {
 /*
     Copyright (c) 2012 Jakob Progsch, Václav Zeman
     Updated for C++17 and later compatibility by Omer Yusuf Yagci, 2024.
+    Rewritten around per-worker work-stealing deques, a lock-free injection queue and
+    small-buffer tasks, 2026. This is an altered version of the original software.
 
     This software is provided 'as-is', without any express or implied
     warranty. In no event will the authors be held liable for any damages
@@ -109,4 +598,4 @@ inline ThreadPool::~ThreadPool() {
 
     3. This notice may not be removed or altered from any source
     distribution.
-*/
\ No newline at end of file
+*/
@@ -0,0 +1,217 @@
+#include "AudioBuffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace MediaProcessor {
+
+namespace {
+
+constexpr size_t MIN_CLASS_SIZE = 4096;
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+constexpr size_t ALIGNMENT_FRAMES = AUDIO_BUFFER_ALIGNMENT / sizeof(float);
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#ifdef __linux__
+/**
+ * @return Memory aligned to a huge page, or nullptr if it could not be mapped.
+ */
+void* mapHugePages(size_t bytes) {
+    // Over-map by a huge page and trim, mmap() only guarantees page alignment
+    const size_t mappedBytes = bytes + HUGE_PAGE_SIZE;
+    void* mapping =
+        mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto* start = static_cast<char*>(mapping);
+    auto* aligned = reinterpret_cast<char*>(
+        roundUp(reinterpret_cast<uintptr_t>(start), static_cast<uintptr_t>(HUGE_PAGE_SIZE)));
+    if (aligned > start) {
+        munmap(start, aligned - start);
+    }
+    if (char* end = aligned + bytes; end < start + mappedBytes) {
+        munmap(end, start + mappedBytes - end);
+    }
+
+    madvise(aligned, bytes, MADV_HUGEPAGE);  // only advice, fails without THP support
+    return aligned;
+}
+#endif
+
+}  // namespace
+
+AudioBufferPool& AudioBufferPool::getInstance() {
+    static AudioBufferPool instance;
+    return instance;
+}
+
+AudioBufferPool::~AudioBufferPool() {
+    clear();
+}
+
+AudioBufferPool::Block AudioBufferPool::acquire(size_t bytes) {
+    const size_t classSize = getClassSize(bytes);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_idleBlocks.find(classSize);
+        if (it != m_idleBlocks.end() && !it->second.empty()) {
+            Block block = it->second.back();
+            it->second.pop_back();
+            m_idleBytes -= block.bytes;
+            return block;
+        }
+        ++m_allocationCount;
+    }
+
+    // Allocated outside the lock, large fresh blocks take a while to map
+    return allocate(classSize);
+}
+
+void AudioBufferPool::release(Block block) {
+    if (!block.memory) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_idleBytes + block.bytes <= m_maxIdleBytes) {
+            m_idleBlocks[block.bytes].push_back(block);
+            m_idleBytes += block.bytes;
+            return;
+        }
+    }
+    free(block);
+}
+
+void AudioBufferPool::setMaxIdleBytes(size_t maxIdleBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxIdleBytes = maxIdleBytes;
+}
+
+void AudioBufferPool::setHugePages(bool hugePages) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_hugePages = hugePages;
+}
+
+void AudioBufferPool::clear() {
+    std::unordered_map<size_t, std::vector<Block>> idleBlocks;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        idleBlocks.swap(m_idleBlocks);
+        m_idleBytes = 0;
+    }
+
+    for (const auto& [classSize, blocks] : idleBlocks) {
+        for (const Block& block : blocks) {
+            free(block);
+        }
+    }
+}
+
+size_t AudioBufferPool::getIdleBytes() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_idleBytes;
+}
+
+size_t AudioBufferPool::getAllocationCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_allocationCount;
+}
+
+size_t AudioBufferPool::getClassSize(size_t bytes) {
+    if (bytes <= MIN_CLASS_SIZE) {
+        return MIN_CLASS_SIZE;
+    }
+    return roundUp(bytes, std::bit_floor(bytes) / 4);
+}
+
+AudioBufferPool::Block AudioBufferPool::allocate(size_t bytes) {
+    bool hugePages;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        hugePages = m_hugePages;
+    }
+
+#ifdef __linux__
+    if (hugePages && bytes >= HUGE_PAGE_SIZE) {
+        if (void* memory = mapHugePages(bytes)) {
+            return {memory, bytes, true};
+        }
+    }
+#endif
+
+    return {::operator new(bytes, std::align_val_t(AUDIO_BUFFER_ALIGNMENT)), bytes, false};
+}
+
+void AudioBufferPool::free(const Block& block) {
+#ifdef __linux__
+    if (block.mapped) {
+        munmap(block.memory, block.bytes);
+        return;
+    }
+#endif
+    ::operator delete(block.memory, std::align_val_t(AUDIO_BUFFER_ALIGNMENT));
+}
+
+AudioBuffer::AudioBuffer(size_t frames, size_t channels, size_t capacity)
+    : m_frames(frames),
+      m_channels(channels),
+      m_stride(roundUp(std::max(frames, capacity), ALIGNMENT_FRAMES)) {
+    if (m_stride * m_channels > 0) {
+        m_block = AudioBufferPool::getInstance().acquire(m_stride * m_channels * sizeof(float));
+    }
+}
+
+AudioBuffer::AudioBuffer(AudioBuffer&& other) noexcept
+    : m_block(std::exchange(other.m_block, {})),
+      m_frames(std::exchange(other.m_frames, 0)),
+      m_channels(std::exchange(other.m_channels, 0)),
+      m_stride(std::exchange(other.m_stride, 0)) {}
+
+AudioBuffer& AudioBuffer::operator=(AudioBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_block = std::exchange(other.m_block, {});
+        m_frames = std::exchange(other.m_frames, 0);
+        m_channels = std::exchange(other.m_channels, 0);
+        m_stride = std::exchange(other.m_stride, 0);
+    }
+    return *this;
+}
+
+AudioBuffer::~AudioBuffer() {
+    release();
+}
+
+void AudioBuffer::resize(size_t frames) {
+    if (frames <= m_stride) {
+        m_frames = frames;
+        return;
+    }
+
+    // Grow by half again, so that repeated appends reallocate rarely
+    AudioBuffer grown(frames, std::max<size_t>(m_channels, 1), frames + frames / 2);
+    for (size_t channel = 0; channel < m_channels && m_frames > 0; ++channel) {
+        std::memcpy(grown.getChannel(channel).data(), getChannel(channel).data(),
+                    m_frames * sizeof(float));
+    }
+    *this = std::move(grown);
+}
+
+void AudioBuffer::release() {
+    AudioBufferPool::getInstance().release(std::exchange(m_block, {}));
+}
+
+}  // namespace MediaProcessor
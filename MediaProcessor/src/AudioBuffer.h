@@ -0,0 +1,156 @@
+#ifndef AUDIOBUFFER_H
+#define AUDIOBUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace MediaProcessor {
+
+/**
+ * @brief Alignment of every buffer and channel, one cache line and a full AVX-512 register.
+ */
+constexpr size_t AUDIO_BUFFER_ALIGNMENT = 64;
+
+/**
+ * @brief Process-wide arena of sample memory shared across work units and jobs.
+ *
+ * Released blocks are kept on a free list per size class and handed out again, so the
+ * multi-megabyte unit buffers of a pipeline are allocated and faulted in once instead of once
+ * per unit, and a resident daemon reaches a steady state where jobs allocate nothing. Size
+ * classes are four per power of two, so a block is at most 25% larger than requested. Idle
+ * blocks beyond `maxIdleBytes` are returned to the system.
+ *
+ * With huge pages enabled, blocks of 2MB and more are mapped separately and advised as
+ * transparent huge pages, which cuts page faults and TLB misses on large units. Kernels without
+ * transparent huge pages ignore the advice.
+ */
+class AudioBufferPool {
+   public:
+    struct Block {
+        void* memory = nullptr;
+        size_t bytes = 0;
+        bool mapped = false;  // mmap()ed for huge pages rather than allocated with new
+    };
+
+    /**
+     * @brief Retrieves the process-wide pool.
+     */
+    static AudioBufferPool& getInstance();
+
+    ~AudioBufferPool();
+
+    /**
+     * @brief Hands out an idle block of at least `bytes`, allocating one if none is idle.
+     *
+     * @throws std::bad_alloc if memory is exhausted.
+     */
+    Block acquire(size_t bytes);
+
+    /**
+     * @brief Returns a block from `acquire()` to its free list, or to the system if the pool is
+     * full.
+     */
+    void release(Block block);
+
+    void setMaxIdleBytes(size_t maxIdleBytes);
+    void setHugePages(bool hugePages);
+
+    /**
+     * @brief Returns all idle blocks to the system.
+     */
+    void clear();
+
+    size_t getIdleBytes();
+
+    /**
+     * @brief Number of blocks allocated from the system, as opposed to reused from the pool.
+     */
+    size_t getAllocationCount();
+
+    /**
+     * @brief Size class of a request of `bytes`, the size of the block it is served with.
+     */
+    static size_t getClassSize(size_t bytes);
+
+   private:
+    AudioBufferPool() = default;
+
+    Block allocate(size_t bytes);
+    static void free(const Block& block);
+
+    std::mutex m_mutex;
+    std::unordered_map<size_t, std::vector<Block>> m_idleBlocks;  // by class size
+    size_t m_idleBytes = 0;
+    size_t m_maxIdleBytes = 1024 * 1024 * 1024;
+    size_t m_allocationCount = 0;
+    bool m_hugePages = false;
+};
+
+/**
+ * @brief Planar float samples in pooled memory, each channel 64-byte aligned.
+ *
+ * Move-only; the memory returns to the `AudioBufferPool` when the buffer is destroyed.
+ */
+class AudioBuffer {
+   public:
+    AudioBuffer() = default;
+
+    /**
+     * @brief Uninitialized buffer of `frames` samples per channel.
+     *
+     * @param capacity Frames per channel to reserve for growing without reallocation.
+     */
+    explicit AudioBuffer(size_t frames, size_t channels = 1, size_t capacity = 0);
+
+    AudioBuffer(AudioBuffer&& other) noexcept;
+    AudioBuffer& operator=(AudioBuffer&& other) noexcept;
+    ~AudioBuffer();
+
+    AudioBuffer(const AudioBuffer&) = delete;
+    AudioBuffer& operator=(const AudioBuffer&) = delete;
+
+    size_t getFrames() const {
+        return m_frames;
+    }
+
+    size_t getChannels() const {
+        return m_channels;
+    }
+
+    /**
+     * @brief Frames per channel that fit without reallocation.
+     */
+    size_t getCapacity() const {
+        return m_stride;
+    }
+
+    std::span<float> getChannel(size_t channel = 0) {
+        return {static_cast<float*>(m_block.memory) + channel * m_stride, m_frames};
+    }
+
+    std::span<const float> getChannel(size_t channel = 0) const {
+        return {static_cast<const float*>(m_block.memory) + channel * m_stride, m_frames};
+    }
+
+    /**
+     * @brief Changes the number of frames, keeping the existing samples. New samples are
+     * uninitialized.
+     */
+    void resize(size_t frames);
+
+   private:
+    AudioBufferPool::Block m_block;
+    size_t m_frames = 0;
+    size_t m_channels = 0;
+    size_t m_stride = 0;  // frames from one channel to the next, a multiple of the alignment
+
+    void release();
+};
+
+}  // namespace MediaProcessor
+
+#endif  // AUDIOBUFFER_H
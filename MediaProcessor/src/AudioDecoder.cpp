@@ -0,0 +1,319 @@
+#include "AudioDecoder.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/error.h>
+#include <libswresample/swresample.h>
+}
+
+namespace MediaProcessor {
+
+namespace {
+
+std::string avErrorToString(int errorCode) {
+    char buffer[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(errorCode, buffer, sizeof(buffer));
+    return buffer;
+}
+
+/**
+ * @brief Copies `layout`, falling back to the default order if a demuxer left it unspecified.
+ */
+void copyChannelLayout(AVChannelLayout* destination, const AVChannelLayout& layout) {
+    if (layout.order == AV_CHANNEL_ORDER_UNSPEC) {
+        av_channel_layout_default(destination, layout.nb_channels);
+    } else {
+        av_channel_layout_copy(destination, &layout);
+    }
+}
+
+}  // namespace
+
+AudioDecoder::AudioDecoder(int outputSampleRate, ChannelMode channelMode)
+    : m_outputSampleRate(outputSampleRate), m_channelMode(channelMode) {}
+
+AudioDecoder::~AudioDecoder() {
+    close();
+}
+
+void AudioDecoder::open(const fs::path& mediaPath, int streamIndex) {
+    close();
+
+    int ret = avformat_open_input(&m_formatContext, mediaPath.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not open " + mediaPath.string() + ": " +
+                                 avErrorToString(ret));
+    }
+
+    ret = avformat_find_stream_info(m_formatContext, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not read stream info: " + avErrorToString(ret));
+    }
+
+    const AVCodec* decoder = nullptr;
+    m_streamIndex =
+        av_find_best_stream(m_formatContext, AVMEDIA_TYPE_AUDIO, streamIndex, -1, &decoder, 0);
+    if (m_streamIndex < 0 || !decoder) {
+        throw std::runtime_error("No decodable audio stream found in " + mediaPath.string());
+    }
+
+    m_codecContext = avcodec_alloc_context3(decoder);
+    if (!m_codecContext) {
+        throw std::runtime_error("Could not allocate audio decoder context.");
+    }
+
+    AVStream* stream = m_formatContext->streams[m_streamIndex];
+    ret = avcodec_parameters_to_context(m_codecContext, stream->codecpar);
+    if (ret < 0) {
+        throw std::runtime_error("Could not copy codec parameters: " + avErrorToString(ret));
+    }
+
+    ret = avcodec_open2(m_codecContext, decoder, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not open audio decoder: " + avErrorToString(ret));
+    }
+
+    m_sourceSampleRate = m_codecContext->sample_rate;
+
+    if (m_channelMode != ChannelMode::Mono) {
+        if (m_codecContext->ch_layout.nb_channels <= 0) {
+            throw std::runtime_error("Unknown channel layout in " + mediaPath.string());
+        }
+
+        AVChannelLayout layout;
+        copyChannelLayout(&layout, m_codecContext->ch_layout);
+        m_channels = layout.nb_channels;
+        m_dialogueChannel = av_channel_layout_index_from_channel(&layout, AV_CHAN_FRONT_CENTER);
+        m_dialogueChannel = std::max(m_dialogueChannel, -1);
+        av_channel_layout_uninit(&layout);
+    }
+
+    m_packet = av_packet_alloc();
+    m_frame = av_frame_alloc();
+    if (!m_packet || !m_frame) {
+        throw std::runtime_error("Could not allocate decoding buffers.");
+    }
+}
+
+size_t AudioDecoder::read(std::span<float* const> output, size_t maxFrames) {
+    if (output.size() != static_cast<size_t>(m_channels)) {
+        throw std::runtime_error("Expected " + std::to_string(m_channels) +
+                                 " channel buffers, got " + std::to_string(output.size()) + ".");
+    }
+
+    size_t framesWritten = 0;
+
+    while (framesWritten < maxFrames) {
+        if (m_pendingOffset < m_pendingFrames) {
+            size_t count = std::min(maxFrames - framesWritten, m_pendingFrames - m_pendingOffset);
+            for (size_t channel = 0; channel < output.size(); ++channel) {
+                std::copy_n(m_pendingSamples.data() + channel * m_pendingStride + m_pendingOffset,
+                            count, output[channel] + framesWritten);
+            }
+            m_pendingOffset += count;
+            framesWritten += count;
+            continue;
+        }
+
+        if (!decodeNextFrame()) {
+            break;
+        }
+    }
+
+    return framesWritten;
+}
+
+size_t AudioDecoder::read(float* output, size_t maxSamples) {
+    return read(std::span<float* const>(&output, 1), maxSamples);
+}
+
+int AudioDecoder::getSampleRate() const {
+    return m_outputSampleRate;
+}
+
+int AudioDecoder::getSourceSampleRate() const {
+    return m_sourceSampleRate;
+}
+
+int AudioDecoder::getChannels() const {
+    return m_channels;
+}
+
+int AudioDecoder::getDialogueChannel() const {
+    return m_dialogueChannel;
+}
+
+bool AudioDecoder::decodeNextFrame() {
+    if (!m_codecContext) {
+        throw std::runtime_error("AudioDecoder used before a media file was opened.");
+    }
+
+    m_pendingFrames = 0;
+    m_pendingOffset = 0;
+
+    while (!m_endOfStream) {
+        int ret = avcodec_receive_frame(m_codecContext, m_frame);
+        if (ret == 0) {
+            convertFrame(m_frame);
+            av_frame_unref(m_frame);
+            if (m_pendingFrames > 0) {
+                return true;
+            }
+            continue;  // resampler buffered the whole frame
+        }
+
+        if (ret == AVERROR_EOF) {
+            // Flush whatever the resampler still holds
+            if (m_swrContext) {
+                convertFrame(nullptr);
+            }
+            m_endOfStream = true;
+            return m_pendingFrames > 0;
+        }
+
+        if (ret != AVERROR(EAGAIN)) {
+            throw std::runtime_error("Failed to decode audio frame: " + avErrorToString(ret));
+        }
+
+        // The decoder needs more input
+        if (m_draining) {
+            continue;
+        }
+
+        ret = av_read_frame(m_formatContext, m_packet);
+        if (ret < 0) {
+            // End of input, enter draining mode
+            avcodec_send_packet(m_codecContext, nullptr);
+            m_draining = true;
+            continue;
+        }
+
+        if (m_packet->stream_index == m_streamIndex) {
+            ret = avcodec_send_packet(m_codecContext, m_packet);
+            if (ret < 0 && ret != AVERROR_INVALIDDATA) {
+                av_packet_unref(m_packet);
+                throw std::runtime_error("Failed to send packet to decoder: " +
+                                         avErrorToString(ret));
+            }
+        }
+        av_packet_unref(m_packet);
+    }
+
+    return false;
+}
+
+void AudioDecoder::convertFrame(const AVFrame* frame) {
+    if (frame && !m_swrContext) {
+        initResampler(frame);
+    }
+
+    // Converted straight into one plane per channel, the pipeline filters channels separately.
+    // Without native resampling these already are the pending samples
+    std::vector<float>& converted = m_resamplers.empty() ? m_pendingSamples : m_convertedSamples;
+    const int inputSamples = frame ? frame->nb_samples : 0;
+    const int maxOutputSamples = swr_get_out_samples(m_swrContext, inputSamples);
+    const size_t convertedStride = static_cast<size_t>(std::max(maxOutputSamples, 0));
+    size_t convertedFrames = 0;
+
+    if (maxOutputSamples > 0) {
+        converted.resize(convertedStride * m_channels);
+        std::vector<uint8_t*> outputPlanes(m_channels);
+        for (int channel = 0; channel < m_channels; ++channel) {
+            outputPlanes[channel] =
+                reinterpret_cast<uint8_t*>(converted.data() + channel * convertedStride);
+        }
+        const uint8_t** inputPlanes =
+            frame ? const_cast<const uint8_t**>(frame->extended_data) : nullptr;
+
+        int ret = swr_convert(m_swrContext, outputPlanes.data(), maxOutputSamples, inputPlanes,
+                              inputSamples);
+        if (ret < 0) {
+            throw std::runtime_error("Failed to convert audio samples: " + avErrorToString(ret));
+        }
+        convertedFrames = static_cast<size_t>(ret);
+    }
+
+    if (m_resamplers.empty()) {
+        m_pendingStride = convertedStride;
+        m_pendingFrames = convertedFrames;
+        return;
+    }
+
+    // Every channel's resampler is in the same state, they produce the same number of frames
+    m_pendingStride = m_resamplers.front().getMaxOutputFrames(convertedFrames);
+    m_pendingSamples.resize(m_pendingStride * m_channels);
+    for (int channel = 0; channel < m_channels; ++channel) {
+        PolyphaseResampler& resampler = m_resamplers[channel];
+        float* output = m_pendingSamples.data() + channel * m_pendingStride;
+        size_t frames = resampler.process(
+            {m_convertedSamples.data() + channel * convertedStride, convertedFrames}, output);
+        if (!frame) {
+            frames += resampler.flush(output + frames);
+        }
+        m_pendingFrames = frames;
+    }
+}
+
+void AudioDecoder::initResampler(const AVFrame* frame) {
+    // Some demuxers leave the layout unspecified, fall back to the default for the channel count
+    AVChannelLayout inputLayout;
+    copyChannelLayout(&inputLayout, frame->ch_layout);
+
+    // Other than for mono the layout is kept, libswresample only converts rate and format
+    AVChannelLayout outputLayout = AV_CHANNEL_LAYOUT_MONO;
+    if (m_channelMode != ChannelMode::Mono) {
+        if (inputLayout.nb_channels != m_channels) {
+            av_channel_layout_uninit(&inputLayout);
+            throw std::runtime_error("Channel count changed mid-stream.");
+        }
+        av_channel_layout_copy(&outputLayout, &inputLayout);
+    }
+
+    int outputSampleRate = m_outputSampleRate;
+    if (frame->sample_rate != m_outputSampleRate &&
+        PolyphaseResampler::supports(frame->sample_rate, m_outputSampleRate)) {
+        outputSampleRate = frame->sample_rate;
+        m_resamplers.assign(m_channels,
+                            PolyphaseResampler(frame->sample_rate, m_outputSampleRate));
+    }
+
+    int ret = swr_alloc_set_opts2(&m_swrContext, &outputLayout, AV_SAMPLE_FMT_FLTP,
+                                  outputSampleRate, &inputLayout,
+                                  static_cast<AVSampleFormat>(frame->format), frame->sample_rate,
+                                  0, nullptr);
+    av_channel_layout_uninit(&inputLayout);
+    av_channel_layout_uninit(&outputLayout);
+
+    if (ret < 0 || swr_init(m_swrContext) < 0) {
+        throw std::runtime_error("Could not initialize audio resampler.");
+    }
+}
+
+void AudioDecoder::close() {
+    swr_free(&m_swrContext);
+    av_frame_free(&m_frame);
+    av_packet_free(&m_packet);
+    avcodec_free_context(&m_codecContext);
+    avformat_close_input(&m_formatContext);
+
+    m_streamIndex = -1;
+    m_channels = 1;
+    m_dialogueChannel = -1;
+    m_draining = false;
+    m_endOfStream = false;
+    m_pendingSamples.clear();
+    m_pendingStride = 0;
+    m_pendingFrames = 0;
+    m_pendingOffset = 0;
+    m_resamplers.clear();
+    m_convertedSamples.clear();
+    m_sourceSampleRate = 0;
+}
+
+}  // namespace MediaProcessor
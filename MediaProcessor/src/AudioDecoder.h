@@ -0,0 +1,138 @@
+#ifndef AUDIODECODER_H
+#define AUDIODECODER_H
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "ChannelMode.h"
+#include "PolyphaseResampler.h"
+
+extern "C" {
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+struct SwrContext;
+}
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Sample rate DeepFilterNet operates at, and the default decoding rate.
+ */
+constexpr int DEFAULT_DECODE_SAMPLE_RATE = 48000;
+
+/**
+ * @brief Decodes the audio stream of a media file in-process into planar float PCM.
+ *
+ * Built on libavformat/libavcodec/libswresample. The decoded stream is resampled to the requested
+ * output rate and, in `ChannelMode::Mono`, downmixed to mono, matching what
+ * `ffmpeg -ac 1 -ar <rate>` produced. Otherwise the source channels and their order are kept.
+ * libswresample only converts the sample format and layout at the source rate, the rate is then
+ * converted by one `PolyphaseResampler` per channel; ratios it does not support fall back to
+ * libswresample.
+ * Samples are pulled in blocks with `read()`.
+ */
+class AudioDecoder {
+   public:
+    explicit AudioDecoder(int outputSampleRate = DEFAULT_DECODE_SAMPLE_RATE,
+                          ChannelMode channelMode = ChannelMode::Mono);
+    ~AudioDecoder();
+
+    AudioDecoder(const AudioDecoder&) = delete;
+    AudioDecoder& operator=(const AudioDecoder&) = delete;
+
+    /**
+     * @brief Opens the media file and prepares an audio stream for decoding.
+     *
+     * @param streamIndex Index of the audio stream to decode, or -1 to pick the best one.
+     *
+     * @throws std::runtime_error if the file cannot be opened or has no decodable audio stream.
+     */
+    void open(const fs::path& mediaPath, int streamIndex = -1);
+
+    /**
+     * @brief Decodes up to `maxFrames` frames into one buffer per channel.
+     *
+     * @param output `getChannels()` buffers of at least `maxFrames` samples.
+     *
+     * @return The number of frames written, 0 once the end of the stream is reached.
+     *
+     * @throws std::runtime_error if decoding fails or the number of buffers is wrong.
+     */
+    size_t read(std::span<float* const> output, size_t maxFrames);
+
+    /**
+     * @brief Decodes up to `maxSamples` samples of a single channel into `output`.
+     *
+     * @throws std::runtime_error if decoding fails or the decoder has several channels.
+     */
+    size_t read(float* output, size_t maxSamples);
+
+    int getSampleRate() const;
+
+    /**
+     * @brief Sample rate of the audio stream before resampling, known once a file is opened.
+     */
+    int getSourceSampleRate() const;
+
+    /**
+     * @brief Number of channels decoded, known once a file is opened.
+     */
+    int getChannels() const;
+
+    /**
+     * @brief Decoded channel carrying the dialogue, or -1 if the layout has no front center.
+     */
+    int getDialogueChannel() const;
+
+   private:
+    AVFormatContext* m_formatContext = nullptr;
+    AVCodecContext* m_codecContext = nullptr;
+    SwrContext* m_swrContext = nullptr;
+    AVPacket* m_packet = nullptr;
+    AVFrame* m_frame = nullptr;
+
+    int m_streamIndex = -1;
+    int m_outputSampleRate;
+    int m_sourceSampleRate = 0;
+    ChannelMode m_channelMode;
+    int m_channels = 1;
+    int m_dialogueChannel = -1;
+    bool m_draining = false;
+    bool m_endOfStream = false;
+
+    // Converted frames of the last decoded frame not yet handed out by `read()`, one plane of
+    // `m_pendingStride` samples per channel
+    std::vector<float> m_pendingSamples;
+    size_t m_pendingStride = 0;
+    size_t m_pendingFrames = 0;
+    size_t m_pendingOffset = 0;
+
+    // One per channel while the rate is converted natively, m_convertedSamples then holds the
+    // output of libswresample at the source rate
+    std::vector<PolyphaseResampler> m_resamplers;
+    std::vector<float> m_convertedSamples;
+
+    /**
+     * @brief Decodes and converts the next frame into m_pendingSamples.
+     *
+     * @return false once the decoder and resampler are fully drained.
+     */
+    bool decodeNextFrame();
+
+    /**
+     * @brief Converts a decoded frame to planar float; a null frame flushes the resampler.
+     */
+    void convertFrame(const AVFrame* frame);
+
+    void initResampler(const AVFrame* frame);
+    void close();
+};
+
+}  // namespace MediaProcessor
+
+#endif  // AUDIODECODER_H
@@ -1,326 +1,566 @@
 #include "AudioProcessor.h"
 
-#include <sndfile.h>
-
-#include <future>
-#include <iomanip>
+#include <algorithm>
+#include <condition_variable>
 #include <iostream>
-#include <sstream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
 
+#include "AudioBuffer.h"
+#include "AudioDecoder.h"
+#include "AudioUtils.h"
+#include "ChunkStore.h"
 #include "CommandBuilder.h"
+#include "DFStatePool.h"
+#include "PolyphaseResampler.h"
 #include "ThreadPool.h"
+#include "Tracer.h"
 #include "Utils.h"
+#include "WavFileWriter.h"
+#include "WorkCoordinator.h"
 
 namespace fs = std::filesystem;
 
 namespace MediaProcessor {
 
 AudioProcessor::AudioProcessor(const fs::path& inputVideoPath, const fs::path& outputAudioPath)
-    : m_inputVideoPath(inputVideoPath),
+    : AudioProcessor(MediaInfo::probe(inputVideoPath), outputAudioPath) {}
+
+AudioProcessor::AudioProcessor(const MediaInfo& mediaInfo, const fs::path& outputAudioPath)
+    : m_mediaInfo(mediaInfo),
+      m_inputVideoPath(mediaInfo.path),
       m_outputAudioPath(outputAudioPath),
       m_overlapDuration(DEFAULT_OVERLAP_DURATION),
       m_configManager(ConfigManager::getInstance()) {
     m_outputPath = m_outputAudioPath.parent_path();
-    m_chunksPath = m_outputPath / "chunks";
     m_processedChunksPath = m_outputPath / "processed_chunks";
 
-    m_numChunks = m_configManager.getOptimalThreadCount();
-    std::cout << "INFO: using " << m_numChunks << " threads." << std::endl;
+    m_numThreads = m_configManager.getOptimalThreadCount();
+    std::cout << "INFO: using " << m_numThreads << " threads." << std::endl;
 
     m_filterAttenuationLimit = m_configManager.getFilterAttenuationLimit();
     std::cout << "INFO: using " << m_filterAttenuationLimit << " as filter attenaution limit."
               << std::endl;
 }
 
+namespace {
+
+size_t toFrameAlignedSamples(double duration) {
+    size_t samples = static_cast<size_t>(duration * DEFAULT_DECODE_SAMPLE_RATE);
+    return std::max(samples / DEFAULT_DF_FRAME_LENGTH, size_t{1}) * DEFAULT_DF_FRAME_LENGTH;
+}
+
+std::vector<float*> getChannelPointers(AudioBuffer& buffer) {
+    std::vector<float*> channels(buffer.getChannels());
+    for (size_t channel = 0; channel < channels.size(); ++channel) {
+        channels[channel] = buffer.getChannel(channel).data();
+    }
+    return channels;
+}
+
+}  // namespace
+
+/**
+ * @brief State shared by the decode, filter and merge stages of one pipeline run.
+ *
+ * Units are appended by the decode thread, filtered by the pool's workers and consumed in order
+ * by the merger. Each channel of a unit is filtered by a task of its own, with its own
+ * DeepFilterNet state, straight from and into the unit's planar buffers. Everything but the
+ * sample buffers is guarded by `mutex`; a unit's buffers belong to whichever stage currently
+ * holds it, and each filter task writes only its channel. Buffers come from the
+ * `AudioBufferPool`, so the memory of merged units is decoded into again instead of being
+ * reallocated.
+ */
+struct AudioProcessor::PipelineState {
+    struct Unit {
+        AudioBuffer samples;         // decoded input, replaced by the filtered output
+        AudioBuffer processed;       // filtered output, written channel by channel
+        size_t pendingChannels = 0;  // channels still being filtered
+        bool filtered = false;
+    };
+
+    size_t unitSamples;
+    size_t overlapSamples;
+    size_t maxUnitsInFlight;
+
+    size_t channels;
+    std::vector<size_t> filteredChannels;  // channels run through the model, the others are muted
+    int outputSampleRate = DEFAULT_DECODE_SAMPLE_RATE;
+
+    fs::path modelPath;
+    float postFilterBeta;
+    ThreadPool* pool;
+    ChunkStore* chunkStore;  // nullptr if chunk reuse is disabled
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::unique_ptr<Unit>> units;  // released once merged
+    size_t mergedUnits = 0;
+    size_t pendingTasks = 0;  // filter tasks submitted but not finished
+    size_t reusedUnits = 0;   // units taken from the chunk store instead of being filtered
+    bool decodingDone = false;
+    bool failed = false;
+};
+
 bool AudioProcessor::isolateVocals() {
+    return runPipeline(getWorkUnitSamples(), 0);
+}
+
+bool AudioProcessor::isolateVocalsStreaming() {
+    return runPipeline(toFrameAlignedSamples(DEFAULT_STREAMING_CHUNK_DURATION),
+                       STREAMING_UNITS_IN_FLIGHT_PER_THREAD * getFilterConcurrency());
+}
+
+void AudioProcessor::setThreadPool(ThreadPool* threadPool) {
+    m_threadPool = threadPool;
+}
+
+void AudioProcessor::setConcurrencyLimit(std::function<size_t()> concurrencyLimit) {
+    m_concurrencyLimit = std::move(concurrencyLimit);
+}
+
+void AudioProcessor::setWorkCoordinator(WorkCoordinator* workCoordinator) {
+    m_workCoordinator = workCoordinator;
+}
+
+void AudioProcessor::setJobMetrics(JobMetrics* jobMetrics) {
+    m_jobMetrics = jobMetrics;
+}
+
+void AudioProcessor::setAudioSinkFactory(AudioSinkFactory audioSinkFactory) {
+    m_audioSinkFactory = std::move(audioSinkFactory);
+}
+
+bool AudioProcessor::runPipeline(size_t unitSamples, size_t maxUnitsInFlight) {
     /*
      * Extracts vocals from a video by chunking, parallel processing, and merging the audio.
+     * Unit k+1 is decoded while unit k is filtered, and units are merged as soon as they and
+     * their predecessors are filtered.
      */
 
     // Ensure output directory exists and remove output file if it exists
     Utils::ensureDirectoryExists(m_outputPath);
-    Utils::removeFileIfExists(m_outputAudioPath);
-
     std::cout << "Input video path: " << m_inputVideoPath << std::endl;
-    std::cout << "Output audio path: " << m_outputAudioPath << std::endl;
-
-    if (!extractAudio()) {
-        return false;
+    if (!m_audioSinkFactory) {
+        Utils::removeFileIfExists(m_outputAudioPath);
+        std::cout << "Output audio path: " << m_outputAudioPath << std::endl;
     }
 
-    m_totalDuration = Utils::getMediaDuration(m_outputAudioPath);
-    if (m_totalDuration <= 0) {
-        std::cerr << "Error: Invalid audio duration." << std::endl;
+    if (!m_mediaInfo.hasAudio()) {
+        std::cerr << "Error: No audio stream found in " << m_inputVideoPath << std::endl;
         return false;
     }
 
-    if (!splitAudioIntoChunks()) {
-        return false;
-    }
+    PipelineState state;
+    state.unitSamples = std::max(unitSamples, getOverlapSamples());
+    state.overlapSamples = getOverlapSamples();
+    state.maxUnitsInFlight = maxUnitsInFlight;
+    state.modelPath = m_configManager.getDeepFilterTarballPath();
 
-    if (!filterChunks()) {
+    ChannelMode channelMode;
+    bool restoreSourceSampleRate;
+    try {
+        m_filterAttenuationLimit = m_configManager.getFilterAttenuationLimit();
+        state.postFilterBeta = m_configManager.getFilterPostFilterBeta();
+        channelMode = m_configManager.getAudioChannelMode();
+        restoreSourceSampleRate = m_configManager.getRestoreSourceSampleRate();
+    } catch (std::runtime_error& ex) {
+        std::cout << "Error while getting filter settings: " << ex.what() << std::endl;
         return false;
     }
 
-    if (!mergeChunks()) {
+    // Decode in-process, resampled to 48kHz for DeepFilterNet
+    AudioDecoder decoder(DEFAULT_DECODE_SAMPLE_RATE, channelMode);
+    try {
+        decoder.open(m_inputVideoPath, m_mediaInfo.audioStreamIndex);
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Error: Failed to decode audio: " << ex.what() << std::endl;
         return false;
     }
 
-    // Intermediary files
-    fs::remove_all(m_chunksPath);
-    fs::remove_all(m_processedChunksPath);
-
-    return true;
-}
-
-bool AudioProcessor::extractAudio() {
-    fs::path ffmpegPath = m_configManager.getFFmpegPath();
-
-    // Extract the audio with FFmpeg
-    CommandBuilder cmd;
-    cmd.addArgument(ffmpegPath.string());
-    cmd.addFlag("-y");
-    cmd.addFlag("-i", m_inputVideoPath.string());
-    cmd.addFlag("-ar", "48000");
-    cmd.addFlag("-ac", "1");
-    cmd.addFlag("-c:a", "pcm_s16le");
-    cmd.addArgument(m_outputAudioPath.string());
-
-    if (!Utils::runCommand(cmd.build())) {
-        std::cerr << "Error: Failed to extract and convert audio using FFmpeg." << std::endl;
-        return false;
+    // Dialogue mode mutes all but the center channel, layouts without one are filtered whole
+    state.channels = static_cast<size_t>(decoder.getChannels());
+    const int dialogueChannel = decoder.getDialogueChannel();
+    for (size_t channel = 0; channel < state.channels; ++channel) {
+        if (channelMode != ChannelMode::Dialogue || dialogueChannel < 0 ||
+            channel == static_cast<size_t>(dialogueChannel)) {
+            state.filteredChannels.push_back(channel);
+        }
+    }
+    if (state.channels > 1) {
+        std::cout << "INFO: processing " << state.channels << " channels, "
+                  << state.filteredChannels.size() << " of them filtered." << std::endl;
     }
 
-    std::cout << "Audio extracted successfully to: " << m_outputAudioPath << std::endl;
-    return true;
-}
-
-bool AudioProcessor::splitAudioIntoChunks() {
-    fs::path ffmpegPath = m_configManager.getFFmpegPath();
-
-    Utils::ensureDirectoryExists(m_chunksPath);
-
-    std::vector<double> chunkStartTimes;
-    std::vector<double> chunkDurations;
-    populateChunkDurations(chunkStartTimes, chunkDurations);
+    // Filtered at 48kHz, then optionally written back at the source rate
+    const int sourceSampleRate = decoder.getSourceSampleRate();
+    if (restoreSourceSampleRate && sourceSampleRate != DEFAULT_DECODE_SAMPLE_RATE &&
+        PolyphaseResampler::supports(DEFAULT_DECODE_SAMPLE_RATE, sourceSampleRate)) {
+        state.outputSampleRate = sourceSampleRate;
+        std::cout << "INFO: resampling " << sourceSampleRate << " Hz audio to "
+                  << DEFAULT_DECODE_SAMPLE_RATE << " Hz and back." << std::endl;
+    }
 
-    for (int i = 0; i < m_numChunks; ++i) {
-        if (!generateChunkFile(i, chunkStartTimes[i], chunkDurations[i], ffmpegPath)) {
-            std::cerr << "Error: Failed to split audio into chunks." << std::endl;
-            return false;
+    AudioBufferPool& bufferPool = AudioBufferPool::getInstance();
+    bufferPool.setMaxIdleBytes(m_configManager.getAudioBufferPoolMaxSize());
+    bufferPool.setHugePages(m_configManager.getAudioBufferHugePages());
+
+    std::optional<ChunkStore> chunkStore;
+    if (const fs::path chunkStorePath = m_configManager.getChunkStorePath();
+        !chunkStorePath.empty()) {
+        try {
+            chunkStore.emplace(chunkStorePath, m_configManager.getChunkStoreMaxSize(),
+                               state.modelPath, m_filterAttenuationLimit, state.postFilterBeta);
+
+            // Units filtered here need fresh states, one per thread is loaded ahead of time
+            if (!m_workCoordinator) {
+                DFStatePool::getInstance().reserveFresh(state.modelPath, getFilterConcurrency(),
+                                                        m_filterAttenuationLimit,
+                                                        state.postFilterBeta);
+            }
+        } catch (const std::runtime_error& ex) {
+            std::cerr << "Warning: chunk store disabled: " << ex.what() << std::endl;
         }
     }
-    return true;
-}
-
-bool AudioProcessor::generateChunkFile(int index, const double startTime, const double duration,
-                                       const fs::path& ffmpegPath) {
-    fs::path chunkPath = m_chunksPath / ("chunk_" + std::to_string(index) + ".wav");
-
-    // Set higher precision for chunk boundaries
-    std::ostringstream ssStartTime, ssDuration;
-    ssStartTime << std::fixed << std::setprecision(6) << startTime;
-    ssDuration << std::fixed << std::setprecision(6) << duration;
+    state.chunkStore = chunkStore ? &*chunkStore : nullptr;
 
-    CommandBuilder cmd;
-    cmd.addArgument(ffmpegPath.string());
-    cmd.addFlag("-y");
-    cmd.addFlag("-ss", ssStartTime.str());
-    cmd.addFlag("-t", ssDuration.str());
-    cmd.addFlag("-i", m_outputAudioPath.string());
-    cmd.addFlag("-ar", "48000");
-    cmd.addFlag("-ac", "1");
-    cmd.addFlag("-c:a", "pcm_s16le");
-    cmd.addArgument(chunkPath.string());
-
-    if (!Utils::runCommand(cmd.build())) {
-        return false;
+    // Remote units only block a local thread while they are in flight, give each its own
+    std::optional<ThreadPool> privatePool;
+    state.pool = m_workCoordinator ? nullptr : m_threadPool;
+    if (!state.pool) {
+        state.pool = &privatePool.emplace(getFilterConcurrency());
     }
 
-    m_chunkColPath.push_back(chunkPath);
-    return true;
-}
-
-bool AudioProcessor::invokeDeepFilter(fs::path chunkPath) {
-    const fs::path deepFilterPath = m_configManager.getDeepFilterPath();
-    const fs::path deepFilterTarballPath = m_configManager.getDeepFilterTarballPath();
-
-    // TODO: implement with DeepFilterCommandBuilder once base class is updated (#51)
-    // `--compensate-delay` ensures the audio remains in sync after filtering
-    CommandBuilder cmd;
-    cmd.addArgument(deepFilterPath.string());
-    cmd.addFlag("--compensate-delay");
-    cmd.addFlag("--output-dir", m_processedChunksPath.string());
-    cmd.addArgument(chunkPath.string());
+    std::thread decodeThread([&]() { decodeUnits(state, decoder); });
 
-    if (!Utils::runCommand(cmd.build())) {
-        std::cerr << "Error: Failed to process chunk with DeepFilterNet: " << chunkPath
-                  << std::endl;
-        return false;
+    // Anything thrown must still fail the run and join the decode thread
+    bool success = false;
+    try {
+        success = mergeUnits(state);
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: Failed to write merged audio: " << ex.what() << std::endl;
     }
 
-    return true;
-}
-
-bool AudioProcessor::invokeDeepFilterFFI(fs::path chunkPath, DFState* df_state,
-                                         std::vector<float>& inputBuffer,
-                                         std::vector<float>& outputBuffer) {
-    SF_INFO sfInfoIn;
-    SNDFILE* inputFile = sf_open(chunkPath.c_str(), SFM_READ, &sfInfoIn);
-    if (!inputFile) {
-        std::cerr << "Error: Could not open input WAV file: " << chunkPath << std::endl;
-        return false;
+    if (!success) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.failed = true;
     }
+    state.changed.notify_all();
+    decodeThread.join();
 
-    // Prepare output file
-    fs::path processedChunkPath = m_processedChunksPath / chunkPath.filename();
-    SNDFILE* outputFile = sf_open(processedChunkPath.c_str(), SFM_WRITE, &sfInfoIn);
-    if (!outputFile) {
-        std::cerr << "Error: Could not open output WAV file: " << processedChunkPath << std::endl;
-        sf_close(inputFile);
-        return false;
-    }
+    // Filter tasks still queued after a failure reference the state, wait until they are done
+    std::unique_lock<std::mutex> lock(state.mutex);
+    state.changed.wait(lock, [&state]() { return state.pendingTasks == 0; });
 
-    // Process frames
-    sf_count_t numFrames;
-    while ((numFrames = sf_readf_float(inputFile, inputBuffer.data(), inputBuffer.size())) > 0) {
-        df_process_frame(df_state, inputBuffer.data(), outputBuffer.data());
-        sf_writef_float(outputFile, outputBuffer.data(), numFrames);
+    if (success && state.reusedUnits > 0) {
+        std::cout << "INFO: reused " << state.reusedUnits << " chunks from the chunk store."
+                  << std::endl;
     }
-
-    sf_close(inputFile);
-    sf_close(outputFile);
-
-    return true;
+    return success;
 }
 
-bool AudioProcessor::filterChunks() {
-    Utils::ensureDirectoryExists(m_processedChunksPath);
+void AudioProcessor::decodeUnits(PipelineState& state, AudioDecoder& decoder) {
+    auto submit = [&state, this](std::unique_ptr<PipelineState::Unit> unit) {
+        // Muted channels are never filtered, their output stays silent
+        unit->processed = AudioBuffer(unit->samples.getFrames(), state.channels);
+        for (size_t channel = 0; channel < state.channels; ++channel) {
+            if (std::find(state.filteredChannels.begin(), state.filteredChannels.end(),
+                          channel) == state.filteredChannels.end()) {
+                std::ranges::fill(unit->processed.getChannel(channel), 0.0f);
+            }
+        }
 
-    const auto deepFilterTarballPath = m_configManager.getDeepFilterTarballPath();
+        size_t unitIndex;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.failed) {
+                return;
+            }
+            unit->pendingChannels = state.filteredChannels.size();
+            state.units.push_back(std::move(unit));
+            unitIndex = state.units.size() - 1;
+        }
+
+        for (size_t channel : state.filteredChannels) {
+            {
+                // Hold the task back while the run uses up its share of the pool
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.changed.wait(lock, [&state, this]() {
+                    return state.failed || !m_concurrencyLimit || m_workCoordinator ||
+                           state.pendingTasks < std::max<size_t>(m_concurrencyLimit(), 1);
+                });
+                if (state.failed) {
+                    return;
+                }
+                ++state.pendingTasks;
+            }
+            state.pool->submit(
+                [this, &state, unitIndex, channel]() { filterUnit(state, unitIndex, channel); });
+        }
+    };
 
     try {
-        m_filterAttenuationLimit = m_configManager.getFilterAttenuationLimit();
-    } catch (std::runtime_error& ex) {
-        std::cout << "Error while getting filter_attenuation_limit: " << ex.what() << std::endl;
-        return false;
-    }
+        // The latest unit is held back until it is known whether it is the last one
+        std::unique_ptr<PipelineState::Unit> pending;
+        size_t decodedSamples = 0;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.changed.wait(lock, [&state]() {
+                    return state.failed || state.maxUnitsInFlight == 0 ||
+                           state.units.size() - state.mergedUnits < state.maxUnitsInFlight;
+                });
+                if (state.failed) {
+                    return;
+                }
+            }
 
-    ThreadPool pool(m_numChunks);
-    std::vector<std::future<bool>> results;
+            // Room for the overlap appended once the next unit is decoded
+            AudioBuffer samples(state.unitSamples, state.channels,
+                                state.unitSamples + state.overlapSamples);
+            {
+                TRACE_SCOPE("extract");
+                JobMetrics::ScopedTimer timer(m_jobMetrics, JobMetrics::Stage::Decode);
+                samples.resize(decoder.read(getChannelPointers(samples), samples.getFrames()));
+            }
+            decodedSamples += samples.getFrames();
+            const bool endOfStream = samples.getFrames() < state.unitSamples;
+
+            TRACE_SCOPE("split");
+            if (pending) {
+                // The pending unit runs `overlapSamples` into this one, or absorbs the remainder
+                // at the end of the stream so the last unit is never shorter than the overlap
+                size_t tail = endOfStream ? samples.getFrames() : state.overlapSamples;
+                size_t pendingSamples = pending->samples.getFrames();
+                pending->samples.resize(pendingSamples + tail);
+                for (size_t channel = 0; channel < state.channels; ++channel) {
+                    std::copy_n(samples.getChannel(channel).begin(), tail,
+                                pending->samples.getChannel(channel).begin() + pendingSamples);
+                }
+                submit(std::move(pending));
+            } else if (endOfStream && samples.getFrames() > 0) {
+                // Input shorter than a single unit
+                submit(std::make_unique<PipelineState::Unit>(std::move(samples)));
+            }
 
-    for (int i = 0; i < m_numChunks; ++i) {
-        results.emplace_back(pool.enqueue([&, i]() {
-            // Per-thread DFState instance
-            DFState* df_state =
-                df_create(deepFilterTarballPath.c_str(), m_filterAttenuationLimit, nullptr);
-            if (!df_state) {
-                std::cerr << "Error: Failed to insantiate DFState in thread." << std::endl;
-                return false;
+            if (endOfStream) {
+                break;
             }
+            pending = std::make_unique<PipelineState::Unit>(std::move(samples));
+        }
 
-            size_t frameLength = df_get_frame_length(df_state);
-            std::vector<float> inputBuffer(frameLength);
-            std::vector<float> outputBuffer(frameLength);
+        if (m_jobMetrics) {
+            m_jobMetrics->setAudioDuration(static_cast<double>(decodedSamples) /
+                                           DEFAULT_DECODE_SAMPLE_RATE);
+        }
 
-            bool success =
-                invokeDeepFilterFFI(m_chunkColPath[i], df_state, inputBuffer, outputBuffer);
-            df_free(df_state);
-            return success;
-        }));
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.decodingDone = true;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: Failed to decode audio: " << ex.what() << std::endl;
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.failed = true;
     }
+    state.changed.notify_all();
+}
 
-    // Wait for all threads to complete
-    bool allSuccess = true;
-    for (auto& result : results) {
-        allSuccess &= result.get();
+void AudioProcessor::filterUnit(PipelineState& state, size_t unitIndex, size_t channel) {
+    PipelineState::Unit* unit;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.failed) {
+            --state.pendingTasks;
+            state.changed.notify_all();
+            return;
+        }
+        unit = state.units[unitIndex].get();
     }
 
-    if (!allSuccess) {
-        std::cerr << "Error: One or more chunks failed to process." << std::endl;
-        return false;
-    }
+    bool success = false;
+    bool reused = false;
+    const std::span<const float> samples = unit->samples.getChannel(channel);
+    const std::span<float> processedSamples = unit->processed.getChannel(channel);
+    try {
+        TRACE_SCOPE("filter unit", "unit", static_cast<int64_t>(unitIndex));
+        JobMetrics::ScopedTimer timer(m_jobMetrics, JobMetrics::Stage::Filter);
+
+        // Units filtered before, possibly by another job, are taken from the chunk store
+        std::string fingerprint;
+        if (state.chunkStore) {
+            TRACE_SCOPE("chunk store lookup");
+            fingerprint = state.chunkStore->fingerprint(samples);
+            reused = state.chunkStore->load(fingerprint, processedSamples);
+        }
 
-    // Update processed chunk paths
-    for (const auto& chunkPath : m_chunkColPath) {
-        fs::path processedChunkPath = m_processedChunksPath / chunkPath.filename();
-        m_processedChunkColPath.push_back(processedChunkPath);
+        if (!reused && m_workCoordinator) {
+            std::vector<float> remoteSamples = m_workCoordinator->filter(
+                samples, m_filterAttenuationLimit, state.postFilterBeta);
+            if (remoteSamples.size() != processedSamples.size()) {
+                throw std::runtime_error("Worker returned " + std::to_string(remoteSamples.size()) +
+                                         " samples for a unit of " +
+                                         std::to_string(samples.size()) + ".");
+            }
+            std::copy(remoteSamples.begin(), remoteSamples.end(), processedSamples.begin());
+        } else if (!reused) {
+            // Warm DFState borrowed from the shared pool, returned when the lease goes away.
+            // Units for the chunk store get a fresh state from the reserve, a pooled one still
+            // carries recurrent history from the units it filtered before
+            DFStatePool& statePool = DFStatePool::getInstance();
+            DFStatePool::Lease lease =
+                state.chunkStore
+                    ? statePool.acquireFresh(state.modelPath, m_filterAttenuationLimit,
+                                             state.postFilterBeta)
+                    : statePool.acquire(state.modelPath, m_filterAttenuationLimit,
+                                        state.postFilterBeta);
+            lease.process(samples, processedSamples);
+        }
+
+        // Remote workers filter on pooled states, only units filtered here are stored
+        if (state.chunkStore && !reused && !m_workCoordinator) {
+            state.chunkStore->save(fingerprint, processedSamples);
+        }
+        success = true;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
     }
 
-    return true;
+    // Notify under the lock, the state may be destroyed as soon as the last task releases it
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (success) {
+        // The last channel to finish hands the unit to the merger
+        if (--unit->pendingChannels == 0) {
+            unit->samples = std::move(unit->processed);
+            unit->filtered = true;
+        }
+        state.reusedUnits += reused;
+    } else {
+        std::cerr << "Error: Failed to process chunk " << unitIndex << "." << std::endl;
+        state.failed = true;
+    }
+    --state.pendingTasks;
+    state.changed.notify_all();
 }
 
-void AudioProcessor::populateChunkDurations(std::vector<double>& startTimes,
-                                            std::vector<double>& durations) const {
-    double chunkDuration = m_totalDuration / m_numChunks;
-    for (int i = 0; i < m_numChunks; ++i) {
-        double startTime = i * chunkDuration;
-        double duration = chunkDuration + m_overlapDuration;
+bool AudioProcessor::mergeUnits(PipelineState& state) {
+    const int channelCount = static_cast<int>(state.channels);
+    std::unique_ptr<IAudioSink> sink =
+        m_audioSinkFactory
+            ? m_audioSinkFactory(state.outputSampleRate, channelCount)
+            : std::make_unique<WavFileWriter>(m_outputAudioPath, state.outputSampleRate,
+                                              channelCount);
+
+    // Merged audio is converted back to the source rate block by block, as it is written
+    std::vector<PolyphaseResampler> resamplers;
+    if (state.outputSampleRate != DEFAULT_DECODE_SAMPLE_RATE) {
+        resamplers.assign(state.channels,
+                          PolyphaseResampler(DEFAULT_DECODE_SAMPLE_RATE, state.outputSampleRate));
+    }
+    std::vector<std::vector<float>> resampled(state.channels);
+    std::vector<const float*> resampledChannels(state.channels);
+
+    // Processed tail of the previous unit per channel, crossfaded with the head of the next one
+    std::vector<std::vector<float>> pendingTails(state.channels);
+    std::vector<float> crossfaded;
+    std::vector<const float*> channels(state.channels);
+    size_t unitIndex = 0;
+
+    auto write = [&](size_t numFrames, bool endOfStream) {
+        if (resamplers.empty()) {
+            sink->writePlanar(channels, numFrames);
+            return;
+        }
 
-        // Handle duration for the last chunk
-        if (startTime + duration > m_totalDuration) {
-            duration = m_totalDuration - startTime;
+        size_t resampledFrames = 0;
+        for (size_t channel = 0; channel < state.channels; ++channel) {
+            PolyphaseResampler& resampler = resamplers[channel];
+            std::vector<float>& output = resampled[channel];
+            output.resize(resampler.getMaxOutputFrames(numFrames));
+            resampledFrames = resampler.process({channels[channel], numFrames}, output.data());
+            if (endOfStream) {
+                resampledFrames += resampler.flush(output.data() + resampledFrames);
+            }
+            resampledChannels[channel] = output.data();
         }
+        sink->writePlanar(resampledChannels, resampledFrames);
+    };
+
+    for (;; ++unitIndex) {
+        std::unique_ptr<PipelineState::Unit> unit;
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.changed.wait(lock, [&]() {
+                return state.failed ||
+                       (unitIndex < state.units.size() && state.units[unitIndex]->filtered) ||
+                       (state.decodingDone && unitIndex == state.units.size());
+            });
+            if (state.failed) {
+                return false;
+            }
+            if (unitIndex == state.units.size()) {
+                break;
+            }
 
-        startTimes.push_back(startTime);
-        durations.push_back(duration);
+            unit = std::move(state.units[unitIndex]);
+            ++state.mergedUnits;
+        }
+        state.changed.notify_all();
+
+        TRACE_SCOPE("merge unit", "unit", static_cast<int64_t>(unitIndex));
+        JobMetrics::ScopedTimer timer(m_jobMetrics, JobMetrics::Stage::Merge);
+        // Hold back the tail, it is either crossfaded with the next unit or written at the end
+        const size_t frames = unit->samples.getFrames();
+        const size_t finishedSamples = frames - std::min(state.overlapSamples, frames);
+
+        for (size_t channel = 0; channel < state.channels; ++channel) {
+            std::span<float> samples = unit->samples.getChannel(channel);
+            std::vector<float>& pendingTail = pendingTails[channel];
+            if (!pendingTail.empty()) {
+                crossfaded.resize(std::min(pendingTail.size(), samples.size()));
+                AudioUtils::crossfade(pendingTail.data(), samples.data(), crossfaded.data(),
+                                      crossfaded.size());
+                std::copy(crossfaded.begin(), crossfaded.end(), samples.begin());
+            }
+            channels[channel] = samples.data();
+            pendingTail.assign(samples.begin() + finishedSamples, samples.end());
+        }
+        write(finishedSamples, false);
     }
-}
 
-std::string AudioProcessor::buildFilterComplex() const {
-    // Build filter complex, i.e. a set of instructions for FFmpeg (called filter graph)
-    std::string filterComplex = "";
-    int filterIndex = 0;
-
-    if (m_processedChunkColPath.size() < 2) {
-        return filterComplex;  // Return empty string if not enough chunks
+    if (unitIndex == 0) {
+        std::cerr << "Error: Invalid audio duration." << std::endl;
+        return false;
     }
 
-    // TODO: extract this into an `applyCrossFade()` method.
-    for (int i = 0; i < static_cast<int>(m_processedChunkColPath.size()) - 1; ++i) {
-        if (i == 0) {
-            // Generate a `crossfade` for the first chunk pair (0 and 1)
-            filterComplex += "[" + std::to_string(i) + ":a][" + std::to_string(i + 1) +
-                             ":a]acrossfade=d=" + std::to_string(m_overlapDuration) +
-                             ":c1=tri:c2=tri[a" + std::to_string(filterIndex) + "]; ";
-        } else {
-            // For the rest, use the result of the previous crossfade (a<filterIndex-1>)
-            // and apply a new crossfade with the next chunk (chunk i+1)
-            filterComplex += "[a" + std::to_string(filterIndex - 1) + "][" + std::to_string(i + 1) +
-                             ":a]acrossfade=d=" + std::to_string(m_overlapDuration) +
-                             ":c1=tri:c2=tri[a" + std::to_string(filterIndex) + "]; ";
+    {
+        JobMetrics::ScopedTimer timer(m_jobMetrics, JobMetrics::Stage::Merge);
+        for (size_t channel = 0; channel < state.channels; ++channel) {
+            channels[channel] = pendingTails[channel].data();
         }
-        filterIndex++;
+        write(pendingTails.front().size(), true);
+        sink->close();
     }
 
-    // Merge the output of the last crossfade into a final output audio stream
-    filterComplex += "[a" + std::to_string(filterIndex - 1) + "]amerge=inputs=1[outa]";
-    return filterComplex;
+    std::cout << "Merged " << unitIndex << " processed chunks." << std::endl;
+    return true;
 }
 
-bool AudioProcessor::mergeChunks() {
-    fs::path ffmpegPath = m_configManager.getFFmpegPath();
+bool AudioProcessor::invokeDeepFilter(fs::path chunkPath) {
+    const fs::path deepFilterPath = m_configManager.getDeepFilterPath();
+    const fs::path deepFilterTarballPath = m_configManager.getDeepFilterTarballPath();
 
-    // Merge processed chunks with `crossfade`
+    // TODO: implement with DeepFilterCommandBuilder once base class is updated (#51)
+    // `--compensate-delay` ensures the audio remains in sync after filtering
     CommandBuilder cmd;
-    cmd.addArgument(ffmpegPath.string());
-    cmd.addFlag("-y");
-    for (const auto& chunkPath : m_processedChunkColPath) {
-        cmd.addFlag("-i", chunkPath.string());
-    }
-
-    if (static_cast<int>(m_processedChunkColPath.size()) >= 2) {
-        cmd.addFlag("-filter_complex", buildFilterComplex());
-        cmd.addFlag("-map", "[outa]");
-    }
-
-    cmd.addFlag("-c:a", "pcm_s16le");
-    cmd.addFlag("-ar", "48000");
-    cmd.addArgument(m_outputAudioPath.string());
+    cmd.addArgument(deepFilterPath.string());
+    cmd.addFlag("--compensate-delay");
+    cmd.addFlag("--output-dir", m_processedChunksPath.string());
+    cmd.addArgument(chunkPath.string());
 
-    if (!Utils::runCommand(cmd.build())) {
-        std::cerr << "Error: Failed to merge back processed audio chunks with crossfading."
+    if (!Utils::runCommand(cmd)) {
+        std::cerr << "Error: Failed to process chunk with DeepFilterNet: " << chunkPath
                   << std::endl;
         return false;
     }
@@ -328,4 +568,20 @@ bool AudioProcessor::mergeChunks() {
     return true;
 }
 
+size_t AudioProcessor::getOverlapSamples() const {
+    return static_cast<size_t>(m_overlapDuration * DEFAULT_DECODE_SAMPLE_RATE);
+}
+
+size_t AudioProcessor::getWorkUnitSamples() const {
+    // Sized from the probed duration, the decoded length is only known once decoding ends
+    double duration = m_mediaInfo.duration /
+                       (std::max<size_t>(getFilterConcurrency(), 1) * WORK_UNITS_PER_THREAD);
+    duration = std::clamp(duration, MIN_WORK_UNIT_DURATION, MAX_WORK_UNIT_DURATION);
+    return toFrameAlignedSamples(duration);
+}
+
+size_t AudioProcessor::getFilterConcurrency() const {
+    return m_workCoordinator ? m_workCoordinator->getCapacity() : m_numThreads;
+}
+
 }  // namespace MediaProcessor
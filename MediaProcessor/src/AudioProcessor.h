@@ -2,70 +2,168 @@
 #define AUDIOPROCESSOR_H
 
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "ConfigManager.h"
 #include "DeepFilterNetFFI.h"
+#include "IAudioSink.h"
+#include "JobMetrics.h"
+#include "MediaInfo.h"
+
+class ThreadPool;
 
 namespace fs = std::filesystem;
 
 namespace MediaProcessor {
+
+class AudioDecoder;
+class WorkCoordinator;
+
 constexpr double DEFAULT_OVERLAP_DURATION = 0.5;
 
+// Work units are sized for about `WORK_UNITS_PER_THREAD` units per worker, within these bounds
+constexpr double MIN_WORK_UNIT_DURATION = 5.0;
+constexpr double MAX_WORK_UNIT_DURATION = 30.0;
+constexpr size_t WORK_UNITS_PER_THREAD = 4;
+
+// Streaming mode uses fixed units and bounds the number of units held in memory
+constexpr double DEFAULT_STREAMING_CHUNK_DURATION = 10.0;
+constexpr size_t STREAMING_UNITS_IN_FLIGHT_PER_THREAD = 2;
+
+// DeepFilterNet3 hop size at 48kHz, work units are aligned to it
+constexpr size_t DEFAULT_DF_FRAME_LENGTH = 480;
+
 /**
  * @brief Handles audio processing tasks, such as extracting, chunking,
  *        filtering, and merging audio.
  */
 class AudioProcessor {
    public:
+    /**
+     * @brief Creates the destination of the processed audio for its sample rate and channels.
+     */
+    using AudioSinkFactory =
+        std::function<std::unique_ptr<IAudioSink>(int sampleRate, int channels)>;
+
     /**
      * @brief Initializes the AudioProcessor with input and output paths.
+     *
+     * @throws std::runtime_error if the input cannot be probed.
      */
     AudioProcessor(const fs::path& inputVideoPath, const fs::path& outputAudioPath);
 
+    /**
+     * @brief Initializes the AudioProcessor with an already probed input.
+     */
+    AudioProcessor(const MediaInfo& mediaInfo, const fs::path& outputAudioPath);
+
     /**
      * @brief Isolates vocals from the input video by processing the audio.
      *
-     * The process includes extracting audio, chunking it, filtering each chunk,
-     * and merging the processed chunks back together.
+     * Decoding, filtering and merging run as a pipeline: work units are filtered as soon as
+     * they are decoded, and merged into the output as soon as their predecessors are. The
+     * channels kept by the `audio_channel_mode` option are filtered as independent streams, at
+     * 48kHz; `restore_source_sample_rate` writes the result back at the source rate.
      *
      * @return true if the operation completes successfully, false otherwise.
      */
     bool isolateVocals();
 
+    /**
+     * @brief Isolates vocals like `isolateVocals()`, but bounds the audio held in memory.
+     *
+     * Units have a fixed duration and decoding pauses while `STREAMING_UNITS_IN_FLIGHT_PER_THREAD`
+     * units per thread are waiting to be filtered or merged. Memory stays constant regardless of
+     * the input duration.
+     *
+     * @return true if the operation completes successfully, false otherwise.
+     */
+    bool isolateVocalsStreaming();
+
+    /**
+     * @brief Runs filtering on a shared pool instead of a pool private to each run.
+     *
+     * The pool must outlive every run; nullptr restores the default.
+     */
+    void setThreadPool(ThreadPool* threadPool);
+
+    /**
+     * @brief Bounds the number of work units filtered at once, re-evaluated for every unit.
+     *
+     * Lets a scheduler share the pool's cores between concurrent runs. An empty function lifts
+     * the limit.
+     */
+    void setConcurrencyLimit(std::function<size_t()> concurrencyLimit);
+
+    /**
+     * @brief Filters work units on remote workers instead of in-process.
+     *
+     * Units are sized and kept in flight for the workers' total capacity, decoding and merging
+     * stay local. The coordinator must outlive every run; nullptr restores local filtering.
+     */
+    void setWorkCoordinator(WorkCoordinator* workCoordinator);
+
+    /**
+     * @brief Records the time spent decoding, filtering and merging, and the decoded duration.
+     *
+     * The metrics must outlive every run; nullptr stops recording.
+     */
+    void setJobMetrics(JobMetrics* jobMetrics);
+
+    /**
+     * @brief Writes the processed audio to the sinks created by `audioSinkFactory` instead of
+     *        the output WAV file.
+     *
+     * Lets the audio be encoded or muxed as it is merged. An empty function restores the default.
+     */
+    void setAudioSinkFactory(AudioSinkFactory audioSinkFactory);
+
    private:
+    struct PipelineState;
+
+    MediaInfo m_mediaInfo;
     fs::path m_inputVideoPath;
     fs::path m_outputAudioPath;
     fs::path m_outputPath;
-    fs::path m_chunksPath;
     fs::path m_processedChunksPath;
-    std::vector<fs::path> m_chunkColPath;
-    std::vector<fs::path> m_processedChunkColPath;
 
-    int m_numChunks;
+    int m_numThreads;
 
-    double m_totalDuration;
     double m_overlapDuration;
     float m_filterAttenuationLimit;
 
     ConfigManager& m_configManager;
+    ThreadPool* m_threadPool = nullptr;
+    std::function<size_t()> m_concurrencyLimit;
+    WorkCoordinator* m_workCoordinator = nullptr;
+    JobMetrics* m_jobMetrics = nullptr;
+    AudioSinkFactory m_audioSinkFactory;
 
-    bool extractAudio();
-    bool splitAudioIntoChunks();
-    bool generateChunkFile(int index, const double startTime, const double duration,
-                           const fs::path& ffmpegPath);
-    bool filterChunks();
-    bool mergeChunks();
-    bool invokeDeepFilter(fs::path chunkPath);
+    /**
+     * @brief Runs the decode, filter and merge stages concurrently.
+     *
+     * @param unitSamples Length of a work unit, excluding its trailing overlap.
+     * @param maxUnitsInFlight Units decoded but not yet merged before decoding pauses, 0 for no
+     *        limit.
+     */
+    bool runPipeline(size_t unitSamples, size_t maxUnitsInFlight);
+
+    void decodeUnits(PipelineState& state, AudioDecoder& decoder);
+    void filterUnit(PipelineState& state, size_t unitIndex, size_t channel);
+    bool mergeUnits(PipelineState& state);
 
-    bool invokeDeepFilterFFI(fs::path chunkPath, DFState* df_state, std::vector<float>& inputBuffer,
-                             std::vector<float>& outputBuffer);
+    bool invokeDeepFilter(fs::path chunkPath);
 
-    std::string buildFilterComplex() const;
+    size_t getOverlapSamples() const;
+    size_t getWorkUnitSamples() const;
 
-    void populateChunkDurations(std::vector<double>& startTimes,
-                                std::vector<double>& durations) const;
+    /**
+     * @brief Number of work units filtered at once, locally or by the remote workers.
+     */
+    size_t getFilterConcurrency() const;
 };
 
 }  // namespace MediaProcessor
@@ -0,0 +1,21 @@
+#include "AudioUtils.h"
+
+namespace MediaProcessor::AudioUtils {
+
+void crossfade(const float* __restrict fadeOut, const float* __restrict fadeIn,
+               float* __restrict output, size_t numSamples) {
+    if (numSamples == 0) {
+        return;
+    }
+
+    // Gain is computed from a 32-bit index rather than accumulated, which keeps the loop
+    // vectorizable. Overlaps are far below INT32_MAX samples.
+    const int count = static_cast<int>(numSamples);
+    const float step = 1.0f / static_cast<float>(count);
+    for (int i = 0; i < count; ++i) {
+        const float gain = static_cast<float>(i) * step;
+        output[i] = fadeOut[i] + (fadeIn[i] - fadeOut[i]) * gain;
+    }
+}
+
+}  // namespace MediaProcessor::AudioUtils
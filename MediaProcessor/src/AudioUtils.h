@@ -0,0 +1,17 @@
+#ifndef AUDIOUTILS_H
+#define AUDIOUTILS_H
+
+#include <cstddef>
+
+namespace MediaProcessor::AudioUtils {
+
+/**
+ * @brief Linearly crossfades `fadeOut` into `fadeIn` over `numSamples` samples.
+ *
+ * Equivalent to FFmpeg's `acrossfade` with triangular curves on both sides.
+ */
+void crossfade(const float* fadeOut, const float* fadeIn, float* output, size_t numSamples);
+
+}  // namespace MediaProcessor::AudioUtils
+
+#endif  // AUDIOUTILS_H
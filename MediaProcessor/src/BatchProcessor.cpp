@@ -0,0 +1,107 @@
+#include "BatchProcessor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "Engine.h"
+#include "JobScheduler.h"
+
+namespace MediaProcessor {
+
+BatchProcessor::BatchProcessor(std::vector<fs::path> mediaPaths, unsigned int numThreads,
+                               unsigned int concurrentJobs)
+    : m_mediaPaths(std::move(mediaPaths)),
+      m_numThreads(numThreads),
+      m_concurrentJobs(std::max(concurrentJobs, 1u)) {}
+
+void BatchProcessor::setStreamingMode(bool enabled) {
+    m_streamingMode = enabled;
+}
+
+bool BatchProcessor::processAll() {
+    // Without interactive jobs to protect, the scheduler only splits the cores between files
+    JobScheduler scheduler(m_numThreads, 0.0, 0);
+    std::vector<char> succeeded(m_mediaPaths.size(), false);
+    std::atomic<size_t> nextFile = 0;
+
+    // Each runner takes the next file once its current one is done
+    auto runJobs = [&]() {
+        for (size_t i = nextFile++; i < m_mediaPaths.size(); i = nextFile++) {
+            std::cout << "INFO: processing file " << (i + 1) << "/" << m_mediaPaths.size()
+                      << ": " << m_mediaPaths[i] << std::endl;
+
+            std::optional<JobScheduler::Lease> jobLease = scheduler.admit(JobPriority::Batch, 0.0);
+
+            Engine engine(m_mediaPaths[i]);
+            engine.setStreamingMode(m_streamingMode);
+            engine.setJobLease(&*jobLease);
+            try {
+                succeeded[i] = engine.processMedia();
+            } catch (const std::exception& ex) {
+                std::cerr << "Error: " << ex.what() << std::endl;
+            }
+        }
+    };
+
+    std::vector<std::thread> runners;
+    const size_t numRunners = std::min<size_t>(m_concurrentJobs, m_mediaPaths.size());
+    for (size_t i = 0; i < numRunners; ++i) {
+        runners.emplace_back(runJobs);
+    }
+    for (auto& runner : runners) {
+        runner.join();
+    }
+
+    m_failedPaths.clear();
+    for (size_t i = 0; i < m_mediaPaths.size(); ++i) {
+        if (!succeeded[i]) {
+            m_failedPaths.push_back(m_mediaPaths[i]);
+        }
+    }
+
+    std::cout << "Batch finished: " << (m_mediaPaths.size() - m_failedPaths.size()) << "/"
+              << m_mediaPaths.size() << " files processed successfully." << std::endl;
+    for (const auto& path : m_failedPaths) {
+        std::cerr << "Failed: " << path << std::endl;
+    }
+
+    return m_failedPaths.empty();
+}
+
+const std::vector<fs::path>& BatchProcessor::getFailedPaths() const {
+    return m_failedPaths;
+}
+
+std::vector<fs::path> BatchProcessor::readManifest(const fs::path& manifestPath) {
+    std::ifstream manifest(manifestPath);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Could not open manifest " + manifestPath.string());
+    }
+
+    std::vector<fs::path> mediaPaths;
+    std::string line;
+    while (std::getline(manifest, line)) {
+        // Tolerate CRLF line endings and trailing whitespace
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        fs::path mediaPath = line;
+        mediaPaths.push_back(mediaPath.is_absolute() ? mediaPath
+                                                     : manifestPath.parent_path() / mediaPath);
+    }
+
+    return mediaPaths;
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,61 @@
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <filesystem>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Processes many media files in one process, on one shared worker pool.
+ *
+ * Up to `concurrentJobs` files are in flight at once. A `JobScheduler` splits the cores evenly
+ * between them; their work units are queued on the same thread pool and interleave there, so
+ * one file's decoding, merging or muxing overlaps with the filtering of another and cores stay
+ * busy between files. DeepFilterNet states are shared through the process-wide `DFStatePool`.
+ */
+class BatchProcessor {
+   public:
+    BatchProcessor(std::vector<fs::path> mediaPaths, unsigned int numThreads,
+                   unsigned int concurrentJobs);
+
+    /**
+     * @brief Forces constant-memory streaming mode for every file.
+     */
+    void setStreamingMode(bool enabled);
+
+    /**
+     * @brief Processes every file; a failing file does not stop the others.
+     *
+     * @return true if all files were processed successfully, false otherwise.
+     */
+    bool processAll();
+
+    /**
+     * @brief Files that failed during the last `processAll()`, in input order.
+     */
+    const std::vector<fs::path>& getFailedPaths() const;
+
+    /**
+     * @brief Reads a manifest listing one media file per line.
+     *
+     * Blank lines and lines starting with '#' are skipped. Relative paths are resolved against
+     * the manifest's directory.
+     *
+     * @throws std::runtime_error if the manifest cannot be read.
+     */
+    static std::vector<fs::path> readManifest(const fs::path& manifestPath);
+
+   private:
+    std::vector<fs::path> m_mediaPaths;
+    std::vector<fs::path> m_failedPaths;
+    unsigned int m_numThreads;
+    unsigned int m_concurrentJobs;
+    bool m_streamingMode = false;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // BATCHPROCESSOR_H
@@ -0,0 +1,17 @@
+#ifndef CHANNELMODE_H
+#define CHANNELMODE_H
+
+namespace MediaProcessor {
+
+/**
+ * @brief Channels the audio is decoded and processed with.
+ */
+enum class ChannelMode {
+    Mono,      // downmixed to a single channel
+    Source,    // the source layout, every channel filtered
+    Dialogue,  // the source layout, only the dialogue (front center) channel filtered
+};
+
+}  // namespace MediaProcessor
+
+#endif  // CHANNELMODE_H
@@ -0,0 +1,52 @@
+#include "ChunkStore.h"
+
+#include <fstream>
+
+#include "ContentHash.h"
+
+namespace MediaProcessor {
+
+ChunkStore::ChunkStore(const fs::path& directory, uintmax_t maxSize, const fs::path& modelPath,
+                       float attenLimit, float postFilterBeta)
+    : m_diskCache(directory, maxSize) {
+    // Digested once per run, units then only hash their samples on top
+    ContentHash hash;
+    hash.updateValue(CHUNK_STORE_VERSION);
+    hash.updateFileIdentity(modelPath);
+    hash.updateValue(attenLimit);
+    hash.updateValue(postFilterBeta);
+    m_settingsDigest = hash.finalize();
+}
+
+std::string ChunkStore::fingerprint(std::span<const float> samples) const {
+    ContentHash hash;
+    hash.updateString(m_settingsDigest);
+    hash.updateValue(static_cast<uint64_t>(samples.size()));
+    hash.update(samples);
+    return hash.finalize();
+}
+
+bool ChunkStore::load(const std::string& fingerprint, std::span<float> processedSamples) {
+    auto entryPath = m_diskCache.lookup(fingerprint);
+    if (!entryPath) {
+        return false;
+    }
+
+    // The entry may be evicted concurrently, a failed read is just a miss
+    std::ifstream file(*entryPath, std::ios::binary | std::ios::ate);
+    if (!file || static_cast<size_t>(file.tellg()) != processedSamples.size_bytes()) {
+        return false;
+    }
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(processedSamples.data()),
+              static_cast<std::streamsize>(processedSamples.size_bytes()));
+    return static_cast<bool>(file);
+}
+
+bool ChunkStore::save(const std::string& fingerprint, std::span<const float> processedSamples) {
+    return m_diskCache.store(
+        fingerprint, std::span<const char>(reinterpret_cast<const char*>(processedSamples.data()),
+                                           processedSamples.size_bytes()));
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,66 @@
+#ifndef CHUNKSTORE_H
+#define CHUNKSTORE_H
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+#include "DiskCache.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+// Bumped whenever a change to the filtering makes stored chunks stale
+constexpr int CHUNK_STORE_VERSION = 2;
+
+/**
+ * @brief Filtered work units shared across jobs, addressed by a fingerprint of their input.
+ *
+ * Episodic content repeats the same intro and outro music in every episode; units that decode to
+ * the same samples are filtered once and reused afterwards. A unit only matches if it starts at
+ * the same offset within the recurring material, as units are cut at fixed intervals.
+ *
+ * The fingerprint covers everything the filtered output depends on: the samples, the model and
+ * the filter settings of the run. Units are stored only if they were filtered on a DeepFilterNet
+ * state that never filtered anything before, see `DFStatePool::acquireFresh()`, so a unit's own
+ * samples are its entire context. Those states are loaded in the background while the store is
+ * enabled.
+ */
+class ChunkStore {
+   public:
+    /**
+     * @brief Opens the store for units filtered with the given model and settings.
+     *
+     * @throws std::runtime_error if the directory cannot be created or the model is missing.
+     */
+    ChunkStore(const fs::path& directory, uintmax_t maxSize, const fs::path& modelPath,
+               float attenLimit, float postFilterBeta);
+
+    /**
+     * @brief Fingerprint of a unit's input samples under the store's settings.
+     */
+    std::string fingerprint(std::span<const float> samples) const;
+
+    /**
+     * @brief Reads the filtered samples stored for `fingerprint` into `processedSamples`.
+     *
+     * @return false on a miss, or if the stored unit is not the size of `processedSamples`.
+     */
+    bool load(const std::string& fingerprint, std::span<float> processedSamples);
+
+    /**
+     * @brief Stores a unit's filtered samples, evicting the least recently used units.
+     *
+     * @return true if the unit was stored.
+     */
+    bool save(const std::string& fingerprint, std::span<const float> processedSamples);
+
+   private:
+    DiskCache m_diskCache;
+    std::string m_settingsDigest;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // CHUNKSTORE_H
@@ -36,6 +36,10 @@ std::string CommandBuilder::build() const {
     return Utils::trimTrailingSpace(commandStr);
 }
 
+std::vector<std::string> CommandBuilder::buildArgv() const {
+    return m_arguments;
+}
+
 std::string CommandBuilder::formatArgument(const std::string& arg) const {
     using MediaProcessor::Utils::containsWhitespace;
 
@@ -22,6 +22,11 @@ class CommandBuilder : public ICommandBuilder {
      */
     std::string build() const override;
 
+    /**
+     * @brief Returns the added arguments and flags as an argument vector.
+     */
+    std::vector<std::string> buildArgv() const override;
+
    private:
     std::vector<std::string> m_arguments;
 
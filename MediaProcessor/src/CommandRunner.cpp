@@ -0,0 +1,158 @@
+#include "CommandRunner.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+extern char** environ;
+
+namespace MediaProcessor::CommandRunner {
+
+namespace {
+
+// Large reads keep the number of syscalls low for chatty commands like ffmpeg
+constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @brief Closes its file descriptors on scope exit.
+ */
+struct Pipe {
+    int fds[2] = {-1, -1};
+
+    Pipe() {
+        if (pipe2(fds, O_CLOEXEC) != 0) {
+            throw std::runtime_error("Failed to create pipe: " + std::string(strerror(errno)));
+        }
+    }
+
+    ~Pipe() {
+        closeRead();
+        closeWrite();
+    }
+
+    void closeRead() {
+        if (fds[0] >= 0) {
+            close(fds[0]);
+            fds[0] = -1;
+        }
+    }
+
+    void closeWrite() {
+        if (fds[1] >= 0) {
+            close(fds[1]);
+            fds[1] = -1;
+        }
+    }
+};
+
+/**
+ * @brief Reads both pipes until the child closes them, without letting either one fill up.
+ */
+void drainPipes(Pipe& outputPipe, Pipe& errorPipe, CommandResult& result) {
+    std::array<char, READ_BUFFER_SIZE> buffer;
+    std::array<pollfd, 2> fds = {{{outputPipe.fds[0], POLLIN, 0}, {errorPipe.fds[0], POLLIN, 0}}};
+    std::array<std::string*, 2> outputs = {&result.standardOutput, &result.standardError};
+
+    int openFds = 2;
+    while (openFds > 0) {
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("Failed to poll command output: " +
+                                     std::string(strerror(errno)));
+        }
+
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (fds[i].fd < 0 || fds[i].revents == 0) {
+                continue;
+            }
+
+            ssize_t bytesRead = read(fds[i].fd, buffer.data(), buffer.size());
+            if (bytesRead > 0) {
+                outputs[i]->append(buffer.data(), bytesRead);
+            } else if (bytesRead == 0 || errno != EINTR) {
+                // End of file, or an error we cannot recover from
+                fds[i].fd = -1;
+                --openFds;
+            }
+        }
+    }
+}
+
+int waitForExit(pid_t pid) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            throw std::runtime_error("Failed to wait for command: " +
+                                     std::string(strerror(errno)));
+        }
+    }
+
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    if (WIFSIGNALED(status)) {
+        return 128 + WTERMSIG(status);
+    }
+    return -1;
+}
+
+}  // namespace
+
+CommandResult run(const std::vector<std::string>& argv) {
+    if (argv.empty()) {
+        throw std::runtime_error("Cannot run an empty command.");
+    }
+
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    Pipe outputPipe;
+    Pipe errorPipe;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, outputPipe.fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, errorPipe.fds[1], STDERR_FILENO);
+
+    pid_t pid = -1;
+    int ret = posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (ret != 0) {
+        throw std::runtime_error("Failed to run " + argv[0] + ": " + strerror(ret));
+    }
+
+    // Only the child may keep the write ends open, or reading would never see end of file
+    outputPipe.closeWrite();
+    errorPipe.closeWrite();
+
+    CommandResult result;
+    try {
+        drainPipes(outputPipe, errorPipe, result);
+    } catch (...) {
+        waitForExit(pid);
+        throw;
+    }
+    result.exitCode = waitForExit(pid);
+
+    return result;
+}
+
+std::future<CommandResult> runAsync(std::vector<std::string> argv) {
+    return std::async(std::launch::async, [argv = std::move(argv)]() { return run(argv); });
+}
+
+}  // namespace MediaProcessor::CommandRunner
@@ -0,0 +1,42 @@
+#ifndef COMMANDRUNNER_H
+#define COMMANDRUNNER_H
+
+#include <future>
+#include <string>
+#include <vector>
+
+namespace MediaProcessor::CommandRunner {
+
+/**
+ * @brief Exit status and captured output of a finished command.
+ */
+struct CommandResult {
+    int exitCode = -1;  // 128 + signal number if the command was killed by a signal
+    std::string standardOutput;
+    std::string standardError;
+
+    bool succeeded() const { return exitCode == 0; }
+};
+
+/**
+ * @brief Runs a command and waits for it to finish.
+ *
+ * The command is spawned directly with `posix_spawnp`, without a shell, so arguments are passed
+ * through verbatim and need no quoting. `argv[0]` is looked up in `PATH` unless it contains a
+ * slash. Standard output and standard error are captured separately; standard input is
+ * `/dev/null`.
+ *
+ * @throws std::runtime_error if the command cannot be spawned.
+ */
+CommandResult run(const std::vector<std::string>& argv);
+
+/**
+ * @brief Runs a command like `run()` on a background thread.
+ *
+ * Several commands can be in flight at once. Spawn errors are reported through the future.
+ */
+std::future<CommandResult> runAsync(std::vector<std::string> argv);
+
+}  // namespace MediaProcessor::CommandRunner
+
+#endif  // COMMANDRUNNER_H
@@ -29,6 +29,10 @@ bool ConfigManager::loadConfig(const fs::path& configFilePath) {
     return true;
 }
 
+bool ConfigManager::isLoaded() const {
+    return !m_config.is_null();
+}
+
 fs::path ConfigManager::getDeepFilterPath() const {
     return getConfigValue<std::string>("deep_filter_path");
 }
@@ -56,6 +60,17 @@ float ConfigManager::getFilterAttenuationLimit() const {
     return candidateLimit;
 }
 
+float ConfigManager::getFilterPostFilterBeta() const {
+    auto candidateBeta = getConfigValue<float>("filter_post_filter_beta", 0.0f);
+    if (candidateBeta < 0.0f) {
+        throw std::runtime_error(
+            fmt::format("Post-filter beta {} is not valid. Beta must not be negative.",
+                        candidateBeta));
+    }
+
+    return candidateBeta;
+}
+
 void ConfigManager::validateFilterAttenuationLimit(float candidateLimit) const {
     if (not Utils::isWithinRange(candidateLimit, 0.0f, 100.0f)) {
         throw std::runtime_error(
@@ -72,6 +87,94 @@ unsigned int ConfigManager::getOptimalThreadCount() {
     return determineNumThreads(configNumThreads, hardwareNumThreads);
 }
 
+bool ConfigManager::getUseStreamingMode() const {
+    return getConfigValue<bool>("use_streaming_mode", false);
+}
+
+unsigned int ConfigManager::getBatchConcurrentJobs() const {
+    auto concurrentJobs = getConfigValue<unsigned int>("batch_concurrent_jobs", 2);
+    if (concurrentJobs == 0) {
+        throw std::runtime_error("Batch concurrent jobs must be at least 1.");
+    }
+
+    return concurrentJobs;
+}
+
+double ConfigManager::getSchedulerLatencySlo() const {
+    auto latencySlo = getConfigValue<double>("scheduler_latency_slo", 0.0);
+    if (latencySlo < 0.0) {
+        throw std::runtime_error("Scheduler latency SLO must not be negative.");
+    }
+
+    return latencySlo;
+}
+
+int ConfigManager::getSchedulerBatchNiceness() const {
+    auto batchNiceness = getConfigValue<int>("scheduler_batch_niceness", 10);
+    if (batchNiceness < 0 || batchNiceness > 19) {
+        throw std::runtime_error("Scheduler batch niceness must be within [0, 19].");
+    }
+
+    return batchNiceness;
+}
+
+std::vector<std::string> ConfigManager::getDistributedWorkers() const {
+    return getConfigValue<std::vector<std::string>>("distributed_workers", {});
+}
+
+fs::path ConfigManager::getResultCachePath() const {
+    return getConfigValue<std::string>("result_cache_path", "");
+}
+
+uintmax_t ConfigManager::getResultCacheMaxSize() const {
+    auto maxSizeMb = getConfigValue<uintmax_t>("result_cache_max_size_mb", 2048);
+    if (maxSizeMb == 0) {
+        throw std::runtime_error("Result cache size must be at least 1 MB.");
+    }
+
+    return maxSizeMb * 1024 * 1024;
+}
+
+fs::path ConfigManager::getChunkStorePath() const {
+    return getConfigValue<std::string>("chunk_store_path", "");
+}
+
+uintmax_t ConfigManager::getChunkStoreMaxSize() const {
+    auto maxSizeMb = getConfigValue<uintmax_t>("chunk_store_max_size_mb", 4096);
+    if (maxSizeMb == 0) {
+        throw std::runtime_error("Chunk store size must be at least 1 MB.");
+    }
+
+    return maxSizeMb * 1024 * 1024;
+}
+
+uintmax_t ConfigManager::getAudioBufferPoolMaxSize() const {
+    return getConfigValue<uintmax_t>("audio_buffer_pool_max_size_mb", 1024) * 1024 * 1024;
+}
+
+bool ConfigManager::getAudioBufferHugePages() const {
+    return getConfigValue<bool>("audio_buffer_huge_pages", false);
+}
+
+ChannelMode ConfigManager::getAudioChannelMode() const {
+    auto channelMode = getConfigValue<std::string>("audio_channel_mode", "mono");
+    if (channelMode == "mono") {
+        return ChannelMode::Mono;
+    }
+    if (channelMode == "source") {
+        return ChannelMode::Source;
+    }
+    if (channelMode == "dialogue") {
+        return ChannelMode::Dialogue;
+    }
+
+    throw std::runtime_error("Audio channel mode must be \"mono\", \"source\" or \"dialogue\".");
+}
+
+bool ConfigManager::getRestoreSourceSampleRate() const {
+    return getConfigValue<bool>("restore_source_sample_rate", false);
+}
+
 unsigned int ConfigManager::getNumThreadsValue() {
     if (!getConfigValue<bool>("use_thread_cap")) {
         return 0;
@@ -1,9 +1,13 @@
 #ifndef CONFIGMANAGER_H
 #define CONFIGMANAGER_H
 
+#include <cstdint>
 #include <filesystem>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <vector>
+
+#include "ChannelMode.h"
 
 namespace fs = std::filesystem;
 namespace MediaProcessor {
@@ -25,6 +29,11 @@ class ConfigManager {
      */
     bool loadConfig(const fs::path& configFilePath);
 
+    /**
+     * @brief Whether a configuration has been loaded.
+     */
+    bool isLoaded() const;
+
     fs::path getDeepFilterPath() const;
     fs::path getDeepFilterTarballPath() const;
     fs::path getDeepFilterEncoderPath() const;
@@ -40,6 +49,15 @@ class ConfigManager {
      */
     float getFilterAttenuationLimit() const;
 
+    /**
+     * @brief Returns the DeepFilterNet post-filter beta or throws!
+     *
+     * @returns the `filter_post_filter_beta` option, 0.0f (post-filter disabled) if it is not set
+     *
+     * @throws std::runtime_error if the value provided is negative
+     */
+    float getFilterPostFilterBeta() const;
+
     /**
      * @brief Gets the optimal number of threads for processing.
      *
@@ -47,6 +65,112 @@ class ConfigManager {
      */
     unsigned int getOptimalThreadCount();
 
+    /**
+     * @brief Whether audio is processed in constant-memory streaming mode.
+     *
+     * @return The `use_streaming_mode` option, false if it is not set.
+     */
+    bool getUseStreamingMode() const;
+
+    /**
+     * @brief Number of files a batch processes at the same time.
+     *
+     * @return The `batch_concurrent_jobs` option, 2 if it is not set.
+     *
+     * @throws std::runtime_error if the value provided is 0
+     */
+    unsigned int getBatchConcurrentJobs() const;
+
+    /**
+     * @brief Seconds an interactive job may take before the scheduler rejects new ones.
+     *
+     * @return The `scheduler_latency_slo` option, 0.0 (admission control disabled) if it is not
+     *         set.
+     *
+     * @throws std::runtime_error if the value provided is negative
+     */
+    double getSchedulerLatencySlo() const;
+
+    /**
+     * @brief Nice value the scheduler's batch workers run at.
+     *
+     * @return The `scheduler_batch_niceness` option, 10 if it is not set.
+     *
+     * @throws std::runtime_error if the value provided is not within [0, 19]
+     */
+    int getSchedulerBatchNiceness() const;
+
+    /**
+     * @brief Workers ("host:port") filtering work units for this process, see WorkerServer.h.
+     *
+     * @return The `distributed_workers` option, empty (filter locally) if it is not set.
+     */
+    std::vector<std::string> getDistributedWorkers() const;
+
+    /**
+     * @brief Directory processed audio is cached in, keyed by the input audio and settings.
+     *
+     * @return The `result_cache_path` option, empty (caching disabled) if it is not set.
+     */
+    fs::path getResultCachePath() const;
+
+    /**
+     * @brief Size in bytes the result cache is trimmed to, least recently used first.
+     *
+     * @return The `result_cache_max_size_mb` option in bytes, 2048 MB if it is not set.
+     *
+     * @throws std::runtime_error if the value provided is 0
+     */
+    uintmax_t getResultCacheMaxSize() const;
+
+    /**
+     * @brief Directory filtered work units are shared in across jobs, keyed by their samples.
+     *
+     * @return The `chunk_store_path` option, empty (chunk reuse disabled) if it is not set.
+     */
+    fs::path getChunkStorePath() const;
+
+    /**
+     * @brief Size in bytes the chunk store is trimmed to, least recently used first.
+     *
+     * @return The `chunk_store_max_size_mb` option in bytes, 4096 MB if it is not set.
+     *
+     * @throws std::runtime_error if the value provided is 0
+     */
+    uintmax_t getChunkStoreMaxSize() const;
+
+    /**
+     * @brief Bytes of idle sample buffers kept for reuse across work units and jobs.
+     *
+     * @return The `audio_buffer_pool_max_size_mb` option in bytes, 1024 MB if it is not set. 0
+     * disables reuse.
+     */
+    uintmax_t getAudioBufferPoolMaxSize() const;
+
+    /**
+     * @brief Whether large sample buffers are backed by transparent huge pages.
+     *
+     * @return The `audio_buffer_huge_pages` option, false if it is not set.
+     */
+    bool getAudioBufferHugePages() const;
+
+    /**
+     * @brief Channels the audio is processed with, see `ChannelMode`.
+     *
+     * @return The `audio_channel_mode` option ("mono", "source" or "dialogue"), mono if it is not
+     *         set.
+     *
+     * @throws std::runtime_error if the value provided is not one of the modes
+     */
+    ChannelMode getAudioChannelMode() const;
+
+    /**
+     * @brief Whether the processed audio is converted back to the source sample rate.
+     *
+     * @return The `restore_source_sample_rate` option, false (written at 48kHz) if it is not set.
+     */
+    bool getRestoreSourceSampleRate() const;
+
    private:
     /**
      * @brief Gets the number of threads specified in the configuration.
@@ -0,0 +1,151 @@
+#include "ContentHash.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace MediaProcessor {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> ROUND_CONSTANTS = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+constexpr uint32_t rotateRight(uint32_t value, int bits) {
+    return (value >> bits) | (value << (32 - bits));
+}
+
+}  // namespace
+
+ContentHash::ContentHash()
+    : m_state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+              0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19} {}
+
+void ContentHash::update(const void* data, size_t size) {
+    if (size == 0) {
+        return;  // `data` may be null for empty spans
+    }
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    m_totalBytes += size;
+
+    // Top up a partially filled block first
+    if (m_blockSize > 0) {
+        size_t count = std::min(size, m_block.size() - m_blockSize);
+        std::memcpy(m_block.data() + m_blockSize, bytes, count);
+        m_blockSize += count;
+        bytes += count;
+        size -= count;
+        if (m_blockSize < m_block.size()) {
+            return;
+        }
+        processBlock(m_block.data());
+        m_blockSize = 0;
+    }
+
+    for (; size >= m_block.size(); bytes += m_block.size(), size -= m_block.size()) {
+        processBlock(bytes);
+    }
+
+    std::memcpy(m_block.data(), bytes, size);
+    m_blockSize = size;
+}
+
+void ContentHash::updateString(std::string_view text) {
+    updateValue(static_cast<uint64_t>(text.size()));
+    update(text.data(), text.size());
+}
+
+void ContentHash::updateFileIdentity(const std::filesystem::path& path) {
+    const std::filesystem::path canonicalPath = std::filesystem::canonical(path);
+    updateString(canonicalPath.string());
+    updateValue(static_cast<uint64_t>(std::filesystem::file_size(canonicalPath)));
+    updateValue(std::filesystem::last_write_time(canonicalPath).time_since_epoch().count());
+}
+
+void ContentHash::update(std::span<const float> samples) {
+    update(samples.data(), samples.size_bytes());
+}
+
+std::string ContentHash::finalize() {
+    const uint64_t totalBits = m_totalBytes * 8;
+
+    // Pad with a single 1 bit, zeros, and the message length as a 64-bit big-endian integer
+    m_block[m_blockSize++] = 0x80;
+    if (m_blockSize > 56) {
+        std::fill(m_block.begin() + m_blockSize, m_block.end(), 0);
+        processBlock(m_block.data());
+        m_blockSize = 0;
+    }
+    std::fill(m_block.begin() + m_blockSize, m_block.begin() + 56, 0);
+    for (int i = 0; i < 8; ++i) {
+        m_block[63 - i] = static_cast<uint8_t>(totalBits >> (8 * i));
+    }
+    processBlock(m_block.data());
+
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    std::string digest;
+    digest.reserve(64);
+    for (uint32_t word : m_state) {
+        for (int shift = 28; shift >= 0; shift -= 4) {
+            digest.push_back(HEX_DIGITS[(word >> shift) & 0xf]);
+        }
+    }
+    return digest;
+}
+
+void ContentHash::processBlock(const uint8_t* block) {
+    std::array<uint32_t, 64> schedule;
+    for (size_t i = 0; i < 16; ++i) {
+        schedule[i] = (static_cast<uint32_t>(block[4 * i]) << 24) |
+                      (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+                      (static_cast<uint32_t>(block[4 * i + 2]) << 8) | block[4 * i + 3];
+    }
+    for (size_t i = 16; i < 64; ++i) {
+        uint32_t s0 = rotateRight(schedule[i - 15], 7) ^ rotateRight(schedule[i - 15], 18) ^
+                      (schedule[i - 15] >> 3);
+        uint32_t s1 = rotateRight(schedule[i - 2], 17) ^ rotateRight(schedule[i - 2], 19) ^
+                      (schedule[i - 2] >> 10);
+        schedule[i] = schedule[i - 16] + s0 + schedule[i - 7] + s1;
+    }
+
+    uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+    uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+
+    for (size_t i = 0; i < 64; ++i) {
+        uint32_t s1 = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+        uint32_t choice = (e & f) ^ (~e & g);
+        uint32_t temp1 = h + s1 + choice + ROUND_CONSTANTS[i] + schedule[i];
+        uint32_t s0 = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+        uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        uint32_t temp2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    m_state[0] += a;
+    m_state[1] += b;
+    m_state[2] += c;
+    m_state[3] += d;
+    m_state[4] += e;
+    m_state[5] += f;
+    m_state[6] += g;
+    m_state[7] += h;
+}
+
+}  // namespace MediaProcessor
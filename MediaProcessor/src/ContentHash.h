@@ -0,0 +1,65 @@
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace MediaProcessor {
+
+/**
+ * @brief Incremental SHA-256, used to address cached results by their content.
+ *
+ * Numbers are hashed in host byte order, so digests are only comparable between machines of the
+ * same endianness.
+ */
+class ContentHash {
+   public:
+    ContentHash();
+
+    void update(const void* data, size_t size);
+    void update(std::span<const float> samples);
+
+    /**
+     * @brief Hashes a string prefixed by its length, so consecutive fields cannot run together.
+     */
+    void updateString(std::string_view text);
+
+    /**
+     * @brief Hashes the identity of a file, its canonical path, size and modification time,
+     *        without reading it.
+     *
+     * @throws std::filesystem::filesystem_error if the file does not exist.
+     */
+    void updateFileIdentity(const std::filesystem::path& path);
+
+    template <typename T>
+    void updateValue(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "only plain values can be hashed");
+        update(&value, sizeof(value));
+    }
+
+    /**
+     * @brief Completes the hash. The object must not be updated afterwards.
+     *
+     * @return The digest as 64 lowercase hex characters.
+     */
+    std::string finalize();
+
+   private:
+    std::array<uint32_t, 8> m_state;
+    std::array<uint8_t, 64> m_block;
+    size_t m_blockSize = 0;
+    uint64_t m_totalBytes = 0;
+
+    void processBlock(const uint8_t* block);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // CONTENTHASH_H
@@ -0,0 +1,270 @@
+#include "DFStatePool.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace MediaProcessor {
+
+DFStatePool::Lease::Lease(DFStatePool* pool, PooledState pooledState)
+    : m_pool(pool), m_pooledState(std::move(pooledState)) {}
+
+DFStatePool::Lease::Lease(Lease&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr)),
+      m_pooledState(std::exchange(other.m_pooledState, {})) {}
+
+DFStatePool::Lease& DFStatePool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_pooledState = std::exchange(other.m_pooledState, {});
+    }
+    return *this;
+}
+
+DFStatePool::Lease::~Lease() {
+    reset();
+}
+
+void DFStatePool::Lease::reset() {
+    if (m_pool) {
+        m_pool->release(std::move(m_pooledState));
+    } else if (m_pooledState.state) {
+        df_free(m_pooledState.state);
+    }
+    m_pooledState = {};
+}
+
+DFState* DFStatePool::Lease::get() const {
+    return m_pooledState.state;
+}
+
+size_t DFStatePool::Lease::getFrameLength() const {
+    return m_pooledState.frameLength;
+}
+
+void DFStatePool::Lease::process(std::span<const float> input, std::span<float> output) const {
+    if (output.size() != input.size()) {
+        throw std::runtime_error("Filter output does not match the input length.");
+    }
+
+    const size_t frameLength = m_pooledState.frameLength;
+    std::vector<float> inputBuffer(frameLength);
+    std::vector<float> outputBuffer(frameLength);
+
+    for (size_t offset = 0; offset < input.size(); offset += frameLength) {
+        size_t numFrames = std::min(frameLength, input.size() - offset);
+        std::copy_n(input.begin() + offset, numFrames, inputBuffer.begin());
+        std::fill(inputBuffer.begin() + numFrames, inputBuffer.end(), 0.0f);
+
+        if (numFrames == frameLength) {
+            df_process_frame(m_pooledState.state, inputBuffer.data(), output.data() + offset);
+        } else {
+            df_process_frame(m_pooledState.state, inputBuffer.data(), outputBuffer.data());
+            std::copy_n(outputBuffer.begin(), numFrames, output.begin() + offset);
+        }
+    }
+}
+
+DFStatePool& DFStatePool::getInstance() {
+    static DFStatePool instance;
+    return instance;
+}
+
+DFStatePool::Lease DFStatePool::acquire(const fs::path& modelPath, float attenLimit,
+                                        float postFilterBeta) {
+    const std::string modelKey = fs::absolute(modelPath).string();
+
+    Lease::PooledState pooledState;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& idleStates = m_idleStates[modelKey];
+        if (!idleStates.empty()) {
+            pooledState = std::move(idleStates.back());
+            idleStates.pop_back();
+        }
+    }
+
+    if (pooledState.state) {
+        // Retune the warm state instead of loading the model again
+        retune(pooledState, attenLimit, postFilterBeta);
+        return Lease(this, std::move(pooledState));
+    }
+
+    // Created outside the lock, so concurrent workers load their states in parallel
+    return Lease(this, createState(modelPath, attenLimit, postFilterBeta));
+}
+
+DFStatePool::Lease DFStatePool::acquireFresh(const fs::path& modelPath, float attenLimit,
+                                             float postFilterBeta) {
+    const std::string modelKey = fs::absolute(modelPath).string();
+
+    Lease::PooledState pooledState;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto reserve = m_freshReserves.find(modelKey);
+        if (reserve != m_freshReserves.end() && !reserve->second.states.empty()) {
+            pooledState = std::move(reserve->second.states.back());
+            reserve->second.states.pop_back();
+            m_refillNeeded.notify_one();
+        }
+    }
+
+    // Settings only affect frames filtered after they are applied, the state is still fresh
+    if (pooledState.state) {
+        retune(pooledState, attenLimit, postFilterBeta);
+        return Lease(nullptr, std::move(pooledState));
+    }
+    return Lease(nullptr, createState(modelPath, attenLimit, postFilterBeta));
+}
+
+void DFStatePool::reserveFresh(const fs::path& modelPath, size_t count, float attenLimit,
+                               float postFilterBeta) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    FreshReserve& reserve = m_freshReserves[fs::absolute(modelPath).string()];
+    reserve.modelPath = modelPath;
+    reserve.count = count;
+    reserve.attenLimit = attenLimit;
+    reserve.postFilterBeta = postFilterBeta;
+
+    if (!m_refillThread.joinable()) {
+        m_refillThread = std::thread([this]() { refillReserves(); });
+    }
+    m_refillNeeded.notify_one();
+}
+
+void DFStatePool::retune(Lease::PooledState& pooledState, float attenLimit,
+                         float postFilterBeta) {
+    if (pooledState.attenLimit != attenLimit) {
+        df_set_atten_lim(pooledState.state, attenLimit);
+        pooledState.attenLimit = attenLimit;
+    }
+    if (pooledState.postFilterBeta != postFilterBeta) {
+        df_set_post_filter_beta(pooledState.state, postFilterBeta);
+        pooledState.postFilterBeta = postFilterBeta;
+    }
+}
+
+DFStatePool::Lease::PooledState DFStatePool::createState(const fs::path& modelPath,
+                                                         float attenLimit, float postFilterBeta) {
+    DFState* state = df_create(modelPath.c_str(), attenLimit, nullptr);
+    if (!state) {
+        throw std::runtime_error("Failed to instantiate DFState from " + modelPath.string());
+    }
+    if (postFilterBeta != 0.0f) {
+        df_set_post_filter_beta(state, postFilterBeta);
+    }
+
+    Lease::PooledState pooledState;
+    pooledState.state = state;
+    pooledState.modelKey = fs::absolute(modelPath).string();
+    pooledState.frameLength = df_get_frame_length(state);
+    pooledState.attenLimit = attenLimit;
+    pooledState.postFilterBeta = postFilterBeta;
+    return pooledState;
+}
+
+void DFStatePool::release(Lease::PooledState pooledState) {
+    if (!pooledState.state) {
+        return;
+    }
+
+    // Flush the previous audio out of the state so the next user starts from silence
+    std::vector<float> silence(pooledState.frameLength, 0.0f);
+    std::vector<float> discarded(pooledState.frameLength);
+    for (size_t i = 0; i < DFSTATE_RESET_FRAMES; ++i) {
+        df_process_frame(pooledState.state, silence.data(), discarded.data());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_idleStates[pooledState.modelKey].push_back(std::move(pooledState));
+}
+
+void DFStatePool::refillReserves() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        // Reserves are never erased, so the pointer stays valid while the lock is released
+        FreshReserve* shortReserve = nullptr;
+        m_refillNeeded.wait(lock, [&]() {
+            for (auto& [modelKey, reserve] : m_freshReserves) {
+                if (reserve.states.size() + reserve.loading < reserve.count) {
+                    shortReserve = &reserve;
+                    return true;
+                }
+            }
+            return m_stopping;
+        });
+        if (m_stopping) {
+            return;
+        }
+
+        // Loaded outside the lock, callers keep taking states meanwhile
+        ++shortReserve->loading;
+        const fs::path modelPath = shortReserve->modelPath;
+        const float attenLimit = shortReserve->attenLimit;
+        const float postFilterBeta = shortReserve->postFilterBeta;
+        lock.unlock();
+
+        Lease::PooledState pooledState;
+        std::string error;
+        try {
+            pooledState = createState(modelPath, attenLimit, postFilterBeta);
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        }
+
+        lock.lock();
+        --shortReserve->loading;
+        if (!pooledState.state) {
+            // Not retried, callers load their own states and report the error
+            std::cerr << "Warning: stopped reserving DeepFilterNet states: " << error << std::endl;
+            shortReserve->count = 0;
+        } else if (shortReserve->count == 0) {
+            df_free(pooledState.state);  // cleared while loading
+        } else {
+            shortReserve->states.push_back(std::move(pooledState));
+        }
+    }
+}
+
+void DFStatePool::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& [modelKey, idleStates] : m_idleStates) {
+        for (auto& pooledState : idleStates) {
+            df_free(pooledState.state);
+        }
+    }
+    m_idleStates.clear();
+
+    for (auto& [modelKey, reserve] : m_freshReserves) {
+        for (auto& pooledState : reserve.states) {
+            df_free(pooledState.state);
+        }
+        reserve.states.clear();
+        reserve.count = 0;
+    }
+}
+
+size_t DFStatePool::getIdleCount() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& [modelKey, idleStates] : m_idleStates) {
+        count += idleStates.size();
+    }
+    return count;
+}
+
+DFStatePool::~DFStatePool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_refillNeeded.notify_all();
+    if (m_refillThread.joinable()) {
+        m_refillThread.join();
+    }
+    clear();
+}
+
+}  // namespace MediaProcessor
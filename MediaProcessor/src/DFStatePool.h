@@ -0,0 +1,166 @@
+#ifndef DFSTATEPOOL_H
+#define DFSTATEPOOL_H
+
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "DeepFilterNetFFI.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Number of silent frames fed to a state when it is returned to the pool.
+ *
+ * The C API has no reset, so the model's lookahead and recurrent state are flushed with silence
+ * instead. 50 frames correspond to 0.5s at DeepFilterNet's 10ms hop.
+ */
+constexpr size_t DFSTATE_RESET_FRAMES = 50;
+
+/**
+ * @brief Process-wide pool of DeepFilterNet states shared across chunks and jobs.
+ *
+ * Loading the model is a large fixed cost, so states are created once per concurrent user and
+ * handed out again afterwards. Differing settings are applied to an idle state instead of
+ * creating a new one. States that have never filtered anything are kept in a separate reserve,
+ * refilled by a background thread.
+ */
+class DFStatePool {
+   public:
+    /**
+     * @brief A state borrowed from the pool, returned to it on destruction.
+     *
+     * Unpooled leases own a state of their own instead, freed on destruction.
+     */
+    class Lease {
+       public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        DFState* get() const;
+        size_t getFrameLength() const;
+
+        /**
+         * @brief Filters `input` frame by frame into `output`, zero-padding the last frame.
+         *
+         * @throws std::runtime_error if `output` is not the size of `input`.
+         */
+        void process(std::span<const float> input, std::span<float> output) const;
+
+       private:
+        friend class DFStatePool;
+        struct PooledState {
+            DFState* state = nullptr;
+            std::string modelKey;
+            size_t frameLength = 0;
+            float attenLimit = 0.0f;
+            float postFilterBeta = 0.0f;
+        };
+
+        Lease(DFStatePool* pool, PooledState pooledState);
+
+        /**
+         * @brief Returns the state to the pool, or frees it if the lease is unpooled.
+         */
+        void reset();
+
+        DFStatePool* m_pool;
+        PooledState m_pooledState;
+    };
+
+    /**
+     * @brief Retrieves the process-wide pool.
+     */
+    static DFStatePool& getInstance();
+
+    /**
+     * @brief Hands out an idle state for the model, creating one if none is idle.
+     *
+     * @param attenLimit Attenuation limit in dB applied to the state.
+     * @param postFilterBeta Post-filter beta applied to the state, 0 disables the post-filter.
+     *
+     * @throws std::runtime_error if a new state cannot be created.
+     */
+    Lease acquire(const fs::path& modelPath, float attenLimit, float postFilterBeta = 0.0f);
+
+    /**
+     * @brief Hands out a state that has never filtered anything, freed when the lease goes away.
+     *
+     * Pooled states carry recurrent history past their silence flush, so their output depends
+     * on what they filtered before. Fresh states come from the reserve kept by `reserveFresh()`,
+     * the model is only loaded by the caller if the reserve is empty.
+     *
+     * @throws std::runtime_error if a new state cannot be created.
+     */
+    Lease acquireFresh(const fs::path& modelPath, float attenLimit, float postFilterBeta = 0.0f);
+
+    /**
+     * @brief Keeps `count` fresh states of the model ready, loaded in the background.
+     *
+     * The reserve is refilled whenever `acquireFresh()` takes a state from it, and stays in
+     * place for later jobs until `clear()`.
+     */
+    void reserveFresh(const fs::path& modelPath, size_t count, float attenLimit,
+                      float postFilterBeta = 0.0f);
+
+    /**
+     * @brief Frees all idle and reserved states and stops refilling the reserves. States
+     *        currently leased return to the pool as usual.
+     */
+    void clear();
+
+    /**
+     * @brief Number of idle states across all models.
+     */
+    size_t getIdleCount();
+
+    ~DFStatePool();
+
+   private:
+    DFStatePool() = default;
+
+    struct FreshReserve {
+        fs::path modelPath;
+        size_t count = 0;    // states to keep ready
+        size_t loading = 0;  // states the refill thread is creating
+        float attenLimit = 0.0f;
+        float postFilterBeta = 0.0f;
+        std::vector<Lease::PooledState> states;
+    };
+
+    void release(Lease::PooledState pooledState);
+
+    /**
+     * @brief Applies the settings to a state, unless it already has them.
+     */
+    static void retune(Lease::PooledState& pooledState, float attenLimit, float postFilterBeta);
+
+    static Lease::PooledState createState(const fs::path& modelPath, float attenLimit,
+                                          float postFilterBeta);
+
+    /**
+     * @brief Body of the refill thread, creates states for reserves below their count.
+     */
+    void refillReserves();
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::vector<Lease::PooledState>> m_idleStates;
+    std::unordered_map<std::string, FreshReserve> m_freshReserves;
+    std::condition_variable m_refillNeeded;
+    std::thread m_refillThread;  // started by the first `reserveFresh()`
+    bool m_stopping = false;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // DFSTATEPOOL_H
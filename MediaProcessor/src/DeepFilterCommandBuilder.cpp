@@ -45,14 +45,22 @@ DeepFilterCommandBuilder& DeepFilterCommandBuilder::enableDelayCompensation() {
 }
 
 std::string DeepFilterCommandBuilder::build() const {
+    validate();
+    return CommandBuilder::build();
+}
+
+std::vector<std::string> DeepFilterCommandBuilder::buildArgv() const {
+    validate();
+    return CommandBuilder::buildArgv();
+}
+
+void DeepFilterCommandBuilder::validate() const {
     if (m_inputAudioPath.empty()) {
         throw std::runtime_error("Input audio path must be specified.");
     }
     if (m_outputAudioPath.empty()) {
         throw std::runtime_error("Output audio path must be specified.");
     }
-
-    return CommandBuilder::build();
 }
 
 }  // namespace MediaProcessor
\ No newline at end of file
@@ -61,10 +61,19 @@ class DeepFilterCommandBuilder : public CommandBuilder {
      */
     std::string build() const override;
 
+    /**
+     * @brief Builds the final DeepFilter command as an argument vector.
+     *
+     * @throws std::runtime_error if required parameters (input or output file) are missing.
+     */
+    std::vector<std::string> buildArgv() const override;
+
    private:
     std::string m_inputAudioPath;
     std::string m_outputAudioPath;
     double m_noiseReductionLevel = 0.5;
+
+    void validate() const;
 };
 
 }  // namespace MediaProcessor
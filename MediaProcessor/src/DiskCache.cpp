@@ -0,0 +1,199 @@
+#include "DiskCache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace MediaProcessor {
+
+namespace {
+
+// In-progress entries start with a dot and are ignored by lookups and eviction
+bool isTemporary(const fs::path& path) {
+    return path.filename().string().starts_with('.');
+}
+
+}  // namespace
+
+DiskCache::DiskCache(const fs::path& directory, uintmax_t maxSize)
+    : m_directory(directory), m_maxSize(maxSize) {
+    std::error_code error;
+    fs::create_directories(m_directory, error);
+    if (error) {
+        throw std::runtime_error("Could not create cache directory " + m_directory.string() +
+                                 ": " + error.message());
+    }
+    m_trackedSize = scanSize();
+}
+
+std::optional<fs::path> DiskCache::lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const fs::path entryPath = getEntryPath(key);
+
+    std::error_code error;
+    fs::last_write_time(entryPath, fs::file_time_type::clock::now(), error);
+    if (error) {
+        return std::nullopt;  // missing, or evicted by another process
+    }
+    return entryPath;
+}
+
+bool DiskCache::retrieve(const std::string& key, const fs::path& destination) {
+    auto entryPath = lookup(key);
+    if (!entryPath) {
+        return false;
+    }
+
+    // Outputs are always replaced, never modified in place, so sharing the inode is safe
+    std::error_code error;
+    fs::remove(destination, error);
+    fs::create_hard_link(*entryPath, destination, error);
+    if (error) {
+        fs::copy_file(*entryPath, destination, fs::copy_options::overwrite_existing, error);
+    }
+    return !error;
+}
+
+bool DiskCache::store(const std::string& key, const fs::path& source) {
+    std::error_code error;
+    const uintmax_t size = fs::file_size(source, error);
+    if (error || size > m_maxSize) {
+        return false;
+    }
+
+    // Copy outside the lock, then publish the complete entry atomically
+    const fs::path temporaryPath = getTemporaryPath(key);
+    fs::copy_file(source, temporaryPath, fs::copy_options::overwrite_existing, error);
+    if (error) {
+        fs::remove(temporaryPath, error);
+        return false;
+    }
+    return publish(key, temporaryPath);
+}
+
+bool DiskCache::store(const std::string& key, std::span<const char> data) {
+    if (data.size() > m_maxSize) {
+        return false;
+    }
+
+    const fs::path temporaryPath = getTemporaryPath(key);
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file) {
+        std::error_code error;
+        fs::remove(temporaryPath, error);
+        return false;
+    }
+    return publish(key, temporaryPath);
+}
+
+fs::path DiskCache::getStagingPath(const std::string& key) const {
+    return getTemporaryPath(key);
+}
+
+bool DiskCache::commit(const std::string& key, const fs::path& stagingPath) {
+    std::error_code error;
+    const uintmax_t size = fs::file_size(stagingPath, error);
+    if (error || size > m_maxSize) {
+        fs::remove(stagingPath, error);
+        return false;
+    }
+    return publish(key, stagingPath);
+}
+
+uintmax_t DiskCache::getSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return scanSize();
+}
+
+uintmax_t DiskCache::scanSize() const {
+    uintmax_t size = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(m_directory, error)) {
+        if (entry.is_regular_file(error) && !isTemporary(entry.path())) {
+            size += entry.file_size(error);
+        }
+    }
+    return size;
+}
+
+fs::path DiskCache::getEntryPath(const std::string& key) const {
+    return m_directory / key;
+}
+
+fs::path DiskCache::getTemporaryPath(const std::string& key) const {
+    return m_directory /
+           ("." + key + "." + std::to_string(getpid()) + "." +
+            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())));
+}
+
+bool DiskCache::publish(const std::string& key, const fs::path& temporaryPath) {
+    std::error_code error;
+    const uintmax_t size = fs::file_size(temporaryPath, error);
+    if (error) {
+        fs::remove(temporaryPath, error);
+        return false;
+    }
+
+    // A republished key replaces its entry
+    const fs::path entryPath = getEntryPath(key);
+    uintmax_t replacedSize = fs::file_size(entryPath, error);
+    if (error) {
+        replacedSize = 0;
+    }
+
+    fs::rename(temporaryPath, entryPath, error);
+    if (error) {
+        fs::remove(temporaryPath, error);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    fs::last_write_time(entryPath, fs::file_time_type::clock::now(), error);
+    m_trackedSize = m_trackedSize - std::min(m_trackedSize, replacedSize) + size;
+    if (m_trackedSize > m_maxSize) {
+        evict();
+    }
+    return true;
+}
+
+void DiskCache::evict() {
+    struct Entry {
+        fs::path path;
+        uintmax_t size;
+        fs::file_time_type lastUsed;
+    };
+
+    std::vector<Entry> entries;
+    uintmax_t totalSize = 0;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(m_directory, error)) {
+        if (!entry.is_regular_file(error) || isTemporary(entry.path())) {
+            continue;
+        }
+        entries.push_back({entry.path(), entry.file_size(error), entry.last_write_time(error)});
+        totalSize += entries.back().size;
+    }
+
+    const auto targetSize =
+        static_cast<uintmax_t>(static_cast<double>(m_maxSize) * EVICTION_TARGET);
+    if (totalSize > m_maxSize) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+        // The most recent entry, usually the one just published, is always kept
+        for (size_t i = 0; i + 1 < entries.size() && totalSize > targetSize; ++i) {
+            if (fs::remove(entries[i].path, error)) {
+                totalSize -= entries[i].size;
+            }
+        }
+    }
+    m_trackedSize = totalSize;
+}
+
+}  // namespace MediaProcessor
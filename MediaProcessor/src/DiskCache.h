@@ -0,0 +1,114 @@
+#ifndef DISKCACHE_H
+#define DISKCACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+// Fraction of the size cap the cache is trimmed to once it exceeds it
+constexpr double EVICTION_TARGET = 0.9;
+
+/**
+ * @brief Directory of files addressed by key, with LRU eviction and a size cap.
+ *
+ * Every entry is a single file named after its key. Its modification time records when it was
+ * last used, so the least recently used entries are evicted first once the directory outgrows
+ * `maxSize`. Entries are published by renaming a complete temporary file, so processes sharing
+ * the directory never see partial entries.
+ *
+ * The size is tracked as entries are published, the directory is only scanned once it exceeds
+ * the cap. Eviction then goes down to `EVICTION_TARGET` of the cap, so a full cache is not
+ * rescanned on every store. Entries added by other processes are counted at the next scan.
+ */
+class DiskCache {
+   public:
+    /**
+     * @throws std::runtime_error if the directory cannot be created.
+     */
+    DiskCache(const fs::path& directory, uintmax_t maxSize);
+
+    /**
+     * @brief Path of the entry for `key`, refreshed as most recently used.
+     *
+     * @return The entry, or std::nullopt on a miss.
+     */
+    std::optional<fs::path> lookup(const std::string& key);
+
+    /**
+     * @brief Places the entry for `key` at `destination`, hard-linked if possible.
+     *
+     * @return false on a miss or if the entry could not be placed.
+     */
+    bool retrieve(const std::string& key, const fs::path& destination);
+
+    /**
+     * @brief Copies `source` into the cache under `key`, then evicts down to the size cap.
+     *
+     * Files larger than the cap are not stored.
+     *
+     * @return true if the entry was stored.
+     */
+    bool store(const std::string& key, const fs::path& source);
+
+    /**
+     * @brief Writes `data` into the cache under `key`, like `store()` for an in-memory entry.
+     */
+    bool store(const std::string& key, std::span<const char> data);
+
+    /**
+     * @brief Temporary path where the entry for `key` can be written in place.
+     *
+     * The file is invisible to lookups until `commit()` publishes it.
+     */
+    fs::path getStagingPath(const std::string& key) const;
+
+    /**
+     * @brief Publishes a file written at `getStagingPath(key)` as the entry for `key`.
+     *
+     * The staged file is removed if it cannot be stored, like `store()` it must fit the cap.
+     *
+     * @return true if the entry was stored.
+     */
+    bool commit(const std::string& key, const fs::path& stagingPath);
+
+    /**
+     * @brief Total size of the entries in bytes.
+     */
+    uintmax_t getSize() const;
+
+   private:
+    fs::path m_directory;
+    uintmax_t m_maxSize;
+    uintmax_t m_trackedSize = 0;  // size of the entries as of the last scan and publishes
+    mutable std::mutex m_mutex;
+
+    fs::path getEntryPath(const std::string& key) const;
+    fs::path getTemporaryPath(const std::string& key) const;
+
+    /**
+     * @brief Renames a complete temporary file into place as the entry for `key`.
+     */
+    bool publish(const std::string& key, const fs::path& temporaryPath);
+
+    /**
+     * @brief Sums the entries on disk, ignoring in-progress ones.
+     */
+    uintmax_t scanSize() const;
+
+    /**
+     * @brief Rescans the directory and removes the least recently used entries down to the
+     *        eviction target.
+     */
+    void evict();
+};
+
+}  // namespace MediaProcessor
+
+#endif  // DISKCACHE_H
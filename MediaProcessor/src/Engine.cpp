@@ -2,85 +2,246 @@
 
 #include <iostream>
 
-#include "AudioProcessor.h"
 #include "ConfigManager.h"
+#include "MediaMuxer.h"
+#include "ResultCache.h"
+#include "Tracer.h"
 #include "Utils.h"
 #include "VideoProcessor.h"
+#include "WavFileWriter.h"
+#include "WorkCoordinator.h"
 
 namespace MediaProcessor {
 
+namespace {
+
+/**
+ * @brief Writes the processed audio to two sinks, the output and the result cache.
+ */
+class TeeAudioSink : public IAudioSink {
+   public:
+    TeeAudioSink(std::unique_ptr<IAudioSink> first, std::unique_ptr<IAudioSink> second)
+        : m_first(std::move(first)), m_second(std::move(second)) {}
+
+    void writePlanar(std::span<const float* const> channels, size_t numFrames) override {
+        m_first->writePlanar(channels, numFrames);
+        m_second->writePlanar(channels, numFrames);
+    }
+
+    void close() override {
+        m_first->close();
+        m_second->close();
+    }
+
+   private:
+    std::unique_ptr<IAudioSink> m_first;
+    std::unique_ptr<IAudioSink> m_second;
+};
+
+}  // namespace
+
 Engine::Engine(const std::filesystem::path& mediaPath)
     : m_mediaPath(std::filesystem::absolute(mediaPath)) {}
 
+Engine::Engine(const MediaInfo& mediaInfo)
+    : m_mediaPath(std::filesystem::absolute(mediaInfo.path)),
+      m_mediaInfo(mediaInfo),
+      m_isProbed(true) {}
+
+Engine::~Engine() = default;
+
+void Engine::setStreamingMode(bool enabled) {
+    m_forceStreamingMode = enabled;
+}
+
+void Engine::setJobLease(const JobScheduler::Lease* jobLease) {
+    m_jobLease = jobLease;
+}
+
+const std::filesystem::path& Engine::getOutputPath() const {
+    return m_outputPath;
+}
+
+const JobMetrics* Engine::getJobMetrics() const {
+    return m_jobMetrics.get();
+}
+
 bool Engine::processMedia() {
+    TRACE_SCOPE("process media");
+    m_jobMetrics = std::make_unique<JobMetrics>();
+
     ConfigManager& configManager = ConfigManager::getInstance();
-    if (!configManager.loadConfig("config.json")) {
+    if (!configManager.isLoaded() && !configManager.loadConfig("config.json")) {
         std::cerr << "Error: Could not load configuration." << std::endl;
         return false;
     }
 
-    MediaType mediaType;
-    mediaType = TRY(getMediaType());
+    m_useStreamingMode = m_forceStreamingMode || configManager.getUseStreamingMode();
+    if (m_useStreamingMode) {
+        std::cout << "INFO: using streaming mode." << std::endl;
+    }
+
+    if (!m_isProbed) {
+        TRACE_SCOPE("probe");
+        JobMetrics::ScopedTimer timer(m_jobMetrics.get(), JobMetrics::Stage::Probe);
+        m_mediaInfo = TRY(MediaInfo::probe(m_mediaPath));
+        m_isProbed = true;
+    }
+    m_jobMetrics->setAudioDuration(m_mediaInfo.duration);
+    connectWorkers();
 
-    switch (mediaType) {
+    bool success = false;
+    switch (m_mediaInfo.getMediaType()) {
         case MediaType::Audio:
-            return processAudio();
+            success = processAudio();
+            break;
         case MediaType::Video:
-            return processVideo();
+            success = processVideo();
+            break;
         default:
             std::cerr << "Unsupported file type." << std::endl;
             return false;
     }
+
+    m_jobMetrics->finish();
+    if (success) {
+        std::cout << "INFO: " << m_jobMetrics->formatReport() << std::endl;
+    }
+    return success;
 }
 
 bool Engine::processAudio() {
-    AudioProcessor audioProcessor(m_mediaPath, Utils::prepareAudioOutputPath(m_mediaPath));
-    if (!audioProcessor.isolateVocals()) {
+    const auto processedAudioPath = Utils::prepareAudioOutputPath(m_mediaPath);
+    if (!isolateVocals(processedAudioPath)) {
         std::cerr << "Failed to process audio." << std::endl;
         return false;
     }
-    std::cout << "Audio processed successfully: " << Utils::prepareAudioOutputPath(m_mediaPath)
-              << std::endl;
+    m_outputPath = processedAudioPath;
+    std::cout << "Audio processed successfully: " << processedAudioPath << std::endl;
     return true;
 }
 
 bool Engine::processVideo() {
+    // The audio path only names the output directory, the processed audio goes to the muxer
     auto [extractedVocalsPath, processedMediaPath] = Utils::prepareOutputPaths(m_mediaPath);
-    AudioProcessor audioProcessor(m_mediaPath, extractedVocalsPath);
 
-    if (!audioProcessor.isolateVocals()) {
-        std::cerr << "Failed to extract vocals from video." << std::endl;
-        return false;
-    }
+    std::string key;
+    std::unique_ptr<ResultCache> resultCache = openResultCache(key);
+    if (auto cachedAudioPath = resultCache ? resultCache->find(key) : std::nullopt) {
+        std::cout << "INFO: reusing cached result " << key << "." << std::endl;
 
-    VideoProcessor videoProcessor(m_mediaPath, extractedVocalsPath, processedMediaPath);
-    if (!videoProcessor.mergeMedia()) {
-        std::cerr << "Failed to merge audio and video." << std::endl;
-        return false;
+        VideoProcessor videoProcessor(m_mediaInfo, *cachedAudioPath, processedMediaPath);
+        JobMetrics::ScopedTimer timer(m_jobMetrics.get(), JobMetrics::Stage::Mux);
+        if (!videoProcessor.mergeMedia()) {
+            std::cerr << "Failed to merge audio and video." << std::endl;
+            return false;
+        }
+    } else {
+        // On a miss the result is also written to the cache, without a second decode
+        const std::filesystem::path stagingPath =
+            resultCache ? resultCache->getStagingPath(key) : std::filesystem::path();
+        auto audioSinkFactory = [&](int sampleRate, int channels) -> std::unique_ptr<IAudioSink> {
+            auto muxer = std::make_unique<MediaMuxer>(m_mediaInfo, processedMediaPath,
+                                                      sampleRate, channels);
+            if (stagingPath.empty()) {
+                return muxer;
+            }
+            return std::make_unique<TeeAudioSink>(
+                std::move(muxer),
+                std::make_unique<WavFileWriter>(stagingPath, sampleRate, channels));
+        };
+
+        if (!runAudioProcessor(extractedVocalsPath, audioSinkFactory)) {
+            std::error_code error;
+            std::filesystem::remove(stagingPath, error);
+            std::cerr << "Failed to extract vocals from video." << std::endl;
+            return false;
+        }
+        if (resultCache && !resultCache->commit(key, stagingPath)) {
+            std::cerr << "Warning: could not cache the result." << std::endl;
+        }
     }
 
+    m_outputPath = processedMediaPath;
     std::cout << "Video processed successfully: " << processedMediaPath << std::endl;
     return true;
 }
 
-MediaType Engine::getMediaType() const {
-    const std::string command =
-        "ffprobe -loglevel error -show_entries stream=codec_type "
-        "-of default=noprint_wrappers=1:nokey=1 \"" +
-        m_mediaPath.string() + "\"";
+bool Engine::isolateVocals(const std::filesystem::path& outputAudioPath) const {
+    std::string key;
+    std::unique_ptr<ResultCache> resultCache = openResultCache(key);
+    if (!resultCache) {
+        return runAudioProcessor(outputAudioPath);
+    }
 
-    std::optional<std::string> output = Utils::runCommand(command, true);
-    if (!output || output->empty()) {
-        throw std::runtime_error("Failed to detect media type.");
+    if (resultCache->restore(key, outputAudioPath)) {
+        std::cout << "INFO: reusing cached result " << key << "." << std::endl;
+        return true;
     }
 
-    std::string_view result = *output;
-    if (result.find("video") != std::string_view::npos) {
-        return MediaType::Video;
-    } else if (result.find("audio") != std::string_view::npos) {
-        return MediaType::Audio;
-    } else {
-        throw std::runtime_error("Unsupported media type detected.");
+    // A previous output may be hard-linked to a cache entry, it must not be written in place
+    std::error_code error;
+    std::filesystem::remove(outputAudioPath, error);
+
+    if (!runAudioProcessor(outputAudioPath)) {
+        return false;
+    }
+    if (!resultCache->store(key, outputAudioPath)) {
+        std::cerr << "Warning: could not cache the result." << std::endl;
+    }
+    return true;
+}
+
+std::unique_ptr<ResultCache> Engine::openResultCache(std::string& key) const {
+    ConfigManager& configManager = ConfigManager::getInstance();
+    const std::filesystem::path cachePath = configManager.getResultCachePath();
+    if (cachePath.empty()) {
+        return nullptr;
+    }
+
+    // Any cache failure only costs the reuse, the job itself is processed regardless
+    try {
+        auto resultCache =
+            std::make_unique<ResultCache>(cachePath, configManager.getResultCacheMaxSize());
+        TRACE_SCOPE("result cache key");
+        key = ResultCache::computeKey(m_mediaInfo);
+        return resultCache;
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Warning: result cache disabled: " << ex.what() << std::endl;
+        return nullptr;
+    }
+}
+
+bool Engine::runAudioProcessor(const std::filesystem::path& outputAudioPath,
+                               const AudioProcessor::AudioSinkFactory& audioSinkFactory) const {
+    AudioProcessor audioProcessor(m_mediaInfo, outputAudioPath);
+    audioProcessor.setAudioSinkFactory(audioSinkFactory);
+    if (m_jobLease) {
+        const JobScheduler::Lease* jobLease = m_jobLease;
+        audioProcessor.setThreadPool(&jobLease->getThreadPool());
+        audioProcessor.setConcurrencyLimit([jobLease]() { return jobLease->getCoreShare(); });
+    }
+    audioProcessor.setWorkCoordinator(m_workCoordinator.get());
+    audioProcessor.setJobMetrics(m_jobMetrics.get());
+    return m_useStreamingMode ? audioProcessor.isolateVocalsStreaming()
+                              : audioProcessor.isolateVocals();
+}
+
+void Engine::connectWorkers() {
+    const std::vector<std::string> workers = ConfigManager::getInstance().getDistributedWorkers();
+    if (workers.empty()) {
+        return;
+    }
+
+    try {
+        std::vector<SocketUtils::Endpoint> endpoints;
+        for (const auto& worker : workers) {
+            endpoints.push_back(SocketUtils::parseEndpoint(worker, "localhost"));
+        }
+        m_workCoordinator = std::make_unique<WorkCoordinator>(endpoints);
+        std::cout << "INFO: filtering on " << workers.size() << " workers." << std::endl;
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Warning: " << ex.what() << " Filtering locally." << std::endl;
     }
 }
 
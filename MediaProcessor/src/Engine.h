@@ -2,10 +2,18 @@
 #define ENGINE_H
 
 #include <filesystem>
+#include <memory>
+#include <string>
+
+#include "AudioProcessor.h"
+#include "JobMetrics.h"
+#include "JobScheduler.h"
+#include "MediaInfo.h"
 
 namespace MediaProcessor {
 
-enum class MediaType { Audio, Video, Unsupported };
+class ResultCache;
+class WorkCoordinator;
 
 /**
  * @brief Media processing engine that supports audio and video files.
@@ -14,18 +22,59 @@ class Engine {
    public:
     explicit Engine(const std::filesystem::path& mediaPath);
 
+    /**
+     * @brief Processes a file the caller has probed already, `processMedia()` skips the probe.
+     */
+    explicit Engine(const MediaInfo& mediaInfo);
+    ~Engine();
+
+    /**
+     * @brief Forces constant-memory streaming mode regardless of the configuration.
+     */
+    void setStreamingMode(bool enabled);
+
+    /**
+     * @brief Filters audio on the pool and within the core share of a scheduled job, instead of
+     *        on a pool of its own.
+     *
+     * The lease must outlive `processMedia()`.
+     */
+    void setJobLease(const JobScheduler::Lease* jobLease);
+
     /**
      * @brief Processes a media file (audio or video) to isolate vocals.
      *
      * Processes the media file located at m_mediaPath.
-     * Processing pipeline is selected dynamically by determining media type.
+     * The file is probed once, unless it was probed before construction, and the processing
+     * pipeline is selected by its media type.
+     * "config.json" is loaded unless a configuration was loaded already. Work units are filtered
+     * by the `distributed_workers` if any of them is reachable, and skipped entirely if the
+     * result cache already holds the processed audio.
      *
      * @return true if processing was successful, false otherwise.
      */
     bool processMedia();
 
+    /**
+     * @brief Path of the processed media, empty until `processMedia()` succeeds.
+     */
+    const std::filesystem::path& getOutputPath() const;
+
+    /**
+     * @brief Real-time factors of the last `processMedia()` call, nullptr before the first one.
+     */
+    const JobMetrics* getJobMetrics() const;
+
    private:
     std::filesystem::path m_mediaPath;
+    std::filesystem::path m_outputPath;
+    MediaInfo m_mediaInfo;
+    bool m_isProbed = false;
+    const JobScheduler::Lease* m_jobLease = nullptr;
+    std::unique_ptr<WorkCoordinator> m_workCoordinator;
+    std::unique_ptr<JobMetrics> m_jobMetrics;
+    bool m_forceStreamingMode = false;
+    bool m_useStreamingMode = false;
 
     /**
      * @brief Processes an audio file.
@@ -37,18 +86,43 @@ class Engine {
     /**
      * @brief Processes a video file by extracting and isolating vocals and merges back to source.
      *
+     * The processed audio is muxed with the stream-copied video as it is merged, no intermediate
+     * audio file is written. A cached result is muxed straight from the cache.
+     *
      * @return true if processing was successful, false otherwise.
      */
     bool processVideo();
 
     /**
-     * @brief Detects the media type (audio or video) of the file located at m_mediaPath.
+     * @brief Isolates the vocals into `outputAudioPath`, reusing a cached result if there is one.
      *
-     * @return MediaType of the file.
+     * On a miss the audio processor runs in the selected (batch or streaming) mode, and its
+     * result is cached for the next job with the same audio and settings.
+     *
+     * @return true if processing was successful, false otherwise.
+     */
+    bool isolateVocals(const std::filesystem::path& outputAudioPath) const;
+
+    /**
+     * @brief Opens the result cache and computes the key of the input.
      *
-     * @throws std::runtime_error if detection fails.
+     * @return The cache, or nullptr if caching is disabled or failed.
+     */
+    std::unique_ptr<ResultCache> openResultCache(std::string& key) const;
+
+    /**
+     * @brief Runs the audio processor in the selected (batch or streaming) mode.
+     *
+     * @param audioSinkFactory Destination of the processed audio, `outputAudioPath` if empty.
+     * @return true if processing was successful, false otherwise.
+     */
+    bool runAudioProcessor(const std::filesystem::path& outputAudioPath,
+                           const AudioProcessor::AudioSinkFactory& audioSinkFactory = {}) const;
+
+    /**
+     * @brief Connects to the configured workers, keeps filtering local if none is reachable.
      */
-    MediaType getMediaType() const;
+    void connectWorkers();
 };
 
 }  // namespace MediaProcessor
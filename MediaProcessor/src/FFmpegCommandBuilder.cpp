@@ -63,6 +63,16 @@ FFmpegCommandBuilder& FFmpegCommandBuilder::addVideoCodec() {
 }
 
 std::string FFmpegCommandBuilder::build() const {
+    validate();
+    return CommandBuilder::build();
+}
+
+std::vector<std::string> FFmpegCommandBuilder::buildArgv() const {
+    validate();
+    return CommandBuilder::buildArgv();
+}
+
+void FFmpegCommandBuilder::validate() const {
     if (m_inputFile.empty()) {
         throw std::runtime_error("Input file path must be specified.");
     }
@@ -70,8 +80,6 @@ std::string FFmpegCommandBuilder::build() const {
     if (m_outputFile.empty()) {
         throw std::runtime_error("Output file path must be specified.");
     }
-
-    return CommandBuilder::build();
 }
 
 }  // namespace MediaProcessor
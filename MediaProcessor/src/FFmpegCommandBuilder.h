@@ -89,12 +89,21 @@ class FFmpegCommandBuilder : public CommandBuilder {
      */
     std::string build() const override;
 
+    /**
+     * @brief Constructs the argument vector from the added arguments and flags
+     *
+     * @throws std::runtime_error If input or output file path is missing
+     */
+    std::vector<std::string> buildArgv() const override;
+
    private:
     FFmpegSettingsManager& m_ffmpegSettings;
 
     fs::path m_ffmpegPath;
     fs::path m_inputFile;
     fs::path m_outputFile;
+
+    void validate() const;
 };
 
 }  // namespace MediaProcessor
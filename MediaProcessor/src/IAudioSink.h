@@ -0,0 +1,34 @@
+#ifndef IAUDIOSINK_H
+#define IAUDIOSINK_H
+
+#include <cstddef>
+#include <span>
+
+namespace MediaProcessor {
+
+/**
+ * @brief Interface for the destination of processed audio, written incrementally.
+ */
+class IAudioSink {
+   public:
+    virtual ~IAudioSink() = default;
+
+    /**
+     * @brief Appends frames given as one buffer per channel.
+     *
+     * @throws std::runtime_error if the number of buffers is wrong or the samples cannot be
+     *         written.
+     */
+    virtual void writePlanar(std::span<const float* const> channels, size_t numFrames) = 0;
+
+    /**
+     * @brief Finalizes the output once every frame has been written.
+     *
+     * @throws std::runtime_error if the output cannot be completed.
+     */
+    virtual void close() = 0;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // IAUDIOSINK_H
@@ -2,6 +2,7 @@
 #define ICOMMANDBUILDER_H
 
 #include <string>
+#include <vector>
 
 namespace MediaProcessor {
 
@@ -19,6 +20,15 @@ class ICommandBuilder {
      */
     virtual std::string build() const = 0;
 
+    /**
+     * @brief Constructs the command as an argument vector, for running it without a shell.
+     *
+     * Arguments are returned verbatim, without the quoting applied by `build()`.
+     *
+     * @return The program followed by its arguments.
+     */
+    virtual std::vector<std::string> buildArgv() const = 0;
+
     /**
      * @brief Adds an argument to the command.
      */
@@ -0,0 +1,181 @@
+#include "JobMetrics.h"
+
+#include <fmt/format.h>
+
+namespace MediaProcessor {
+
+namespace {
+
+using Counter = PerfCounters::Counter;
+
+double toSeconds(JobMetrics::Clock::rep ticks) {
+    return std::chrono::duration<double>(JobMetrics::Clock::duration(ticks)).count();
+}
+
+/**
+ * @brief Abbreviates large counts, e.g. 1234567 as "1.23M".
+ */
+std::string formatCount(uint64_t count) {
+    if (count >= 1'000'000'000) {
+        return fmt::format("{:.2f}G", count / 1e9);
+    }
+    if (count >= 1'000'000) {
+        return fmt::format("{:.2f}M", count / 1e6);
+    }
+    if (count >= 1'000) {
+        return fmt::format("{:.2f}k", count / 1e3);
+    }
+    return std::to_string(count);
+}
+
+}  // namespace
+
+JobMetrics::JobMetrics() : m_start(Clock::now()) {}
+
+void JobMetrics::add(Stage stage, Clock::duration duration) {
+    m_stageTicks[static_cast<size_t>(stage)].fetch_add(duration.count(),
+                                                       std::memory_order_relaxed);
+}
+
+void JobMetrics::addCounters(Stage stage, const PerfCounters::Values& counters) {
+    auto& stageCounters = m_stageCounters[static_cast<size_t>(stage)];
+    for (size_t i = 0; i < counters.size(); ++i) {
+        stageCounters[i].fetch_add(counters[i], std::memory_order_relaxed);
+    }
+    m_hasCounters.store(true, std::memory_order_relaxed);
+}
+
+void JobMetrics::setAudioDuration(double seconds) {
+    m_audioDuration.store(seconds, std::memory_order_relaxed);
+}
+
+double JobMetrics::getAudioDuration() const {
+    return m_audioDuration.load(std::memory_order_relaxed);
+}
+
+double JobMetrics::getStageSeconds(Stage stage) const {
+    return toSeconds(m_stageTicks[static_cast<size_t>(stage)].load(std::memory_order_relaxed));
+}
+
+uint64_t JobMetrics::getStageCounter(Stage stage, PerfCounters::Counter counter) const {
+    return m_stageCounters[static_cast<size_t>(stage)][static_cast<size_t>(counter)].load(
+        std::memory_order_relaxed);
+}
+
+void JobMetrics::finish() {
+    Clock::rep expected = 0;
+    m_wallTicks.compare_exchange_strong(expected, (Clock::now() - m_start).count());
+}
+
+double JobMetrics::getWallSeconds() const {
+    Clock::rep wallTicks = m_wallTicks.load();
+    return toSeconds(wallTicks ? wallTicks : (Clock::now() - m_start).count());
+}
+
+double JobMetrics::getRealTimeFactor() const {
+    const double audioDuration = getAudioDuration();
+    return audioDuration > 0.0 ? getWallSeconds() / audioDuration : 0.0;
+}
+
+double JobMetrics::getRealTimeFactor(Stage stage) const {
+    const double audioDuration = getAudioDuration();
+    return audioDuration > 0.0 ? getStageSeconds(stage) / audioDuration : 0.0;
+}
+
+std::string JobMetrics::formatReport() const {
+    std::string report = fmt::format("RTF {:.3f} ({:.1f}s for {:.1f}s of audio):",
+                                     getRealTimeFactor(), getWallSeconds(), getAudioDuration());
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Stage stage = static_cast<Stage>(i);
+        report += fmt::format("{} {} {:.3f}", i == 0 ? "" : ",", getStageName(stage),
+                              getRealTimeFactor(stage));
+    }
+
+    if (!m_hasCounters.load(std::memory_order_relaxed)) {
+        return report;
+    }
+
+    const PerfCounters& perfCounters = PerfCounters::getInstance();
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Stage stage = static_cast<Stage>(i);
+        if (getStageSeconds(stage) == 0.0) {
+            continue;  // not part of this job, e.g. muxing for audio files
+        }
+
+        const uint64_t cycles = getStageCounter(stage, Counter::Cycles);
+        const uint64_t instructions = getStageCounter(stage, Counter::Instructions);
+
+        std::string line;
+        if (perfCounters.isAvailable(Counter::Cycles)) {
+            line += fmt::format(", {} cycles", formatCount(cycles));
+        }
+        if (perfCounters.isAvailable(Counter::Instructions)) {
+            line += fmt::format(", {} instructions", formatCount(instructions));
+            if (perfCounters.isAvailable(Counter::Cycles) && cycles > 0) {
+                line += fmt::format(" (IPC {:.2f})", static_cast<double>(instructions) / cycles);
+            }
+        }
+        if (perfCounters.isAvailable(Counter::CacheMisses)) {
+            line += fmt::format(", {} cache misses",
+                                formatCount(getStageCounter(stage, Counter::CacheMisses)));
+        }
+        if (perfCounters.isAvailable(Counter::ContextSwitches)) {
+            line += fmt::format(", {} context switches",
+                                formatCount(getStageCounter(stage, Counter::ContextSwitches)));
+        }
+        if (!line.empty()) {
+            report += fmt::format("\n  {}: {}", getStageName(stage), line.substr(2));
+        }
+    }
+    return report;
+}
+
+nlohmann::json JobMetrics::toJson() const {
+    nlohmann::json stages;
+    for (size_t i = 0; i < STAGE_COUNT; ++i) {
+        const Stage stage = static_cast<Stage>(i);
+        stages[getStageName(stage)] = getRealTimeFactor(stage);
+    }
+    nlohmann::json json = {{"rtf", getRealTimeFactor()},
+                           {"wall_seconds", getWallSeconds()},
+                           {"audio_seconds", getAudioDuration()},
+                           {"stage_rtf", std::move(stages)}};
+
+    if (m_hasCounters.load(std::memory_order_relaxed)) {
+        const PerfCounters& perfCounters = PerfCounters::getInstance();
+        nlohmann::json counters;
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            const Stage stage = static_cast<Stage>(i);
+            nlohmann::json stageCounters = nlohmann::json::object();
+            for (size_t j = 0; j < PerfCounters::COUNTER_COUNT; ++j) {
+                const Counter counter = static_cast<Counter>(j);
+                if (perfCounters.isAvailable(counter)) {
+                    stageCounters[PerfCounters::getCounterName(counter)] =
+                        getStageCounter(stage, counter);
+                }
+            }
+            counters[getStageName(stage)] = std::move(stageCounters);
+        }
+        json["counters"] = std::move(counters);
+    }
+    return json;
+}
+
+const char* JobMetrics::getStageName(Stage stage) {
+    switch (stage) {
+        case Stage::Probe:
+            return "probe";
+        case Stage::Decode:
+            return "decode";
+        case Stage::Filter:
+            return "filter";
+        case Stage::Merge:
+            return "merge";
+        case Stage::Mux:
+            return "mux";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace MediaProcessor
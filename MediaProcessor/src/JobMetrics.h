@@ -0,0 +1,133 @@
+#ifndef JOBMETRICS_H
+#define JOBMETRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "PerfCounters.h"
+
+namespace MediaProcessor {
+
+/**
+ * @brief Time a job spends per stage, reported as real-time factors.
+ *
+ * The real-time factor (RTF) is processing seconds per second of audio, below 1 is faster than
+ * real time. Stages running on several threads at once (filtering) accumulate the busy time of
+ * all threads, so their RTF is in core-seconds and can exceed the job's wall-clock RTF.
+ * Stages are recorded lock-free, so timing costs a clock read on either side of a stage.
+ *
+ * While `PerfCounters` are enabled, stages also accumulate the calling thread's hardware counter
+ * deltas, which tells compute-bound stages (high IPC) from memory-bound ones (many cache misses).
+ */
+class JobMetrics {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage { Probe, Decode, Filter, Merge, Mux, Count };
+
+    /**
+     * @brief Adds the lifetime of a scope, and its counters, to a stage; does nothing without
+     * metrics.
+     */
+    class ScopedTimer {
+       public:
+        ScopedTimer(JobMetrics* metrics, Stage stage)
+            : m_metrics(metrics),
+              m_stage(stage),
+              m_countCounters(metrics && PerfCounters::getInstance().isEnabled()) {
+            if (m_countCounters) {
+                m_startCounters = PerfCounters::getInstance().readThread();
+            }
+            if (m_metrics) {
+                m_start = Clock::now();
+            }
+        }
+
+        ~ScopedTimer() {
+            if (m_metrics) {
+                m_metrics->add(m_stage, Clock::now() - m_start);
+            }
+            if (m_countCounters) {
+                PerfCounters::Values counters = PerfCounters::getInstance().readThread();
+                for (size_t i = 0; i < counters.size(); ++i) {
+                    counters[i] -= std::min(counters[i], m_startCounters[i]);
+                }
+                m_metrics->addCounters(m_stage, counters);
+            }
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+       private:
+        JobMetrics* m_metrics;
+        Stage m_stage;
+        bool m_countCounters;
+        PerfCounters::Values m_startCounters{};
+        Clock::time_point m_start;
+    };
+
+    /**
+     * @brief Starts the job's wall clock.
+     */
+    JobMetrics();
+
+    void add(Stage stage, Clock::duration duration);
+    void addCounters(Stage stage, const PerfCounters::Values& counters);
+
+    /**
+     * @brief Sets the duration of the job's audio; the decoded length overrides the probed one.
+     */
+    void setAudioDuration(double seconds);
+
+    double getAudioDuration() const;
+    double getStageSeconds(Stage stage) const;
+    uint64_t getStageCounter(Stage stage, PerfCounters::Counter counter) const;
+
+    /**
+     * @brief Stops the job's wall clock. Later calls have no effect.
+     */
+    void finish();
+
+    double getWallSeconds() const;
+
+    /**
+     * @brief RTF of the whole job, or of a single stage; 0 while the audio duration is unknown.
+     */
+    double getRealTimeFactor() const;
+    double getRealTimeFactor(Stage stage) const;
+
+    /**
+     * @brief Summary line, e.g. "RTF 0.120 (12.0s for 100.0s of audio): probe 0.001, ...",
+     * followed by a line per stage with counter totals if any were recorded.
+     */
+    std::string formatReport() const;
+
+    /**
+     * @brief Overall and per-stage RTF as a JSON object, keyed by lowercase stage name, plus the
+     * per-stage totals of the available counters under "counters" if any were recorded.
+     */
+    nlohmann::json toJson() const;
+
+    static const char* getStageName(Stage stage);
+
+   private:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(Stage::Count);
+
+    Clock::time_point m_start;
+    std::atomic<Clock::rep> m_wallTicks = 0;  // 0 until finished
+    std::atomic<double> m_audioDuration = 0.0;
+    std::array<std::atomic<Clock::rep>, STAGE_COUNT> m_stageTicks{};
+    std::array<std::array<std::atomic<uint64_t>, PerfCounters::COUNTER_COUNT>, STAGE_COUNT>
+        m_stageCounters{};
+    std::atomic<bool> m_hasCounters = false;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // JOBMETRICS_H
@@ -0,0 +1,153 @@
+#include "JobScheduler.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MediaProcessor {
+
+namespace {
+
+unsigned int getShareWeight(JobPriority priority) {
+    return priority == JobPriority::Interactive ? INTERACTIVE_SHARE_WEIGHT : 1;
+}
+
+/**
+ * @brief Lowers the scheduling priority of the calling thread, best effort.
+ */
+void lowerThreadPriority(int niceness) {
+#if defined(__linux__)
+    // Linux applies nice values per thread
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), niceness);
+#elif defined(__APPLE__)
+    (void)niceness;
+    setpriority(PRIO_DARWIN_THREAD, 0, PRIO_DARWIN_BG);
+#else
+    (void)niceness;
+#endif
+}
+
+}  // namespace
+
+JobScheduler::Lease::Lease(JobScheduler& scheduler, std::list<Job>::iterator job)
+    : m_scheduler(&scheduler), m_job(job) {}
+
+JobScheduler::Lease::Lease(Lease&& other) noexcept
+    : m_scheduler(std::exchange(other.m_scheduler, nullptr)), m_job(other.m_job) {}
+
+JobScheduler::Lease::~Lease() {
+    if (m_scheduler) {
+        m_scheduler->release(m_job);
+    }
+}
+
+ThreadPool& JobScheduler::Lease::getThreadPool() const {
+    return m_job->priority == JobPriority::Interactive ? m_scheduler->m_interactivePool
+                                                       : m_scheduler->m_batchPool;
+}
+
+size_t JobScheduler::Lease::getCoreShare() const {
+    return m_job->coreShare.load(std::memory_order_relaxed);
+}
+
+JobScheduler::JobScheduler(unsigned int numThreads, double latencySlo, int batchNiceness)
+    : m_numThreads(std::max(numThreads, 1u)),
+      m_latencySlo(latencySlo),
+      m_interactivePool(m_numThreads),
+      m_batchPool(m_numThreads, [batchNiceness]() {
+          if (batchNiceness > 0) {
+              lowerThreadPriority(batchNiceness);
+          }
+      }) {}
+
+std::optional<JobScheduler::Lease> JobScheduler::admit(JobPriority priority,
+                                                      double mediaDuration) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const double estimatedCost = mediaDuration * m_costPerMediaSecond;
+
+    // Whether the given work and this job would complete within the SLO
+    auto fitsWithin = [&](std::optional<JobPriority> workAhead) {
+        return m_latencySlo <= 0.0 || m_jobs.empty() ||
+               (getRemainingCost(workAhead) + estimatedCost) / m_numThreads <= m_latencySlo;
+    };
+
+    if (priority == JobPriority::Interactive) {
+        if (!fitsWithin(JobPriority::Interactive)) {
+            return std::nullopt;
+        }
+    } else {
+        m_jobFinished.wait(lock, [&]() { return fitsWithin(std::nullopt); });
+    }
+
+    auto job = m_jobs.emplace(m_jobs.end());
+    job->priority = priority;
+    job->mediaDuration = mediaDuration;
+    job->estimatedCost = estimatedCost;
+    job->lastUpdate = Clock::now();
+    updateShares();
+
+    return Lease(*this, job);
+}
+
+double JobScheduler::getEstimatedBacklog() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getRemainingCost(std::nullopt) / m_numThreads;
+}
+
+void JobScheduler::release(std::list<Job>::iterator job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        updateShares();
+
+        // The cost of the next jobs is estimated from the ones that completed
+        if (job->mediaDuration > 0.0) {
+            const double measuredCost = job->consumedCost / job->mediaDuration;
+            m_costPerMediaSecond = (1.0 - COST_ESTIMATE_SMOOTHING) * m_costPerMediaSecond +
+                                   COST_ESTIMATE_SMOOTHING * measuredCost;
+        }
+
+        m_jobs.erase(job);
+        updateShares();
+    }
+    m_jobFinished.notify_all();
+}
+
+void JobScheduler::updateShares() {
+    // A job is accounted for its whole share, whether or not it kept every core busy
+    const Clock::time_point now = Clock::now();
+    unsigned int totalWeight = 0;
+    for (Job& job : m_jobs) {
+        const std::chrono::duration<double> elapsed = now - job.lastUpdate;
+        job.consumedCost += job.coreShare.load(std::memory_order_relaxed) * elapsed.count();
+        job.lastUpdate = now;
+        totalWeight += getShareWeight(job.priority);
+    }
+
+    for (Job& job : m_jobs) {
+        size_t share = m_numThreads * getShareWeight(job.priority) / totalWeight;
+        job.coreShare.store(std::max<size_t>(share, 1), std::memory_order_relaxed);
+    }
+}
+
+double JobScheduler::getRemainingCost(std::optional<JobPriority> priority) const {
+    const Clock::time_point now = Clock::now();
+    double remainingCost = 0.0;
+    for (const Job& job : m_jobs) {
+        if (priority && job.priority != *priority) {
+            continue;
+        }
+        const std::chrono::duration<double> elapsed = now - job.lastUpdate;
+        const double consumedCost =
+            job.consumedCost + job.coreShare.load(std::memory_order_relaxed) * elapsed.count();
+        remainingCost += std::max(job.estimatedCost - consumedCost, 0.0);
+    }
+    return remainingCost;
+}
+
+}  // namespace MediaProcessor
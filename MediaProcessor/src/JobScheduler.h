@@ -0,0 +1,138 @@
+#ifndef JOBSCHEDULER_H
+#define JOBSCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <optional>
+
+#include "ThreadPool.h"
+
+namespace MediaProcessor {
+
+enum class JobPriority { Interactive, Batch };
+
+// Relative core share of an interactive job compared to a batch job
+constexpr unsigned int INTERACTIVE_SHARE_WEIGHT = 4;
+
+// Core-seconds needed per second of media until completed jobs provide a measurement
+constexpr double DEFAULT_COST_PER_MEDIA_SECOND = 0.25;
+
+// Weight of the latest completed job in the running cost estimate
+constexpr double COST_ESTIMATE_SMOOTHING = 0.2;
+
+/**
+ * @brief Process-wide scheduler sharing the cores between concurrently running jobs.
+ *
+ * Every active job gets a core share, the number of its work units allowed to be filtered at
+ * once. Shares are weighted by priority and recomputed whenever a job starts or finishes, so
+ * concurrent jobs together use about `numThreads` cores instead of each sizing itself to the
+ * whole machine.
+ *
+ * Interactive and batch jobs run on separate pools. Batch workers run at a lower OS priority,
+ * so interactive jobs stay responsive even when the shares oversubscribe the machine.
+ *
+ * Admission control compares the estimated backlog against a latency SLO. The cost of a job is
+ * estimated from its media duration and the cost per media second measured on completed jobs:
+ *   - an interactive job is rejected if the interactive work ahead of it and its own cost would
+ *     not complete within the SLO,
+ *   - a batch job waits until the whole backlog fits within the SLO.
+ * A job is always admitted when no other job is running.
+ */
+class JobScheduler {
+   private:
+    struct Job;
+
+   public:
+    /**
+     * @brief Admission of a job, which stays active until the lease is destroyed.
+     */
+    class Lease {
+       public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease();
+
+        /**
+         * @brief Pool the job's work units run on.
+         */
+        ThreadPool& getThreadPool() const;
+
+        /**
+         * @brief Number of work units the job may have filtered at once, changes over time.
+         */
+        size_t getCoreShare() const;
+
+       private:
+        friend class JobScheduler;
+        Lease(JobScheduler& scheduler, std::list<Job>::iterator job);
+
+        JobScheduler* m_scheduler;
+        std::list<Job>::iterator m_job;
+    };
+
+    /**
+     * @param latencySlo Seconds an interactive job may take from submission to completion, 0
+     *        disables admission control.
+     * @param batchNiceness Nice value of the batch workers, 0 leaves their priority unchanged.
+     */
+    JobScheduler(unsigned int numThreads, double latencySlo, int batchNiceness);
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    /**
+     * @brief Admits a job, waiting while a batch job does not fit within the SLO.
+     *
+     * @param mediaDuration Duration of the job's media in seconds, 0 if unknown.
+     *
+     * @return The job's lease, or std::nullopt if an interactive job is rejected.
+     */
+    std::optional<Lease> admit(JobPriority priority, double mediaDuration);
+
+    /**
+     * @brief Estimated seconds until the admitted jobs are completed.
+     */
+    double getEstimatedBacklog() const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Job {
+        JobPriority priority;
+        double mediaDuration;
+        double estimatedCost;  // core-seconds
+        double consumedCost = 0.0;
+        Clock::time_point lastUpdate;
+        std::atomic<size_t> coreShare{1};
+    };
+
+    unsigned int m_numThreads;
+    double m_latencySlo;
+    double m_costPerMediaSecond = DEFAULT_COST_PER_MEDIA_SECOND;
+
+    ThreadPool m_interactivePool;
+    ThreadPool m_batchPool;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_jobFinished;
+    std::list<Job> m_jobs;
+
+    void release(std::list<Job>::iterator job);
+
+    /**
+     * @brief Accounts the cores used so far and redistributes them over the active jobs.
+     */
+    void updateShares();
+
+    /**
+     * @brief Remaining core-seconds of the active jobs of the given priority, or all of them.
+     */
+    double getRemainingCost(std::optional<JobPriority> priority) const;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // JOBSCHEDULER_H
@@ -0,0 +1,241 @@
+#include "JobServer.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include "Engine.h"
+#include "MediaInfo.h"
+#include "SocketUtils.h"
+
+namespace MediaProcessor {
+
+namespace {
+
+nlohmann::json failure(const std::string& message) {
+    return {{"status", "failed"}, {"message", message}};
+}
+
+/**
+ * @brief Removes a socket file left behind by a server that is no longer running.
+ *
+ * @throws std::runtime_error if the path is taken by another file or a running server.
+ */
+void removeStaleSocket(const sockaddr_un& address) {
+    struct stat status;
+    if (lstat(address.sun_path, &status) < 0) {
+        return;  // nothing to replace, bind() reports any other problem
+    }
+    if (!S_ISSOCK(status.st_mode)) {
+        throw std::runtime_error(std::string(address.sun_path) + " exists and is not a socket.");
+    }
+
+    int probeFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probeFd < 0) {
+        throw std::runtime_error("Could not create socket: " + std::string(strerror(errno)));
+    }
+    const bool isListening =
+        connect(probeFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    close(probeFd);
+    if (isListening) {
+        throw std::runtime_error("Another server is listening on " +
+                                 std::string(address.sun_path) + ".");
+    }
+    unlink(address.sun_path);
+}
+
+}  // namespace
+
+fs::path getDefaultSocketPath() {
+    const char* runtimeDirectory = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDirectory && *runtimeDirectory) {
+        return fs::path(runtimeDirectory) / "MediaProcessor.sock";
+    }
+    return "/tmp/MediaProcessor.sock";
+}
+
+JobServer::JobServer(const fs::path& socketPath, unsigned int numThreads, double latencySlo,
+                     int batchNiceness)
+    : m_socketPath(socketPath), m_scheduler(numThreads, latencySlo, batchNiceness) {}
+
+JobServer::~JobServer() {
+    stop();
+}
+
+void JobServer::run() {
+    const int listenFd = bindSocket();
+    m_listenFd = listenFd;
+    std::cout << "INFO: serving jobs on " << m_socketPath << std::endl;
+
+    while (!m_stopping) {
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (!m_stopping) {
+                std::cerr << "Error: Failed to accept connection: " << strerror(errno)
+                          << std::endl;
+            }
+            break;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            m_clientFds.insert(clientFd);
+        }
+
+        std::thread([this, clientFd]() {
+            handleConnection(clientFd);
+
+            // Notify under the lock, `run()` may return as soon as the last connection is gone
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            close(clientFd);
+            m_clientFds.erase(clientFd);
+            m_connectionsDone.notify_all();
+        }).detach();
+    }
+
+    // Idle connections see end of stream, busy ones finish their current job first
+    std::unique_lock<std::mutex> lock(m_connectionsMutex);
+    for (int clientFd : m_clientFds) {
+        shutdown(clientFd, SHUT_RD);
+    }
+    m_connectionsDone.wait(lock, [this]() { return m_clientFds.empty(); });
+
+    m_listenFd = -1;
+    close(listenFd);
+    fs::remove(m_socketPath);
+}
+
+void JobServer::stop() {
+    m_stopping = true;
+
+    // Unblocks accept() in `run()`
+    int listenFd = m_listenFd;
+    if (listenFd >= 0) {
+        shutdown(listenFd, SHUT_RDWR);
+    }
+}
+
+int JobServer::bindSocket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const std::string path = m_socketPath.string();
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path is too long: " + path);
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    // A socket file left behind by a previous instance would make bind() fail
+    removeStaleSocket(address);
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("Could not create socket: " + std::string(strerror(errno)));
+    }
+
+    const bool isBound =
+        bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+
+    // Restricted before listen(), connections are refused until then
+    if (!isBound || chmod(address.sun_path, S_IRUSR | S_IWUSR) < 0 ||
+        listen(listenFd, SOMAXCONN) < 0) {
+        std::string error = strerror(errno);
+        close(listenFd);
+        if (isBound) {
+            unlink(address.sun_path);
+        }
+        throw std::runtime_error("Could not listen on " + path + ": " + error);
+    }
+
+    return listenFd;
+}
+
+void JobServer::handleConnection(int clientFd) {
+    while (auto message = SocketUtils::readMessage(clientFd)) {
+        nlohmann::json reply;
+        try {
+            reply = handleRequest(nlohmann::json::parse(*message), clientFd);
+        } catch (const nlohmann::json::exception& ex) {
+            reply = failure("Invalid request: " + std::string(ex.what()));
+        }
+
+        if (!SocketUtils::writeMessage(clientFd, reply.dump())) {
+            return;
+        }
+    }
+}
+
+nlohmann::json JobServer::handleRequest(const nlohmann::json& request, int clientFd) {
+    const std::string command = request.value("command", "");
+
+    if (command == "process") {
+        return processMedia(request, clientFd);
+    }
+    if (command == "ping") {
+        return {{"status", "ok"}};
+    }
+    if (command == "shutdown") {
+        stop();
+        return {{"status", "ok"}};
+    }
+    return failure("Unknown command '" + command + "'.");
+}
+
+nlohmann::json JobServer::processMedia(const nlohmann::json& request, int clientFd) {
+    if (!request.contains("path") || !request["path"].is_string()) {
+        return failure("Missing 'path'.");
+    }
+
+    const std::string priorityName = request.value("priority", "interactive");
+    if (priorityName != "interactive" && priorityName != "batch") {
+        return failure("Unknown priority '" + priorityName + "'.");
+    }
+    const JobPriority priority =
+        priorityName == "batch" ? JobPriority::Batch : JobPriority::Interactive;
+
+    // Probed once for admission, the engine reuses the result
+    MediaInfo mediaInfo;
+    try {
+        mediaInfo = MediaInfo::probe(request["path"].get<std::string>());
+    } catch (const std::exception& ex) {
+        return failure(ex.what());
+    }
+
+    std::optional<JobScheduler::Lease> jobLease = m_scheduler.admit(priority, mediaInfo.duration);
+    if (!jobLease) {
+        return {{"status", "rejected"},
+                {"message", "Estimated backlog of " +
+                                std::to_string(m_scheduler.getEstimatedBacklog()) +
+                                " seconds exceeds the latency SLO."}};
+    }
+
+    Engine engine(mediaInfo);
+    engine.setStreamingMode(request.value("streaming", false));
+    engine.setJobLease(&*jobLease);
+
+    SocketUtils::writeMessage(clientFd, nlohmann::json({{"status", "accepted"}}).dump());
+
+    try {
+        if (!engine.processMedia()) {
+            return failure("Media processing failed.");
+        }
+    } catch (const std::exception& ex) {
+        return failure(ex.what());
+    }
+
+    return {{"status", "completed"},
+            {"output_path", engine.getOutputPath().string()},
+            {"metrics", engine.getJobMetrics()->toJson()}};
+}
+
+}  // namespace MediaProcessor
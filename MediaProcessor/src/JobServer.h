@@ -0,0 +1,90 @@
+#ifndef JOBSERVER_H
+#define JOBSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <set>
+
+#include "JobScheduler.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief `MediaProcessor.sock` in the user's private `$XDG_RUNTIME_DIR`, or in `/tmp` if unset.
+ */
+fs::path getDefaultSocketPath();
+
+/**
+ * @brief Serves processing jobs over a Unix domain socket from a long-running process.
+ *
+ * The configuration, the scheduler's thread pools and warmed DeepFilterNet states stay resident
+ * between jobs, so a job only pays for its own processing. Messages are JSON objects framed by
+ * `SocketUtils::writeMessage()`, and a connection may send any number of requests:
+ *
+ *   {"command": "process", "path": "<media file>", "streaming": false,
+ *    "priority": "interactive" | "batch"}
+ *       -> {"status": "accepted"}, then {"status": "completed", "output_path": "<path>",
+ *          "metrics": <JobMetrics::toJson()>}
+ *          or {"status": "failed", "message": "<reason>"}
+ *       -> {"status": "rejected", "message": "<reason>"} if the server is too busy
+ *   {"command": "ping"}     -> {"status": "ok"}
+ *   {"command": "shutdown"} -> {"status": "ok"}, then the server stops
+ *
+ * Jobs from different connections run concurrently and share the cores through a
+ * `JobScheduler`. Interactive jobs (the default) are rejected when they would miss the latency
+ * SLO, batch jobs wait until the backlog allows them in.
+ */
+class JobServer {
+   public:
+    /**
+     * @param latencySlo Passed on to the `JobScheduler`, 0 disables admission control.
+     * @param batchNiceness Nice value of the workers running batch jobs.
+     */
+    JobServer(const fs::path& socketPath, unsigned int numThreads, double latencySlo,
+              int batchNiceness);
+    ~JobServer();
+
+    JobServer(const JobServer&) = delete;
+    JobServer& operator=(const JobServer&) = delete;
+
+    /**
+     * @brief Binds the socket and serves connections until `stop()` is called.
+     *
+     * The socket is only accessible to the user running the server. A socket file nobody is
+     * listening on is replaced, any other file at the socket path is left alone.
+     * Returns once running jobs have finished and the socket file is removed.
+     *
+     * @throws std::runtime_error if the socket cannot be bound.
+     */
+    void run();
+
+    /**
+     * @brief Stops accepting connections. Async-signal-safe.
+     */
+    void stop();
+
+   private:
+    fs::path m_socketPath;
+    JobScheduler m_scheduler;
+
+    std::atomic<int> m_listenFd{-1};
+    std::atomic<bool> m_stopping{false};
+
+    std::mutex m_connectionsMutex;
+    std::condition_variable m_connectionsDone;
+    std::set<int> m_clientFds;
+
+    int bindSocket();
+    void handleConnection(int clientFd);
+    nlohmann::json handleRequest(const nlohmann::json& request, int clientFd);
+    nlohmann::json processMedia(const nlohmann::json& request, int clientFd);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // JOBSERVER_H
@@ -0,0 +1,109 @@
+#include "MediaInfo.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/avutil.h>
+}
+
+namespace MediaProcessor {
+
+namespace {
+
+std::string codecTypeToString(AVMediaType type) {
+    switch (type) {
+        case AVMEDIA_TYPE_AUDIO:
+            return "audio";
+        case AVMEDIA_TYPE_VIDEO:
+            return "video";
+        case AVMEDIA_TYPE_SUBTITLE:
+            return "subtitle";
+        case AVMEDIA_TYPE_DATA:
+            return "data";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace
+
+bool MediaInfo::hasAudio() const {
+    return audioStreamIndex >= 0;
+}
+
+bool MediaInfo::hasVideo() const {
+    return videoStreamIndex >= 0;
+}
+
+const StreamInfo* MediaInfo::getAudioStream() const {
+    auto it = std::find_if(streams.begin(), streams.end(),
+                           [this](const StreamInfo& s) { return s.index == audioStreamIndex; });
+    return (it != streams.end()) ? &*it : nullptr;
+}
+
+MediaType MediaInfo::getMediaType() const {
+    if (hasVideo()) {
+        return MediaType::Video;
+    }
+    if (hasAudio()) {
+        return MediaType::Audio;
+    }
+    return MediaType::Unsupported;
+}
+
+MediaInfo MediaInfo::probe(const fs::path& mediaPath) {
+    AVFormatContext* formatContext = nullptr;
+    if (avformat_open_input(&formatContext, mediaPath.c_str(), nullptr, nullptr) < 0) {
+        throw std::runtime_error("Failed to open media file: " + mediaPath.string());
+    }
+
+    if (avformat_find_stream_info(formatContext, nullptr) < 0) {
+        avformat_close_input(&formatContext);
+        throw std::runtime_error("Failed to read stream info: " + mediaPath.string());
+    }
+
+    MediaInfo info;
+    info.path = mediaPath;
+
+    for (unsigned int i = 0; i < formatContext->nb_streams; ++i) {
+        const AVStream* stream = formatContext->streams[i];
+        const AVCodecParameters* codecpar = stream->codecpar;
+
+        StreamInfo streamInfo;
+        streamInfo.index = stream->index;
+        streamInfo.codecType = codecTypeToString(codecpar->codec_type);
+        streamInfo.codecName = avcodec_get_name(codecpar->codec_id);
+        streamInfo.isAttachedPicture = (stream->disposition & AV_DISPOSITION_ATTACHED_PIC) != 0;
+        if (codecpar->codec_type == AVMEDIA_TYPE_AUDIO) {
+            streamInfo.sampleRate = codecpar->sample_rate;
+            streamInfo.channels = codecpar->ch_layout.nb_channels;
+        }
+
+        // Fall back to the longest stream if the container carries no duration
+        if (formatContext->duration == AV_NOPTS_VALUE && stream->duration != AV_NOPTS_VALUE) {
+            info.duration = std::max(info.duration, stream->duration * av_q2d(stream->time_base));
+        }
+
+        info.streams.push_back(std::move(streamInfo));
+    }
+
+    if (formatContext->duration != AV_NOPTS_VALUE) {
+        info.duration = static_cast<double>(formatContext->duration) / AV_TIME_BASE;
+    }
+
+    int audioIndex = av_find_best_stream(formatContext, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+    info.audioStreamIndex = (audioIndex >= 0) ? audioIndex : -1;
+
+    int videoIndex = av_find_best_stream(formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (videoIndex >= 0 && !info.streams[videoIndex].isAttachedPicture) {
+        info.videoStreamIndex = videoIndex;
+    }
+
+    avformat_close_input(&formatContext);
+    return info;
+}
+
+}  // namespace MediaProcessor
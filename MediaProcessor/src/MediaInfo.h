@@ -0,0 +1,61 @@
+#ifndef MEDIAINFO_H
+#define MEDIAINFO_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+enum class MediaType { Audio, Video, Unsupported };
+
+/**
+ * @brief Describes a single stream of a media container.
+ */
+struct StreamInfo {
+    int index = -1;
+    std::string codecType;  // "audio", "video", "subtitle", ...
+    std::string codecName;
+    int sampleRate = 0;  // audio streams only
+    int channels = 0;    // audio streams only
+    bool isAttachedPicture = false;
+};
+
+/**
+ * @brief Stream layout and properties of a media file, gathered by a single in-process probe.
+ *
+ * Probed once per job and passed along to the processors, replacing repeated ffprobe calls.
+ */
+struct MediaInfo {
+    fs::path path;
+    double duration = 0.0;  // seconds, 0 if unknown
+    std::vector<StreamInfo> streams;
+    int audioStreamIndex = -1;  // best audio stream, -1 if there is none
+    int videoStreamIndex = -1;  // best video stream excluding cover art, -1 if there is none
+
+    bool hasAudio() const;
+    bool hasVideo() const;
+
+    /**
+     * @brief Returns the best audio stream, or nullptr if there is none.
+     */
+    const StreamInfo* getAudioStream() const;
+
+    /**
+     * @brief Classifies the media by its streams; cover art alone doesn't make a file a video.
+     */
+    MediaType getMediaType() const;
+
+    /**
+     * @brief Opens the container once and collects its stream information.
+     *
+     * @throws std::runtime_error if the file cannot be opened or probed.
+     */
+    static MediaInfo probe(const fs::path& mediaPath);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // MEDIAINFO_H
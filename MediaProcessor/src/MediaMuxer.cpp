@@ -0,0 +1,336 @@
+#include "MediaMuxer.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/error.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace MediaProcessor {
+
+namespace {
+
+// AAC bit rate per channel, transparent for speech at the default encoder settings
+constexpr int64_t AAC_BIT_RATE_PER_CHANNEL = 96000;
+
+// Frame size used when the encoder accepts any
+constexpr int DEFAULT_FRAME_SIZE = 1024;
+
+std::string avErrorToString(int errorCode) {
+    char buffer[AV_ERROR_MAX_STRING_SIZE] = {0};
+    av_strerror(errorCode, buffer, sizeof(buffer));
+    return buffer;
+}
+
+/**
+ * @brief Moves `packet` into `stream` of `outputContext`, rescaling it from `timeBase`.
+ */
+void writePacket(AVFormatContext* outputContext, AVPacket* packet, AVRational timeBase,
+                 const AVStream* stream) {
+    packet->stream_index = stream->index;
+    packet->pos = -1;
+    av_packet_rescale_ts(packet, timeBase, stream->time_base);
+
+    int ret = av_interleaved_write_frame(outputContext, packet);
+    if (ret < 0) {
+        throw std::runtime_error("Could not write packet: " + avErrorToString(ret));
+    }
+}
+
+}  // namespace
+
+MediaMuxer::MediaMuxer(const MediaInfo& videoInfo, const fs::path& outputPath, int sampleRate,
+                       int channels)
+    : m_inputVideoIndex(videoInfo.videoStreamIndex), m_channels(static_cast<size_t>(channels)) {
+    try {
+        openInput(videoInfo);
+        openOutput(outputPath, sampleRate, channels);
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+MediaMuxer::~MediaMuxer() {
+    release();
+}
+
+void MediaMuxer::openInput(const MediaInfo& videoInfo) {
+    if (!videoInfo.hasVideo()) {
+        throw std::runtime_error("No video stream found in " + videoInfo.path.string());
+    }
+
+    int ret = avformat_open_input(&m_inputContext, videoInfo.path.c_str(), nullptr, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not open " + videoInfo.path.string() + ": " +
+                                 avErrorToString(ret));
+    }
+
+    ret = avformat_find_stream_info(m_inputContext, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not read stream info: " + avErrorToString(ret));
+    }
+
+    if (m_inputVideoIndex < 0 ||
+        static_cast<unsigned int>(m_inputVideoIndex) >= m_inputContext->nb_streams) {
+        throw std::runtime_error("Invalid video stream index " +
+                                 std::to_string(m_inputVideoIndex) + ".");
+    }
+
+    // Only the video is read, the demuxer skips the packets of the other streams
+    for (unsigned int i = 0; i < m_inputContext->nb_streams; ++i) {
+        if (static_cast<int>(i) != m_inputVideoIndex) {
+            m_inputContext->streams[i]->discard = AVDISCARD_ALL;
+        }
+    }
+
+    const AVStream* video = m_inputContext->streams[m_inputVideoIndex];
+    if (video->start_time != AV_NOPTS_VALUE) {
+        m_videoStartTime = video->start_time;
+    }
+
+    m_videoPacket = av_packet_alloc();
+    m_audioPacket = av_packet_alloc();
+    m_frame = av_frame_alloc();
+    if (!m_videoPacket || !m_audioPacket || !m_frame) {
+        throw std::runtime_error("Could not allocate muxing buffers.");
+    }
+}
+
+void MediaMuxer::openOutput(const fs::path& outputPath, int sampleRate, int channels) {
+    int ret =
+        avformat_alloc_output_context2(&m_outputContext, nullptr, nullptr, outputPath.c_str());
+    if (ret < 0 || !m_outputContext) {
+        throw std::runtime_error("Could not create output for " + outputPath.string() + ": " +
+                                 avErrorToString(ret));
+    }
+
+    // Video: stream copy, the container picks its own codec tag
+    const AVStream* inputVideo = m_inputContext->streams[m_inputVideoIndex];
+    AVStream* outputVideo = avformat_new_stream(m_outputContext, nullptr);
+    if (!outputVideo) {
+        throw std::runtime_error("Could not create output video stream.");
+    }
+    ret = avcodec_parameters_copy(outputVideo->codecpar, inputVideo->codecpar);
+    if (ret < 0) {
+        throw std::runtime_error("Could not copy video parameters: " + avErrorToString(ret));
+    }
+    outputVideo->codecpar->codec_tag = 0;
+    outputVideo->time_base = inputVideo->time_base;
+    m_outputVideoIndex = outputVideo->index;
+
+    // Audio: encoded from the samples written to the sink
+    const AVCodec* encoder = avcodec_find_encoder(AV_CODEC_ID_AAC);
+    if (!encoder) {
+        throw std::runtime_error("No AAC encoder available.");
+    }
+    m_encoder = avcodec_alloc_context3(encoder);
+    if (!m_encoder) {
+        throw std::runtime_error("Could not allocate audio encoder context.");
+    }
+    m_encoder->sample_rate = sampleRate;
+    m_encoder->sample_fmt = AV_SAMPLE_FMT_FLTP;
+    m_encoder->bit_rate = AAC_BIT_RATE_PER_CHANNEL * channels;
+    m_encoder->time_base = AVRational{1, sampleRate};
+    av_channel_layout_default(&m_encoder->ch_layout, channels);
+    if (m_outputContext->oformat->flags & AVFMT_GLOBALHEADER) {
+        m_encoder->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+    }
+
+    ret = avcodec_open2(m_encoder, encoder, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not open audio encoder: " + avErrorToString(ret));
+    }
+
+    AVStream* outputAudio = avformat_new_stream(m_outputContext, nullptr);
+    if (!outputAudio) {
+        throw std::runtime_error("Could not create output audio stream.");
+    }
+    ret = avcodec_parameters_from_context(outputAudio->codecpar, m_encoder);
+    if (ret < 0) {
+        throw std::runtime_error("Could not copy audio parameters: " + avErrorToString(ret));
+    }
+    outputAudio->time_base = m_encoder->time_base;
+    m_outputAudioIndex = outputAudio->index;
+
+    m_smallLastFrame = encoder->capabilities & AV_CODEC_CAP_SMALL_LAST_FRAME;
+    m_frameSize = m_encoder->frame_size > 0 ? m_encoder->frame_size : DEFAULT_FRAME_SIZE;
+    m_frame->nb_samples = static_cast<int>(m_frameSize);
+    m_frame->format = m_encoder->sample_fmt;
+    m_frame->sample_rate = sampleRate;
+    av_channel_layout_copy(&m_frame->ch_layout, &m_encoder->ch_layout);
+    ret = av_frame_get_buffer(m_frame, 0);
+    if (ret < 0) {
+        throw std::runtime_error("Could not allocate audio frame: " + avErrorToString(ret));
+    }
+
+    if (!(m_outputContext->oformat->flags & AVFMT_NOFILE)) {
+        ret = avio_open(&m_outputContext->pb, outputPath.c_str(), AVIO_FLAG_WRITE);
+        if (ret < 0) {
+            throw std::runtime_error("Could not open " + outputPath.string() + ": " +
+                                     avErrorToString(ret));
+        }
+    }
+
+    ret = avformat_write_header(m_outputContext, nullptr);
+    if (ret < 0) {
+        throw std::runtime_error("Could not write header: " + avErrorToString(ret));
+    }
+}
+
+void MediaMuxer::writePlanar(std::span<const float* const> channels, size_t numFrames) {
+    if (channels.size() != m_channels) {
+        throw std::runtime_error("Expected " + std::to_string(m_channels) +
+                                 " channel buffers, got " + std::to_string(channels.size()) + ".");
+    }
+
+    size_t offset = 0;
+    while (offset < numFrames) {
+        if (m_frameFill == 0) {
+            // The encoder may still reference the previous frame's buffers
+            int ret = av_frame_make_writable(m_frame);
+            if (ret < 0) {
+                throw std::runtime_error("Could not reuse audio frame: " + avErrorToString(ret));
+            }
+        }
+
+        const size_t count = std::min(numFrames - offset, m_frameSize - m_frameFill);
+        for (size_t channel = 0; channel < m_channels; ++channel) {
+            std::copy_n(channels[channel] + offset, count,
+                        reinterpret_cast<float*>(m_frame->extended_data[channel]) + m_frameFill);
+        }
+        offset += count;
+        m_frameFill += count;
+
+        if (m_frameFill == m_frameSize) {
+            encodeFrame(false);
+        }
+    }
+}
+
+void MediaMuxer::close() {
+    if (m_closed) {
+        return;
+    }
+
+    if (m_frameFill > 0) {
+        if (m_smallLastFrame) {
+            m_frame->nb_samples = static_cast<int>(m_frameFill);
+        } else {
+            for (size_t channel = 0; channel < m_channels; ++channel) {
+                std::fill_n(reinterpret_cast<float*>(m_frame->extended_data[channel]) + m_frameFill,
+                            m_frameSize - m_frameFill, 0.0f);
+            }
+        }
+        encodeFrame(false);
+    }
+    encodeFrame(true);
+
+    // Like -shortest: the video is cut where the audio ends
+    copyVideoUntil(m_audioSamples);
+
+    int ret = av_write_trailer(m_outputContext);
+    if (ret < 0) {
+        throw std::runtime_error("Could not write trailer: " + avErrorToString(ret));
+    }
+    if (!(m_outputContext->oformat->flags & AVFMT_NOFILE)) {
+        avio_closep(&m_outputContext->pb);
+    }
+
+    m_closed = true;
+}
+
+void MediaMuxer::encodeFrame(bool flush) {
+    int ret;
+    if (flush) {
+        ret = avcodec_send_frame(m_encoder, nullptr);
+    } else {
+        m_frame->pts = m_audioSamples;
+        m_audioSamples += static_cast<int64_t>(m_frameFill);
+        m_frameFill = 0;
+        ret = avcodec_send_frame(m_encoder, m_frame);
+    }
+    if (ret < 0) {
+        throw std::runtime_error("Could not encode audio: " + avErrorToString(ret));
+    }
+
+    while (true) {
+        ret = avcodec_receive_packet(m_encoder, m_audioPacket);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+            break;
+        }
+        if (ret < 0) {
+            throw std::runtime_error("Could not encode audio: " + avErrorToString(ret));
+        }
+
+        // The video decoded before this packet goes first, for a properly interleaved output
+        copyVideoUntil(m_audioPacket->dts);
+        writePacket(m_outputContext, m_audioPacket, m_encoder->time_base,
+                    m_outputContext->streams[m_outputAudioIndex]);
+    }
+}
+
+void MediaMuxer::copyVideoUntil(int64_t audioSample) {
+    const AVRational videoTimeBase = m_inputContext->streams[m_inputVideoIndex]->time_base;
+
+    while (!m_videoDone) {
+        if (!m_hasVideoPacket) {
+            int ret = av_read_frame(m_inputContext, m_videoPacket);
+            if (ret == AVERROR_EOF) {
+                m_videoDone = true;
+                break;
+            }
+            if (ret < 0) {
+                throw std::runtime_error("Could not read video: " + avErrorToString(ret));
+            }
+            if (m_videoPacket->stream_index != m_inputVideoIndex) {
+                av_packet_unref(m_videoPacket);
+                continue;
+            }
+
+            if (m_videoPacket->pts != AV_NOPTS_VALUE) {
+                m_videoPacket->pts -= m_videoStartTime;
+            }
+            if (m_videoPacket->dts != AV_NOPTS_VALUE) {
+                m_videoPacket->dts -= m_videoStartTime;
+            }
+            m_hasVideoPacket = true;
+        }
+
+        const int64_t timestamp =
+            m_videoPacket->dts != AV_NOPTS_VALUE ? m_videoPacket->dts : m_videoPacket->pts;
+        if (timestamp != AV_NOPTS_VALUE &&
+            av_compare_ts(timestamp, videoTimeBase, audioSample, m_encoder->time_base) >= 0) {
+            break;
+        }
+
+        writePacket(m_outputContext, m_videoPacket, videoTimeBase,
+                    m_outputContext->streams[m_outputVideoIndex]);
+        m_hasVideoPacket = false;
+    }
+}
+
+void MediaMuxer::release() {
+    if (m_outputContext) {
+        if (m_outputContext->pb && !(m_outputContext->oformat->flags & AVFMT_NOFILE)) {
+            avio_closep(&m_outputContext->pb);
+        }
+        avformat_free_context(m_outputContext);
+        m_outputContext = nullptr;
+    }
+    if (m_inputContext) {
+        avformat_close_input(&m_inputContext);
+    }
+    avcodec_free_context(&m_encoder);
+    av_frame_free(&m_frame);
+    av_packet_free(&m_audioPacket);
+    av_packet_free(&m_videoPacket);
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,97 @@
+#ifndef MEDIAMUXER_H
+#define MEDIAMUXER_H
+
+#include <filesystem>
+#include <span>
+
+#include "IAudioSink.h"
+#include "MediaInfo.h"
+
+extern "C" {
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+}
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Replaces the audio of a video in-process, encoding it as it is written.
+ *
+ * Built on libavformat/libavcodec. The video stream of the input is copied packet by packet
+ * without re-encoding, and the audio written to the sink is encoded to AAC and interleaved with
+ * it, so the processed audio never goes through an intermediate file. Like `ffmpeg -shortest`,
+ * the output ends with the audio.
+ */
+class MediaMuxer : public IAudioSink {
+   public:
+    /**
+     * @brief Opens the input video and writes the header of `outputPath`.
+     *
+     * The container is chosen by the extension of `outputPath`.
+     *
+     * @throws std::runtime_error if the input has no video stream, or the output or the encoder
+     *         cannot be set up.
+     */
+    MediaMuxer(const MediaInfo& videoInfo, const fs::path& outputPath, int sampleRate,
+               int channels);
+    ~MediaMuxer() override;
+
+    MediaMuxer(const MediaMuxer&) = delete;
+    MediaMuxer& operator=(const MediaMuxer&) = delete;
+
+    void writePlanar(std::span<const float* const> channels, size_t numFrames) override;
+
+    /**
+     * @brief Flushes the encoder, copies the remaining video and writes the trailer.
+     *
+     * The destructor only releases resources; an output that was not closed is incomplete.
+     */
+    void close() override;
+
+   private:
+    AVFormatContext* m_inputContext = nullptr;
+    AVFormatContext* m_outputContext = nullptr;
+    AVCodecContext* m_encoder = nullptr;
+    AVFrame* m_frame = nullptr;
+    AVPacket* m_audioPacket = nullptr;
+    AVPacket* m_videoPacket = nullptr;
+
+    int m_inputVideoIndex;
+    int m_outputVideoIndex = -1;
+    int m_outputAudioIndex = -1;
+    size_t m_channels;
+
+    size_t m_frameSize = 0;
+    bool m_smallLastFrame = false;  // the last frame may be shorter than m_frameSize
+    size_t m_frameFill = 0;         // samples buffered in m_frame
+    int64_t m_audioSamples = 0;     // samples sent to the encoder, the pts of the next frame
+    int64_t m_videoStartTime = 0;   // subtracted so the video starts with the audio
+    bool m_hasVideoPacket = false;  // m_videoPacket is read but not written yet
+    bool m_videoDone = false;
+    bool m_closed = false;
+
+    void openInput(const MediaInfo& videoInfo);
+    void openOutput(const fs::path& outputPath, int sampleRate, int channels);
+
+    /**
+     * @brief Encodes the buffered frame, or drains the encoder if `flush` is set.
+     */
+    void encodeFrame(bool flush);
+
+    /**
+     * @brief Copies the video packets decoded before the audio reaches `audioSample`.
+     *
+     * The first packet past it is kept back for the next call.
+     */
+    void copyVideoUntil(int64_t audioSample);
+
+    void release();
+};
+
+}  // namespace MediaProcessor
+
+#endif  // MEDIAMUXER_H
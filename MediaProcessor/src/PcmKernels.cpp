@@ -0,0 +1,828 @@
+// Multiplies and adds must round separately so every variant matches the scalar code. Set before
+// the includes, so that inlined library code is compiled with the same options.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include "PcmKernels.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PCM_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define PCM_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace MediaProcessor::PcmKernels {
+
+namespace {
+
+constexpr float S16_SCALE = 32768.0f;
+constexpr float S24_SCALE = 8388608.0f;
+constexpr float S32_SCALE = 2147483648.0f;
+
+// Largest scaled values that still convert without overflow
+constexpr float S16_MAX = 32767.0f;
+constexpr float S24_MAX = 8388607.0f;
+constexpr float S32_MAX = 2147483520.0f;  // the float below 2^31
+
+// Samples converted at a time when (de)interleaving or dithering
+constexpr size_t SCRATCH_SAMPLES = 4096;
+
+struct Kernels {
+    void (*s16ToFloat)(const int16_t* input, float* output, size_t count);
+    void (*floatToS16)(const float* input, int16_t* output, size_t count);
+    void (*s32ToFloat)(const int32_t* input, float* output, size_t count);
+    void (*floatToS32)(const float* input, int32_t* output, size_t count);
+    void (*applyGain)(float* samples, size_t count, float gain);
+    void (*mix)(float* output, const float* input, size_t count, float gain);
+    void (*clamp)(float* samples, size_t count);
+    float (*dotProduct)(const float* a, const float* b, size_t count);
+};
+
+/**
+ * @brief Clamps like SSE's maxps/minps, so NaN becomes `low` in every variant.
+ */
+inline float clampSample(float value, float low, float high) {
+    value = value > low ? value : low;
+    return value < high ? value : high;
+}
+
+namespace Scalar {
+
+void s16ToFloat(const int16_t* input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = input[i] * (1.0f / S16_SCALE);
+    }
+}
+
+void floatToS16(const float* input, int16_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<int16_t>(
+            std::lrintf(clampSample(input[i] * S16_SCALE, -S16_SCALE, S16_MAX)));
+    }
+}
+
+void s32ToFloat(const int32_t* input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<float>(input[i]) * (1.0f / S32_SCALE);
+    }
+}
+
+void floatToS32(const float* input, int32_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] = static_cast<int32_t>(
+            std::lrintf(clampSample(input[i] * S32_SCALE, -S32_SCALE, S32_MAX)));
+    }
+}
+
+void applyGain(float* samples, size_t count, float gain) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] *= gain;
+    }
+}
+
+void mix(float* output, const float* input, size_t count, float gain) {
+    for (size_t i = 0; i < count; ++i) {
+        output[i] += input[i] * gain;
+    }
+}
+
+void clamp(float* samples, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = clampSample(samples[i], -1.0f, 1.0f);
+    }
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void s24ToFloat(const uint8_t* input, float* output, size_t count) {
+    for (size_t i = 0; i < count; ++i, input += 3) {
+        // Assemble in the top bytes, the arithmetic shift sign-extends
+        const auto value = static_cast<int32_t>(static_cast<uint32_t>(input[0]) << 8 |
+                                                static_cast<uint32_t>(input[1]) << 16 |
+                                                static_cast<uint32_t>(input[2]) << 24) >>
+                           8;
+        output[i] = static_cast<float>(value) * (1.0f / S24_SCALE);
+    }
+}
+
+void floatToS24(const float* input, uint8_t* output, size_t count) {
+    for (size_t i = 0; i < count; ++i, output += 3) {
+        const auto value = static_cast<uint32_t>(
+            std::lrintf(clampSample(input[i] * S24_SCALE, -S24_SCALE, S24_MAX)));
+        output[0] = static_cast<uint8_t>(value);
+        output[1] = static_cast<uint8_t>(value >> 8);
+        output[2] = static_cast<uint8_t>(value >> 16);
+    }
+}
+
+constexpr Kernels KERNELS = {s16ToFloat, floatToS16, s32ToFloat, floatToS32,
+                             applyGain,  mix,        clamp,      dotProduct};
+
+}  // namespace Scalar
+
+#ifdef PCM_KERNELS_X86
+
+// SSE2 is part of x86-64, these need no target attribute there
+namespace Sse2 {
+
+#ifdef __x86_64__
+#define PCM_TARGET_SSE2
+#else
+#define PCM_TARGET_SSE2 __attribute__((target("sse2")))
+#endif
+
+PCM_TARGET_SSE2 inline float horizontalSum(__m128 sums) {
+    const __m128 pairs = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 0x55)));
+}
+
+PCM_TARGET_SSE2 void s16ToFloat(const int16_t* input, float* output, size_t count) {
+    const __m128 scale = _mm_set1_ps(1.0f / S16_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        // Unpack into the upper halves, the arithmetic shift sign-extends
+        const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+        const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(low), scale));
+        _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), scale));
+    }
+    Scalar::s16ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_SSE2 void floatToS16(const float* input, int16_t* output, size_t count) {
+    const __m128 scale = _mm_set1_ps(S16_SCALE);
+    const __m128 low = _mm_set1_ps(-S16_SCALE);
+    const __m128 high = _mm_set1_ps(S16_MAX);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 first = _mm_mul_ps(_mm_loadu_ps(input + i), scale);
+        __m128 second = _mm_mul_ps(_mm_loadu_ps(input + i + 4), scale);
+        first = _mm_min_ps(_mm_max_ps(first, low), high);
+        second = _mm_min_ps(_mm_max_ps(second, low), high);
+        const __m128i packed = _mm_packs_epi32(_mm_cvtps_epi32(first), _mm_cvtps_epi32(second));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), packed);
+    }
+    Scalar::floatToS16(input + i, output + i, count - i);
+}
+
+PCM_TARGET_SSE2 void s32ToFloat(const int32_t* input, float* output, size_t count) {
+    const __m128 scale = _mm_set1_ps(1.0f / S32_SCALE);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(samples), scale));
+    }
+    Scalar::s32ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_SSE2 void floatToS32(const float* input, int32_t* output, size_t count) {
+    const __m128 scale = _mm_set1_ps(S32_SCALE);
+    const __m128 low = _mm_set1_ps(-S32_SCALE);
+    const __m128 high = _mm_set1_ps(S32_MAX);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 samples = _mm_mul_ps(_mm_loadu_ps(input + i), scale);
+        samples = _mm_min_ps(_mm_max_ps(samples, low), high);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_cvtps_epi32(samples));
+    }
+    Scalar::floatToS32(input + i, output + i, count - i);
+}
+
+PCM_TARGET_SSE2 void applyGain(float* samples, size_t count, float gain) {
+    const __m128 factor = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), factor));
+    }
+    Scalar::applyGain(samples + i, count - i, gain);
+}
+
+PCM_TARGET_SSE2 void mix(float* output, const float* input, size_t count, float gain) {
+    const __m128 factor = _mm_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(input + i), factor);
+        _mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), scaled));
+    }
+    Scalar::mix(output + i, input + i, count - i, gain);
+}
+
+PCM_TARGET_SSE2 void clamp(float* samples, size_t count) {
+    const __m128 low = _mm_set1_ps(-1.0f);
+    const __m128 high = _mm_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), low), high);
+        _mm_storeu_ps(samples + i, clamped);
+    }
+    Scalar::clamp(samples + i, count - i);
+}
+
+PCM_TARGET_SSE2 float dotProduct(const float* a, const float* b, size_t count) {
+    // Two accumulators hide the latency of the adds
+    __m128 first = _mm_setzero_ps();
+    __m128 second = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        first = _mm_add_ps(first, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        second = _mm_add_ps(second, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    return horizontalSum(_mm_add_ps(first, second)) + Scalar::dotProduct(a + i, b + i, count - i);
+}
+
+#undef PCM_TARGET_SSE2
+
+constexpr Kernels KERNELS = {s16ToFloat, floatToS16, s32ToFloat, floatToS32,
+                             applyGain,  mix,        clamp,      dotProduct};
+
+}  // namespace Sse2
+
+namespace Avx2 {
+
+#define PCM_TARGET_AVX2 __attribute__((target("avx2")))
+
+PCM_TARGET_AVX2 void s16ToFloat(const int16_t* input, float* output, size_t count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / S16_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m256 converted = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(samples));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(converted, scale));
+    }
+    Scalar::s16ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX2 void floatToS16(const float* input, int16_t* output, size_t count) {
+    const __m256 scale = _mm256_set1_ps(S16_SCALE);
+    const __m256 low = _mm256_set1_ps(-S16_SCALE);
+    const __m256 high = _mm256_set1_ps(S16_MAX);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 first = _mm256_mul_ps(_mm256_loadu_ps(input + i), scale);
+        __m256 second = _mm256_mul_ps(_mm256_loadu_ps(input + i + 8), scale);
+        first = _mm256_min_ps(_mm256_max_ps(first, low), high);
+        second = _mm256_min_ps(_mm256_max_ps(second, low), high);
+
+        // Packing works within 128-bit lanes, restore the sample order afterwards
+        const __m256i packed =
+            _mm256_packs_epi32(_mm256_cvtps_epi32(first), _mm256_cvtps_epi32(second));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    Scalar::floatToS16(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX2 void s32ToFloat(const int32_t* input, float* output, size_t count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / S32_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(samples), scale));
+    }
+    Scalar::s32ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX2 void floatToS32(const float* input, int32_t* output, size_t count) {
+    const __m256 scale = _mm256_set1_ps(S32_SCALE);
+    const __m256 low = _mm256_set1_ps(-S32_SCALE);
+    const __m256 high = _mm256_set1_ps(S32_MAX);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 samples = _mm256_mul_ps(_mm256_loadu_ps(input + i), scale);
+        samples = _mm256_min_ps(_mm256_max_ps(samples, low), high);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_cvtps_epi32(samples));
+    }
+    Scalar::floatToS32(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX2 void applyGain(float* samples, size_t count, float gain) {
+    const __m256 factor = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(samples + i, _mm256_mul_ps(_mm256_loadu_ps(samples + i), factor));
+    }
+    Scalar::applyGain(samples + i, count - i, gain);
+}
+
+PCM_TARGET_AVX2 void mix(float* output, const float* input, size_t count, float gain) {
+    const __m256 factor = _mm256_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(input + i), factor);
+        _mm256_storeu_ps(output + i, _mm256_add_ps(_mm256_loadu_ps(output + i), scaled));
+    }
+    Scalar::mix(output + i, input + i, count - i, gain);
+}
+
+PCM_TARGET_AVX2 void clamp(float* samples, size_t count) {
+    const __m256 low = _mm256_set1_ps(-1.0f);
+    const __m256 high = _mm256_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 clamped =
+            _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(samples + i), low), high);
+        _mm256_storeu_ps(samples + i, clamped);
+    }
+    Scalar::clamp(samples + i, count - i);
+}
+
+PCM_TARGET_AVX2 float dotProduct(const float* a, const float* b, size_t count) {
+    __m256 first = _mm256_setzero_ps();
+    __m256 second = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        first = _mm256_add_ps(first,
+                              _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+        second = _mm256_add_ps(
+            second, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+    }
+    const __m256 sums = _mm256_add_ps(first, second);
+    const __m128 halves = _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+    return Sse2::horizontalSum(halves) + Scalar::dotProduct(a + i, b + i, count - i);
+}
+
+#undef PCM_TARGET_AVX2
+
+constexpr Kernels KERNELS = {s16ToFloat, floatToS16, s32ToFloat, floatToS32,
+                             applyGain,  mix,        clamp,      dotProduct};
+
+}  // namespace Avx2
+
+// GCC 12's AVX-512 headers trip -W(maybe-)uninitialized on their own undefined placeholders
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+namespace Avx512 {
+
+#define PCM_TARGET_AVX512 __attribute__((target("avx512f")))
+
+PCM_TARGET_AVX512 void s16ToFloat(const int16_t* input, float* output, size_t count) {
+    const __m512 scale = _mm512_set1_ps(1.0f / S16_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m256i samples = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m512 converted = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(samples));
+        _mm512_storeu_ps(output + i, _mm512_mul_ps(converted, scale));
+    }
+    Scalar::s16ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX512 void floatToS16(const float* input, int16_t* output, size_t count) {
+    const __m512 scale = _mm512_set1_ps(S16_SCALE);
+    const __m512 low = _mm512_set1_ps(-S16_SCALE);
+    const __m512 high = _mm512_set1_ps(S16_MAX);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 samples = _mm512_mul_ps(_mm512_loadu_ps(input + i), scale);
+        samples = _mm512_min_ps(_mm512_max_ps(samples, low), high);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(samples)));
+    }
+    Scalar::floatToS16(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX512 void s32ToFloat(const int32_t* input, float* output, size_t count) {
+    const __m512 scale = _mm512_set1_ps(1.0f / S32_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512i samples = _mm512_loadu_si512(input + i);
+        _mm512_storeu_ps(output + i, _mm512_mul_ps(_mm512_cvtepi32_ps(samples), scale));
+    }
+    Scalar::s32ToFloat(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX512 void floatToS32(const float* input, int32_t* output, size_t count) {
+    const __m512 scale = _mm512_set1_ps(S32_SCALE);
+    const __m512 low = _mm512_set1_ps(-S32_SCALE);
+    const __m512 high = _mm512_set1_ps(S32_MAX);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 samples = _mm512_mul_ps(_mm512_loadu_ps(input + i), scale);
+        samples = _mm512_min_ps(_mm512_max_ps(samples, low), high);
+        _mm512_storeu_si512(output + i, _mm512_cvtps_epi32(samples));
+    }
+    Scalar::floatToS32(input + i, output + i, count - i);
+}
+
+PCM_TARGET_AVX512 void applyGain(float* samples, size_t count, float gain) {
+    const __m512 factor = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_ps(samples + i, _mm512_mul_ps(_mm512_loadu_ps(samples + i), factor));
+    }
+    Scalar::applyGain(samples + i, count - i, gain);
+}
+
+PCM_TARGET_AVX512 void mix(float* output, const float* input, size_t count, float gain) {
+    const __m512 factor = _mm512_set1_ps(gain);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 scaled = _mm512_mul_ps(_mm512_loadu_ps(input + i), factor);
+        _mm512_storeu_ps(output + i, _mm512_add_ps(_mm512_loadu_ps(output + i), scaled));
+    }
+    Scalar::mix(output + i, input + i, count - i, gain);
+}
+
+PCM_TARGET_AVX512 void clamp(float* samples, size_t count) {
+    const __m512 low = _mm512_set1_ps(-1.0f);
+    const __m512 high = _mm512_set1_ps(1.0f);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m512 clamped =
+            _mm512_min_ps(_mm512_max_ps(_mm512_loadu_ps(samples + i), low), high);
+        _mm512_storeu_ps(samples + i, clamped);
+    }
+    Scalar::clamp(samples + i, count - i);
+}
+
+PCM_TARGET_AVX512 float dotProduct(const float* a, const float* b, size_t count) {
+    __m512 first = _mm512_setzero_ps();
+    __m512 second = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        first = _mm512_add_ps(first,
+                              _mm512_mul_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+        second = _mm512_add_ps(
+            second, _mm512_mul_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16)));
+    }
+    return _mm512_reduce_add_ps(_mm512_add_ps(first, second)) +
+           Scalar::dotProduct(a + i, b + i, count - i);
+}
+
+#undef PCM_TARGET_AVX512
+
+constexpr Kernels KERNELS = {s16ToFloat, floatToS16, s32ToFloat, floatToS32,
+                             applyGain,  mix,        clamp,      dotProduct};
+
+}  // namespace Avx512
+
+#pragma GCC diagnostic pop
+
+#endif  // PCM_KERNELS_X86
+
+#ifdef PCM_KERNELS_NEON
+
+namespace Neon {
+
+void s16ToFloat(const int16_t* input, float* output, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t samples = vld1q_s16(input + i);
+        const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+        const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+        vst1q_f32(output + i, vmulq_n_f32(low, 1.0f / S16_SCALE));
+        vst1q_f32(output + i + 4, vmulq_n_f32(high, 1.0f / S16_SCALE));
+    }
+    Scalar::s16ToFloat(input + i, output + i, count - i);
+}
+
+// vmaxnmq/vminnmq return the number for a NaN operand, matching the other variants
+float32x4_t clampScaled(float32x4_t samples, float scale, float low, float high) {
+    samples = vmulq_n_f32(samples, scale);
+    return vminnmq_f32(vmaxnmq_f32(samples, vdupq_n_f32(low)), vdupq_n_f32(high));
+}
+
+void floatToS16(const float* input, int16_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float32x4_t low = clampScaled(vld1q_f32(input + i), S16_SCALE, -S16_SCALE, S16_MAX);
+        const float32x4_t high =
+            clampScaled(vld1q_f32(input + i + 4), S16_SCALE, -S16_SCALE, S16_MAX);
+        vst1q_s16(output + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(low)),
+                                           vqmovn_s32(vcvtnq_s32_f32(high))));
+    }
+    Scalar::floatToS16(input + i, output + i, count - i);
+}
+
+void s32ToFloat(const int32_t* input, float* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(output + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(input + i)), 1.0f / S32_SCALE));
+    }
+    Scalar::s32ToFloat(input + i, output + i, count - i);
+}
+
+void floatToS32(const float* input, int32_t* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t samples =
+            clampScaled(vld1q_f32(input + i), S32_SCALE, -S32_SCALE, S32_MAX);
+        vst1q_s32(output + i, vcvtnq_s32_f32(samples));
+    }
+    Scalar::floatToS32(input + i, output + i, count - i);
+}
+
+void applyGain(float* samples, size_t count, float gain) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(samples + i, vmulq_n_f32(vld1q_f32(samples + i), gain));
+    }
+    Scalar::applyGain(samples + i, count - i, gain);
+}
+
+void mix(float* output, const float* input, size_t count, float gain) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float32x4_t scaled = vmulq_n_f32(vld1q_f32(input + i), gain);
+        vst1q_f32(output + i, vaddq_f32(vld1q_f32(output + i), scaled));
+    }
+    Scalar::mix(output + i, input + i, count - i, gain);
+}
+
+void clamp(float* samples, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(samples + i, clampScaled(vld1q_f32(samples + i), 1.0f, -1.0f, 1.0f));
+    }
+    Scalar::clamp(samples + i, count - i);
+}
+
+float dotProduct(const float* a, const float* b, size_t count) {
+    float32x4_t first = vdupq_n_f32(0.0f);
+    float32x4_t second = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        first = vmlaq_f32(first, vld1q_f32(a + i), vld1q_f32(b + i));
+        second = vmlaq_f32(second, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    return vaddvq_f32(vaddq_f32(first, second)) + Scalar::dotProduct(a + i, b + i, count - i);
+}
+
+constexpr Kernels KERNELS = {s16ToFloat, floatToS16, s32ToFloat, floatToS32,
+                             applyGain,  mix,        clamp,      dotProduct};
+
+}  // namespace Neon
+
+#endif  // PCM_KERNELS_NEON
+
+const Kernels* getKernelsFor(SimdLevel level) {
+    switch (level) {
+#ifdef PCM_KERNELS_X86
+        case SimdLevel::SSE2:
+            return &Sse2::KERNELS;
+        case SimdLevel::AVX2:
+            return &Avx2::KERNELS;
+        case SimdLevel::AVX512:
+            return &Avx512::KERNELS;
+#endif
+#ifdef PCM_KERNELS_NEON
+        case SimdLevel::NEON:
+            return &Neon::KERNELS;
+#endif
+        default:
+            return &Scalar::KERNELS;
+    }
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef PCM_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::SSE2;
+    }
+#elif defined(PCM_KERNELS_NEON)
+    return SimdLevel::NEON;
+#endif
+    return SimdLevel::Scalar;
+}
+
+bool isSupported(SimdLevel level, SimdLevel supported) {
+    if (level == SimdLevel::Scalar || level == supported) {
+        return true;
+    }
+    // The x86 levels are supersets of one another
+    return supported != SimdLevel::NEON && level != SimdLevel::NEON && level < supported;
+}
+
+struct Dispatch {
+    SimdLevel supported = detectSimdLevel();
+    std::atomic<SimdLevel> level = supported;
+    std::atomic<const Kernels*> kernels = getKernelsFor(supported);
+};
+
+Dispatch& getDispatch() {
+    static Dispatch dispatch;
+    return dispatch;
+}
+
+const Kernels& getKernels() {
+    return *getDispatch().kernels.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
+size_t getBytesPerSample(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::S16:
+            return 2;
+        case SampleFormat::S24:
+            return 3;
+        case SampleFormat::S32:
+        case SampleFormat::F32:
+        default:
+            return 4;
+    }
+}
+
+SimdLevel getSimdLevel() {
+    return getDispatch().level.load(std::memory_order_relaxed);
+}
+
+SimdLevel getSupportedSimdLevel() {
+    return getDispatch().supported;
+}
+
+bool setSimdLevel(SimdLevel level) {
+    Dispatch& dispatch = getDispatch();
+    if (!isSupported(level, dispatch.supported)) {
+        return false;
+    }
+    dispatch.level.store(level, std::memory_order_relaxed);
+    dispatch.kernels.store(getKernelsFor(level), std::memory_order_relaxed);
+    return true;
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::AVX512:
+            return "AVX-512";
+        case SimdLevel::NEON:
+            return "NEON";
+        default:
+            return "unknown";
+    }
+}
+
+Dither::Dither(uint32_t seed) : m_state(seed ? seed : 1) {}
+
+float Dither::nextUniform() {
+    // xorshift32, plenty for noise and far cheaper than <random>
+    m_state ^= m_state << 13;
+    m_state ^= m_state >> 17;
+    m_state ^= m_state << 5;
+    return static_cast<float>(m_state) * (1.0f / 4294967296.0f) - 0.5f;
+}
+
+void Dither::apply(std::span<float> samples, SampleFormat format) {
+    float lsb;
+    if (format == SampleFormat::S16) {
+        lsb = 1.0f / S16_SCALE;
+    } else if (format == SampleFormat::S24) {
+        lsb = 1.0f / S24_SCALE;
+    } else {
+        return;  // float and 32-bit quantization noise is far below audibility
+    }
+
+    for (float& sample : samples) {
+        sample += (nextUniform() + nextUniform()) * lsb;
+    }
+}
+
+void convertToFloat(const void* input, SampleFormat format, std::span<float> output) {
+    switch (format) {
+        case SampleFormat::S16:
+            getKernels().s16ToFloat(static_cast<const int16_t*>(input), output.data(),
+                                    output.size());
+            break;
+        case SampleFormat::S24:
+            Scalar::s24ToFloat(static_cast<const uint8_t*>(input), output.data(), output.size());
+            break;
+        case SampleFormat::S32:
+            getKernels().s32ToFloat(static_cast<const int32_t*>(input), output.data(),
+                                    output.size());
+            break;
+        case SampleFormat::F32:
+            std::memcpy(output.data(), input, output.size_bytes());
+            break;
+    }
+}
+
+void convertFromFloat(std::span<const float> input, SampleFormat format, void* output) {
+    switch (format) {
+        case SampleFormat::S16:
+            getKernels().floatToS16(input.data(), static_cast<int16_t*>(output), input.size());
+            break;
+        case SampleFormat::S24:
+            Scalar::floatToS24(input.data(), static_cast<uint8_t*>(output), input.size());
+            break;
+        case SampleFormat::S32:
+            getKernels().floatToS32(input.data(), static_cast<int32_t*>(output), input.size());
+            break;
+        case SampleFormat::F32:
+            std::memcpy(output, input.data(), input.size_bytes());
+            break;
+    }
+}
+
+void deinterleaveToFloat(const void* input, SampleFormat format, size_t numFrames,
+                         std::span<float* const> output) {
+    const size_t channels = output.size();
+    if (channels == 1) {
+        convertToFloat(input, format, {output[0], numFrames});
+        return;
+    }
+    if (channels == 0 || channels > SCRATCH_SAMPLES) {
+        throw std::runtime_error("Unsupported channel count: " + std::to_string(channels));
+    }
+
+    // Convert vectorized into a cache-resident block, then scatter it to the channels
+    std::array<float, SCRATCH_SAMPLES> scratch;
+    const size_t blockFrames = SCRATCH_SAMPLES / channels;
+    const auto* bytes = static_cast<const uint8_t*>(input);
+    const size_t frameBytes = channels * getBytesPerSample(format);
+
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        convertToFloat(bytes + frame * frameBytes, format, {scratch.data(), frames * channels});
+        for (size_t channel = 0; channel < channels; ++channel) {
+            float* channelOutput = output[channel] + frame;
+            for (size_t i = 0; i < frames; ++i) {
+                channelOutput[i] = scratch[i * channels + channel];
+            }
+        }
+    }
+}
+
+void interleaveFromFloat(std::span<const float* const> input, size_t numFrames,
+                         SampleFormat format, void* output, Dither* dither) {
+    const size_t channels = input.size();
+    if (channels == 1 && !dither) {
+        convertFromFloat({input[0], numFrames}, format, output);
+        return;
+    }
+    if (channels == 0 || channels > SCRATCH_SAMPLES) {
+        throw std::runtime_error("Unsupported channel count: " + std::to_string(channels));
+    }
+
+    std::array<float, SCRATCH_SAMPLES> scratch;
+    const size_t blockFrames = SCRATCH_SAMPLES / channels;
+    auto* bytes = static_cast<uint8_t*>(output);
+    const size_t frameBytes = channels * getBytesPerSample(format);
+
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        for (size_t channel = 0; channel < channels; ++channel) {
+            const float* channelInput = input[channel] + frame;
+            for (size_t i = 0; i < frames; ++i) {
+                scratch[i * channels + channel] = channelInput[i];
+            }
+        }
+
+        const std::span<float> block(scratch.data(), frames * channels);
+        if (dither) {
+            dither->apply(block, format);
+        }
+        convertFromFloat(block, format, bytes + frame * frameBytes);
+    }
+}
+
+void applyGain(std::span<float> samples, float gain) {
+    getKernels().applyGain(samples.data(), samples.size(), gain);
+}
+
+void mix(std::span<float> output, std::span<const float> input, float gain) {
+    getKernels().mix(output.data(), input.data(), std::min(output.size(), input.size()), gain);
+}
+
+void clamp(std::span<float> samples) {
+    getKernels().clamp(samples.data(), samples.size());
+}
+
+float dotProduct(std::span<const float> a, const float* b) {
+    return getKernels().dotProduct(a.data(), b, a.size());
+}
+
+}  // namespace MediaProcessor::PcmKernels
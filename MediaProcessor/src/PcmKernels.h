@@ -0,0 +1,128 @@
+#ifndef PCMKERNELS_H
+#define PCMKERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Sample format conversion and mixing kernels with runtime CPU dispatch.
+ *
+ * Every kernel has SSE2, AVX2 and AVX-512 variants on x86 and a NEON variant on ARM64, and the
+ * widest one the CPU supports is selected on first use. The binary itself only assumes the
+ * baseline instruction set, so one build runs on any instance type.
+ *
+ * Float samples are normalized to [-1, 1). Integer formats are scaled by a power of two in both
+ * directions, so integer -> float -> integer round trips are exact; out-of-range floats are
+ * clamped and rounded to nearest. All variants produce bit-identical conversions and mixes;
+ * PcmKernels.cpp disables floating-point contraction with a pragma, so no compiler fuses a
+ * multiply and add into an FMA that rounds once.
+ */
+namespace MediaProcessor::PcmKernels {
+
+enum class SampleFormat {
+    S16,  // int16_t
+    S24,  // packed little-endian 3 bytes, converted by the scalar code on every CPU
+    S32,  // int32_t
+    F32,  // float, copied as is
+};
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512, NEON };
+
+size_t getBytesPerSample(SampleFormat format);
+
+/**
+ * @brief Instruction set the kernels currently run with.
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Widest instruction set supported by the CPU and the build.
+ */
+SimdLevel getSupportedSimdLevel();
+
+/**
+ * @brief Forces the kernels to a narrower instruction set, for tests and benchmarks.
+ *
+ * @return false if the CPU does not support `level`; the selection is then unchanged.
+ */
+bool setSimdLevel(SimdLevel level);
+
+const char* getSimdLevelName(SimdLevel level);
+
+/**
+ * @brief Triangular (TPDF) dither of +/-1 LSB, decorrelating quantization error from the signal.
+ *
+ * Holds the noise generator of one stream; deterministic for a given seed.
+ */
+class Dither {
+   public:
+    explicit Dither(uint32_t seed = 1);
+
+    /**
+     * @brief Adds dither scaled to the LSB of `format`. Float and 32-bit formats are left as is.
+     */
+    void apply(std::span<float> samples, SampleFormat format);
+
+   private:
+    uint32_t m_state;
+
+    float nextUniform();
+};
+
+/**
+ * @brief Converts samples of `format` to float, keeping their layout.
+ *
+ * @param input `output.size()` samples of `format`.
+ */
+void convertToFloat(const void* input, SampleFormat format, std::span<float> output);
+
+/**
+ * @brief Converts float samples to `format`, keeping their layout.
+ *
+ * @param output Room for `input.size()` samples of `format`.
+ */
+void convertFromFloat(std::span<const float> input, SampleFormat format, void* output);
+
+/**
+ * @brief Converts interleaved samples of `format` to one float buffer per channel.
+ *
+ * @param output One buffer of `numFrames` samples per channel.
+ */
+void deinterleaveToFloat(const void* input, SampleFormat format, size_t numFrames,
+                         std::span<float* const> output);
+
+/**
+ * @brief Converts one float buffer per channel to interleaved samples of `format`.
+ *
+ * @param dither Dither applied before quantization, or nullptr for plain rounding.
+ */
+void interleaveFromFloat(std::span<const float* const> input, size_t numFrames,
+                         SampleFormat format, void* output, Dither* dither = nullptr);
+
+/**
+ * @brief Multiplies `samples` by `gain` in place.
+ */
+void applyGain(std::span<float> samples, float gain);
+
+/**
+ * @brief Adds `input` scaled by `gain` to `output`, e.g. to downmix channels.
+ */
+void mix(std::span<float> output, std::span<const float> input, float gain = 1.0f);
+
+/**
+ * @brief Limits `samples` to [-1, 1] in place.
+ */
+void clamp(std::span<float> samples);
+
+/**
+ * @brief Sum of `a[i] * b[i]`, the inner loop of FIR filters.
+ *
+ * Unlike the conversions, the variants accumulate in different orders and may differ in the last
+ * bits.
+ */
+float dotProduct(std::span<const float> a, const float* b);
+
+}  // namespace MediaProcessor::PcmKernels
+
+#endif  // PCMKERNELS_H
@@ -0,0 +1,185 @@
+#include "PerfCounters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MediaProcessor {
+
+namespace {
+
+#ifdef __linux__
+
+constexpr int NOT_OPENED = -2;
+
+struct CounterEvent {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr std::array<CounterEvent, PerfCounters::COUNTER_COUNT> COUNTER_EVENTS = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+}};
+
+/**
+ * @return The counter's file descriptor for the calling thread, or -1 with errno set.
+ */
+int openCounter(PerfCounters::Counter counter, bool excludeKernel) {
+    const CounterEvent& event = COUNTER_EVENTS[static_cast<size_t>(counter)];
+
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = event.type;
+    attributes.config = event.config;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attributes.exclude_kernel = excludeKernel;
+    attributes.exclude_hv = 1;
+
+    return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+}
+
+// Closed when the thread exits
+struct ThreadCounters {
+    std::array<int, PerfCounters::COUNTER_COUNT> fds;
+
+    ThreadCounters() {
+        fds.fill(NOT_OPENED);
+    }
+
+    ~ThreadCounters() {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+};
+
+uint64_t readCounter(int fd) {
+    struct {
+        uint64_t value;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+    } data;
+    if (read(fd, &data, sizeof(data)) != sizeof(data) || data.timeRunning == 0) {
+        return 0;
+    }
+
+    // Scale up if the kernel had to multiplex more counters than the PMU has
+    if (data.timeRunning < data.timeEnabled) {
+        return static_cast<uint64_t>(static_cast<double>(data.value) * data.timeEnabled /
+                                     data.timeRunning);
+    }
+    return data.value;
+}
+
+#endif
+
+}  // namespace
+
+PerfCounters& PerfCounters::getInstance() {
+    static PerfCounters instance;
+    return instance;
+}
+
+bool PerfCounters::enable() {
+#ifdef __linux__
+    std::string unavailable;
+    int lastError = 0;
+    bool anyAvailable = false;
+
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        const Counter counter = static_cast<Counter>(i);
+
+        // Count kernel time too where allowed, user space alone is still worth having
+        bool excludeKernel = false;
+        int fd = openCounter(counter, excludeKernel);
+        if (fd < 0 && (errno == EACCES || errno == EPERM) && counter != Counter::ContextSwitches) {
+            excludeKernel = true;
+            fd = openCounter(counter, excludeKernel);
+        }
+
+        if (fd < 0) {
+            lastError = errno;
+            unavailable += unavailable.empty() ? "" : ", ";
+            unavailable += getCounterName(counter);
+        } else {
+            close(fd);
+            anyAvailable = true;
+        }
+        m_available[i].store(fd >= 0);
+        m_excludeKernel[i].store(excludeKernel);
+    }
+
+    if (!unavailable.empty()) {
+        std::cerr << "Warning: Performance counters unavailable (" << unavailable
+                  << "): " << std::strerror(lastError) << "."
+                  << (lastError == EACCES || lastError == EPERM
+                          ? " Lowering kernel.perf_event_paranoid or granting CAP_PERFMON may help."
+                          : "")
+                  << std::endl;
+    }
+    m_enabled.store(anyAvailable, std::memory_order_relaxed);
+    return anyAvailable;
+#else
+    std::cerr << "Warning: Performance counters are only supported on Linux." << std::endl;
+    return false;
+#endif
+}
+
+void PerfCounters::disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool PerfCounters::isAvailable(Counter counter) const {
+    return m_available[static_cast<size_t>(counter)].load();
+}
+
+PerfCounters::Values PerfCounters::readThread() {
+    Values values{};
+#ifdef __linux__
+    if (!isEnabled()) {
+        return values;
+    }
+
+    thread_local ThreadCounters threadCounters;
+    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+        int& fd = threadCounters.fds[i];
+        if (fd == NOT_OPENED && m_available[i].load()) {
+            fd = openCounter(static_cast<Counter>(i), m_excludeKernel[i].load());
+        }
+        if (fd >= 0) {
+            values[i] = readCounter(fd);
+        }
+    }
+#endif
+    return values;
+}
+
+const char* PerfCounters::getCounterName(Counter counter) {
+    switch (counter) {
+        case Counter::Cycles:
+            return "cycles";
+        case Counter::Instructions:
+            return "instructions";
+        case Counter::CacheMisses:
+            return "cache_misses";
+        case Counter::ContextSwitches:
+            return "context_switches";
+        default:
+            return "unknown";
+    }
+}
+
+}  // namespace MediaProcessor
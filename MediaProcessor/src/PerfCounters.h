@@ -0,0 +1,64 @@
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MediaProcessor {
+
+/**
+ * @brief Process-wide access to per-thread CPU performance counters (Linux `perf_event_open`).
+ *
+ * Each thread opens its own counters on first use; they count only that thread, so the
+ * difference between two reads on the same thread is the cost of the code in between, even
+ * while other jobs run on the pool. Counters the kernel or hardware refuses (e.g. under a high
+ * `kernel.perf_event_paranoid`, or in VMs without a PMU) are left out and read as 0, and if none
+ * can be opened the counters stay disabled. Child processes are not counted.
+ */
+class PerfCounters {
+   public:
+    enum class Counter { Cycles, Instructions, CacheMisses, ContextSwitches, Count };
+
+    static constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::Count);
+
+    using Values = std::array<uint64_t, COUNTER_COUNT>;
+
+    /**
+     * @brief Retrieves the process-wide counters.
+     */
+    static PerfCounters& getInstance();
+
+    /**
+     * @brief Probes which counters can be opened, warning about the ones that cannot.
+     *
+     * @return false if no counter is available; the counters then stay disabled.
+     */
+    bool enable();
+    void disable();
+
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    bool isAvailable(Counter counter) const;
+
+    /**
+     * @brief Current values of the calling thread's counters, all 0 while disabled.
+     */
+    Values readThread();
+
+    static const char* getCounterName(Counter counter);
+
+   private:
+    PerfCounters() = default;
+
+    std::atomic<bool> m_enabled = false;
+    std::array<std::atomic<bool>, COUNTER_COUNT> m_available{};
+    std::array<std::atomic<bool>, COUNTER_COUNT> m_excludeKernel{};
+};
+
+}  // namespace MediaProcessor
+
+#endif  // PERFCOUNTERS_H
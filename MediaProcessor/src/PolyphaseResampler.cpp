@@ -0,0 +1,198 @@
+#include "PolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "PcmKernels.h"
+
+namespace MediaProcessor {
+
+namespace {
+
+// Taps per phase when upsampling, scaled by the decimation factor when downsampling
+constexpr size_t BASE_TAPS_PER_PHASE = 64;
+constexpr int64_t MAX_PHASES = 1024;
+
+// About 86dB of stopband attenuation. With 64 taps the transition band is about 9% of the lower
+// rate wide, the cutoff places it just below that rate's Nyquist frequency
+constexpr double KAISER_BETA = 8.6;
+constexpr double CUTOFF = 0.91;
+
+double sinc(double x) {
+    if (x == 0.0) {
+        return 1.0;
+    }
+    const double angle = std::numbers::pi * x;
+    return std::sin(angle) / angle;
+}
+
+}  // namespace
+
+PolyphaseResampler::PolyphaseResampler(int inputRate, int outputRate)
+    : m_inputRate(inputRate), m_outputRate(outputRate) {
+    if (inputRate <= 0 || outputRate <= 0) {
+        throw std::runtime_error("Invalid resampling rates " + std::to_string(inputRate) + " -> " +
+                                 std::to_string(outputRate) + ".");
+    }
+    if (!supports(inputRate, outputRate)) {
+        throw std::runtime_error("Unsupported resampling ratio " + std::to_string(inputRate) +
+                                 " -> " + std::to_string(outputRate) + ".");
+    }
+
+    const int64_t divisor = std::gcd(inputRate, outputRate);
+    m_interpolation = outputRate / divisor;
+    m_decimation = inputRate / divisor;
+
+    if (isPassthrough()) {
+        m_tapsPerPhase = 1;
+    } else {
+        const auto decimation = static_cast<size_t>(
+            (m_decimation + m_interpolation - 1) / m_interpolation);
+        m_tapsPerPhase = BASE_TAPS_PER_PHASE * std::max<size_t>(decimation, 1);
+    }
+
+    designFilter();
+    reset();
+}
+
+bool PolyphaseResampler::supports(int inputRate, int outputRate) {
+    if (inputRate <= 0 || outputRate <= 0) {
+        return false;
+    }
+    return outputRate / std::gcd(inputRate, outputRate) <= MAX_PHASES;
+}
+
+void PolyphaseResampler::designFilter() {
+    m_phases.assign(m_tapsPerPhase * m_interpolation, 0.0f);
+    if (isPassthrough()) {
+        m_phases[0] = 1.0f;
+        return;
+    }
+
+    // Cutoff relative to the input rate: its Nyquist frequency when upsampling, the output's
+    // when downsampling, so nothing above the lower rate aliases back
+    const double cutoff =
+        CUTOFF * std::min(1.0, static_cast<double>(m_interpolation) / m_decimation);
+    const int64_t center = static_cast<int64_t>(m_phases.size()) / 2;
+    const double windowNorm = std::cyl_bessel_i(0.0, KAISER_BETA);
+
+    for (int64_t phase = 0; phase < m_interpolation; ++phase) {
+        float* taps = m_phases.data() + phase * m_tapsPerPhase;
+
+        double sum = 0.0;
+        std::vector<double> coefficients(m_tapsPerPhase);
+        for (size_t tap = 0; tap < m_tapsPerPhase; ++tap) {
+            const int64_t n = static_cast<int64_t>(tap) * m_interpolation + phase;
+            const double offset = static_cast<double>(n - center) / center;
+            const double shape = std::sqrt(std::max(0.0, 1.0 - offset * offset));
+            const double window = std::cyl_bessel_i(0.0, KAISER_BETA * shape) / windowNorm;
+            const double time = static_cast<double>(n - center) / m_interpolation;
+            coefficients[tap] = cutoff * sinc(cutoff * time) * window;
+            sum += coefficients[tap];
+        }
+
+        // Unity gain at DC for every phase, so a constant stays exactly constant
+        for (size_t tap = 0; tap < m_tapsPerPhase; ++tap) {
+            taps[m_tapsPerPhase - 1 - tap] = static_cast<float>(coefficients[tap] / sum);
+        }
+    }
+}
+
+void PolyphaseResampler::reset() {
+    // The filter is centered on position L * tapsPerPhase / 2, starting there compensates its
+    // delay; the input before the stream is silence
+    const int64_t delay = static_cast<int64_t>(m_tapsPerPhase) * m_interpolation / 2;
+    m_buffer.assign(m_tapsPerPhase - 1, 0.0f);
+    m_bufferStart = 1 - static_cast<int64_t>(m_tapsPerPhase);
+    m_inputFrames = 0;
+    m_outputFrames = 0;
+    m_inputIndex = delay / m_interpolation;
+    m_phase = delay % m_interpolation;
+}
+
+size_t PolyphaseResampler::process(std::span<const float> input, float* output) {
+    m_buffer.insert(m_buffer.end(), input.begin(), input.end());
+    m_inputFrames += static_cast<int64_t>(input.size());
+
+    const size_t written =
+        emitFrames(m_inputFrames, std::numeric_limits<int64_t>::max(), output);
+
+    // Keep only the input the next output frame still reaches back to
+    const int64_t keepFrom = m_inputIndex + 1 - static_cast<int64_t>(m_tapsPerPhase);
+    const int64_t consumed =
+        std::clamp<int64_t>(keepFrom - m_bufferStart, 0, static_cast<int64_t>(m_buffer.size()));
+    m_buffer.erase(m_buffer.begin(), m_buffer.begin() + consumed);
+    m_bufferStart += consumed;
+
+    return written;
+}
+
+size_t PolyphaseResampler::flush(float* output) {
+    const int64_t totalFrames =
+        (m_inputFrames * m_interpolation + m_decimation - 1) / m_decimation;
+
+    size_t written = 0;
+    if (m_outputFrames < totalFrames) {
+        // Pad with silence up to the last input sample the final frame reaches
+        const int64_t lastPosition =
+            (totalFrames - 1) * m_decimation +
+            static_cast<int64_t>(m_tapsPerPhase) * m_interpolation / 2;
+        const int64_t availableFrames = lastPosition / m_interpolation + 1;
+        m_buffer.resize(static_cast<size_t>(availableFrames - m_bufferStart), 0.0f);
+        written = emitFrames(availableFrames, totalFrames, output);
+    }
+
+    reset();
+    return written;
+}
+
+size_t PolyphaseResampler::emitFrames(int64_t availableFrames, int64_t maxOutputFrames,
+                                      float* output) {
+    const std::span<const float> phases(m_phases);
+    size_t written = 0;
+
+    while (m_inputIndex < availableFrames && m_outputFrames < maxOutputFrames) {
+        const float* window =
+            m_buffer.data() + (m_inputIndex + 1 - static_cast<int64_t>(m_tapsPerPhase)) -
+            m_bufferStart;
+        output[written++] = PcmKernels::dotProduct(
+            phases.subspan(static_cast<size_t>(m_phase) * m_tapsPerPhase, m_tapsPerPhase),
+            window);
+        ++m_outputFrames;
+
+        m_phase += m_decimation;
+        m_inputIndex += m_phase / m_interpolation;
+        m_phase %= m_interpolation;
+    }
+
+    return written;
+}
+
+size_t PolyphaseResampler::getMaxOutputFrames(size_t inputFrames) const {
+    const int64_t totalInput = m_inputFrames + static_cast<int64_t>(inputFrames);
+    const int64_t totalFrames = (totalInput * m_interpolation + m_decimation - 1) / m_decimation;
+    return static_cast<size_t>(std::max<int64_t>(totalFrames - m_outputFrames, 0));
+}
+
+int PolyphaseResampler::getInputRate() const {
+    return m_inputRate;
+}
+
+int PolyphaseResampler::getOutputRate() const {
+    return m_outputRate;
+}
+
+bool PolyphaseResampler::isPassthrough() const {
+    return m_interpolation == m_decimation;
+}
+
+size_t PolyphaseResampler::getTapsPerPhase() const {
+    return m_tapsPerPhase;
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,105 @@
+#ifndef POLYPHASERESAMPLER_H
+#define POLYPHASERESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace MediaProcessor {
+
+/**
+ * @brief Converts the sample rate of a single channel by a rational factor, in streaming blocks.
+ *
+ * The rates are reduced to L/M (160/147 for 44.1kHz -> 48kHz) and the signal is filtered by a
+ * Kaiser-windowed sinc split into L phases, so every output sample is a single dot product of
+ * `getTapsPerPhase()` input samples with one phase, run through `PcmKernels::dotProduct()`.
+ * Blocks can have any size; the output is independent of how the input is split. The filter
+ * delay is compensated, so output frame j lines up with input time j * M / L.
+ */
+class PolyphaseResampler {
+   public:
+    /**
+     * @throws std::runtime_error if a rate is not positive or the ratio is not supported.
+     */
+    PolyphaseResampler(int inputRate, int outputRate);
+
+    /**
+     * @brief Whether the reduced ratio is small enough to keep a table of every phase.
+     *
+     * Coprime rates such as 44099 -> 48000 would need tens of thousands of phases.
+     */
+    static bool supports(int inputRate, int outputRate);
+
+    /**
+     * @brief Resamples the next block of input.
+     *
+     * @param output Room for `getMaxOutputFrames(input.size())` frames.
+     *
+     * @return The number of frames written. Frames that depend on input not seen yet are held
+     *         back until the next call or `flush()`.
+     */
+    size_t process(std::span<const float> input, float* output);
+
+    /**
+     * @brief Writes the frames held back at the end of the stream, then resets the state.
+     *
+     * The total written for a stream is ceil(input frames * L / M).
+     *
+     * @param output Room for `getMaxOutputFrames(0)` frames.
+     */
+    size_t flush(float* output);
+
+    /**
+     * @brief Drops the buffered input, as if a new stream started.
+     */
+    void reset();
+
+    /**
+     * @brief Upper bound of the frames the next `process()` or `flush()` writes.
+     */
+    size_t getMaxOutputFrames(size_t inputFrames) const;
+
+    int getInputRate() const;
+    int getOutputRate() const;
+
+    /**
+     * @brief Whether both rates are equal, the output is then a copy of the input.
+     */
+    bool isPassthrough() const;
+
+    size_t getTapsPerPhase() const;
+
+   private:
+    int m_inputRate;
+    int m_outputRate;
+    int64_t m_interpolation;  // L
+    int64_t m_decimation;     // M
+    size_t m_tapsPerPhase;
+
+    // Phase p holds taps p, p + L, p + 2L, ... of the prototype in reverse, so it is applied to
+    // input samples in chronological order
+    std::vector<float> m_phases;
+
+    // Input not yet consumed, preceded by the `m_tapsPerPhase - 1` samples the next output
+    // still needs; `m_bufferStart` is the stream index of its first sample
+    std::vector<float> m_buffer;
+    int64_t m_bufferStart;
+    int64_t m_inputFrames;
+
+    // Next output frame, as its stream index and its position L * inputIndex + phase
+    int64_t m_outputFrames;
+    int64_t m_inputIndex;
+    int64_t m_phase;
+
+    void designFilter();
+
+    /**
+     * @brief Writes every output frame whose last input sample is below `availableFrames`.
+     */
+    size_t emitFrames(int64_t availableFrames, int64_t maxOutputFrames, float* output);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // POLYPHASERESAMPLER_H
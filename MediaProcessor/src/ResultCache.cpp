@@ -0,0 +1,115 @@
+#include "ResultCache.h"
+
+#include <memory>
+#include <stdexcept>
+
+#include "AudioDecoder.h"
+#include "ConfigManager.h"
+#include "ContentHash.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace MediaProcessor {
+
+namespace {
+
+/**
+ * @brief Hashes the codec parameters and every packet of the audio stream, demuxed only.
+ */
+void hashAudioPackets(ContentHash& hash, const MediaInfo& mediaInfo) {
+    AVFormatContext* formatContext = nullptr;
+    if (avformat_open_input(&formatContext, mediaInfo.path.c_str(), nullptr, nullptr) < 0) {
+        throw std::runtime_error("Could not open " + mediaInfo.path.string());
+    }
+    std::unique_ptr<AVFormatContext*, void (*)(AVFormatContext**)> formatGuard(
+        &formatContext, avformat_close_input);
+
+    const int streamIndex = mediaInfo.audioStreamIndex;
+    if (streamIndex < 0 || static_cast<unsigned int>(streamIndex) >= formatContext->nb_streams) {
+        throw std::runtime_error("No audio stream found in " + mediaInfo.path.string());
+    }
+
+    // The demuxer skips the packets of the other streams, most of the bytes of a video
+    for (unsigned int i = 0; i < formatContext->nb_streams; ++i) {
+        if (static_cast<int>(i) != streamIndex) {
+            formatContext->streams[i]->discard = AVDISCARD_ALL;
+        }
+    }
+
+    const AVCodecParameters* parameters = formatContext->streams[streamIndex]->codecpar;
+    hash.updateValue(static_cast<int>(parameters->codec_id));
+    hash.updateValue(parameters->sample_rate);
+    hash.updateValue(parameters->ch_layout.nb_channels);
+    hash.updateValue(parameters->extradata_size);
+    if (parameters->extradata_size > 0) {
+        hash.update(parameters->extradata, static_cast<size_t>(parameters->extradata_size));
+    }
+
+    std::unique_ptr<AVPacket, void (*)(AVPacket*)> packet(av_packet_alloc(), [](AVPacket* p) {
+        av_packet_free(&p);
+    });
+    if (!packet) {
+        throw std::runtime_error("Could not allocate packet.");
+    }
+
+    int ret;
+    while ((ret = av_read_frame(formatContext, packet.get())) >= 0) {
+        if (packet->stream_index == streamIndex) {
+            hash.updateValue(packet->size);
+            hash.update(packet->data, static_cast<size_t>(packet->size));
+        }
+        av_packet_unref(packet.get());
+    }
+    if (ret != AVERROR_EOF) {
+        throw std::runtime_error("Could not read " + mediaInfo.path.string());
+    }
+}
+
+}  // namespace
+
+ResultCache::ResultCache(const fs::path& directory, uintmax_t maxSize)
+    : m_diskCache(directory, maxSize) {}
+
+std::string ResultCache::computeKey(const MediaInfo& mediaInfo) {
+    const ConfigManager& configManager = ConfigManager::getInstance();
+
+    ContentHash hash;
+    hash.updateValue(RESULT_CACHE_VERSION);
+    hash.updateValue(configManager.getFilterAttenuationLimit());
+    hash.updateValue(configManager.getFilterPostFilterBeta());
+
+    // The model is identified by its file, a replaced tarball invalidates the results
+    hash.updateFileIdentity(configManager.getDeepFilterTarballPath());
+
+    // A multi-channel result must not be served for a mono run
+    hash.updateValue(static_cast<int>(configManager.getAudioChannelMode()));
+    hash.updateValue(configManager.getRestoreSourceSampleRate());
+
+    hashAudioPackets(hash, mediaInfo);
+    return hash.finalize();
+}
+
+bool ResultCache::restore(const std::string& key, const fs::path& outputAudioPath) {
+    return m_diskCache.retrieve(key, outputAudioPath);
+}
+
+std::optional<fs::path> ResultCache::find(const std::string& key) {
+    return m_diskCache.lookup(key);
+}
+
+bool ResultCache::store(const std::string& key, const fs::path& processedAudioPath) {
+    return m_diskCache.store(key, processedAudioPath);
+}
+
+fs::path ResultCache::getStagingPath(const std::string& key) const {
+    return m_diskCache.getStagingPath(key);
+}
+
+bool ResultCache::commit(const std::string& key, const fs::path& stagingPath) {
+    return m_diskCache.commit(key, stagingPath);
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,82 @@
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "DiskCache.h"
+#include "MediaInfo.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+// Bumped whenever a change to the processing makes cached results stale
+constexpr int RESULT_CACHE_VERSION = 2;
+
+/**
+ * @brief Reuses the processed audio of inputs that were processed before with the same settings.
+ *
+ * Results are keyed by the compressed packets of the audio stream rather than the file, so
+ * re-uploads and remuxed containers of the same audio hit the cache; re-encoded audio does not.
+ * The key also covers the filter settings and the model, but not the work unit layout, which
+ * only changes the output at unit boundaries.
+ */
+class ResultCache {
+   public:
+    /**
+     * @throws std::runtime_error if the cache directory cannot be created.
+     */
+    ResultCache(const fs::path& directory, uintmax_t maxSize);
+
+    /**
+     * @brief Hashes the audio packets of `mediaInfo` with the current filter settings and model.
+     *
+     * Reads the input once more before it is processed, but only demuxes it: nothing is decoded
+     * or resampled.
+     *
+     * @throws std::runtime_error if the audio cannot be read or the settings are invalid.
+     */
+    static std::string computeKey(const MediaInfo& mediaInfo);
+
+    /**
+     * @brief Places the cached result for `key` at `outputAudioPath`.
+     *
+     * @return false on a miss.
+     */
+    bool restore(const std::string& key, const fs::path& outputAudioPath);
+
+    /**
+     * @brief Path of the cached result for `key`, to be read in place.
+     *
+     * @return The cached audio, or std::nullopt on a miss.
+     */
+    std::optional<fs::path> find(const std::string& key);
+
+    /**
+     * @brief Caches the processed audio for `key`, evicting the least recently used results.
+     *
+     * @return true if the result was stored.
+     */
+    bool store(const std::string& key, const fs::path& processedAudioPath);
+
+    /**
+     * @brief Path to write the result for `key` to while it is processed, see `commit()`.
+     */
+    fs::path getStagingPath(const std::string& key) const;
+
+    /**
+     * @brief Caches the result written to `getStagingPath(key)`, or removes it if it cannot be.
+     *
+     * @return true if the result was stored.
+     */
+    bool commit(const std::string& key, const fs::path& stagingPath);
+
+   private:
+    DiskCache m_diskCache;
+};
+
+}  // namespace MediaProcessor
+
+#endif  // RESULTCACHE_H
@@ -0,0 +1,197 @@
+#include "SignalGenerator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace MediaProcessor {
+
+namespace {
+
+constexpr double TWO_PI = 2.0 * std::numbers::pi;
+
+constexpr double SPEECH_GAIN = 0.6;
+constexpr double MUSIC_GAIN = 0.3;
+
+// First and second formants of /a/, /e/, /i/, /o/, /u/ in Hz
+constexpr std::array<std::array<double, 2>, 5> VOWEL_FORMANTS = {
+    {{730.0, 1090.0}, {530.0, 1840.0}, {270.0, 2290.0}, {570.0, 840.0}, {300.0, 870.0}}};
+
+constexpr double BEATS_PER_SECOND = 2.0;  // 120 BPM
+constexpr size_t BEATS_PER_CHORD = 4;
+
+// Root note of each chord in Hz, and whether its third is minor
+constexpr std::array<double, 4> CHORD_ROOTS = {261.63, 220.00, 174.61, 196.00};  // C Am F G
+constexpr std::array<bool, 4> CHORD_IS_MINOR = {false, true, false, false};
+constexpr std::array<double, 3> NOTE_PANS = {-0.6, 0.0, 0.6};
+
+}  // namespace
+
+void SignalGenerator::Resonator::tune(double frequency, double bandwidth, int sampleRate) {
+    const double radius = std::exp(-std::numbers::pi * bandwidth / sampleRate);
+    const double omega = TWO_PI * frequency / sampleRate;
+    a1 = -2.0 * radius * std::cos(omega);
+    a2 = radius * radius;
+
+    // Unity gain at the resonance frequency
+    b0 = (1.0 - radius) * std::sqrt(1.0 - 2.0 * radius * std::cos(2.0 * omega) + a2);
+}
+
+double SignalGenerator::Resonator::process(double input) {
+    const double output = b0 * input - a1 * y1 - a2 * y2;
+    y2 = y1;
+    y1 = output;
+    return output;
+}
+
+SignalGenerator::SignalGenerator(int sampleRate, int channels, uint32_t seed)
+    : m_sampleRate(sampleRate), m_channels(std::max(channels, 1)), m_random(seed) {}
+
+int SignalGenerator::getDialogueChannel(int channels) {
+    return channels >= 3 ? 2 : -1;
+}
+
+void SignalGenerator::generate(float* output, size_t numFrames) {
+    const int dialogueChannel = getDialogueChannel(m_channels);
+    const bool hasLfe = m_channels >= 4;
+
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        const double speech = SPEECH_GAIN * nextSpeechSample();
+        const MusicSample music = nextMusicSample();
+        float* samples = output + frame * m_channels;
+
+        if (m_channels == 1) {
+            samples[0] = static_cast<float>(speech + MUSIC_GAIN * (music.left + music.right) / 2);
+            continue;
+        }
+
+        for (int channel = 0; channel < m_channels; ++channel) {
+            double sample;
+            if (channel == dialogueChannel) {
+                sample = speech;
+            } else if (channel == 3 && hasLfe) {
+                sample = MUSIC_GAIN * music.low;
+            } else {
+                // Front pair at full level, surrounds as quieter ambience
+                const double gain = channel < 2 ? MUSIC_GAIN : MUSIC_GAIN / 2;
+                sample = gain * (channel % 2 == 0 ? music.left : music.right);
+                if (dialogueChannel < 0) {
+                    sample += speech * std::numbers::sqrt2 / 2;
+                }
+            }
+            samples[channel] = static_cast<float>(sample);
+        }
+    }
+}
+
+double SignalGenerator::nextSpeechSample() {
+    if (m_segmentRemaining == 0) {
+        startSpeechSegment();
+    }
+    --m_segmentRemaining;
+    if (!m_voiced) {
+        return 0.0;
+    }
+
+    // Raised-cosine attack and release over 20ms each
+    const double position = static_cast<double>(m_segmentLength - m_segmentRemaining);
+    const double rampLength = 0.02 * m_sampleRate;
+    const double ramp = std::min(
+        {1.0, position / rampLength, static_cast<double>(m_segmentRemaining) / rampLength});
+    const double envelope = 0.5 - 0.5 * std::cos(std::numbers::pi * ramp);
+
+    // Sawtooth glottal source with a slowly falling pitch, as in a declarative sentence
+    m_pitch = std::max(90.0, m_pitch - 8.0 / m_sampleRate);
+    m_glottalPhase += m_pitch / m_sampleRate;
+    m_glottalPhase -= std::floor(m_glottalPhase);
+    double source = 1.0 - 2.0 * m_glottalPhase;
+
+    // A fricative onset replaces the first 60ms of the syllable with high-passed noise
+    const double noise = m_noise(m_random);
+    if (m_fricative && position < 0.06 * m_sampleRate) {
+        source = 0.6 * (noise - m_previousNoise);
+    }
+    m_previousNoise = noise;
+
+    const double voice = m_firstFormant.process(source) + 0.6 * m_secondFormant.process(source);
+    return envelope * voice;
+}
+
+void SignalGenerator::startSpeechSegment() {
+    auto seconds = [this](double low, double high) {
+        return static_cast<size_t>(std::uniform_real_distribution<double>(low, high)(m_random) *
+                                   m_sampleRate);
+    };
+
+    // A pause follows every word, and a longer one every sentence
+    if (m_voiced && m_syllablesLeftInWord == 0) {
+        m_voiced = false;
+        m_segmentLength = m_wordsLeftInSentence == 0 ? seconds(0.4, 0.9) : seconds(0.08, 0.2);
+        m_segmentRemaining = m_segmentLength;
+        return;
+    }
+
+    if (m_wordsLeftInSentence == 0) {
+        m_wordsLeftInSentence = std::uniform_int_distribution<int>(6, 12)(m_random);
+        m_pitch = std::uniform_real_distribution<double>(140.0, 220.0)(m_random);
+    }
+    if (m_syllablesLeftInWord == 0) {
+        m_syllablesLeftInWord = std::uniform_int_distribution<int>(1, 4)(m_random);
+        --m_wordsLeftInSentence;
+    }
+    --m_syllablesLeftInWord;
+
+    const auto& formants = VOWEL_FORMANTS[std::uniform_int_distribution<size_t>(
+        0, VOWEL_FORMANTS.size() - 1)(m_random)];
+    m_firstFormant.tune(formants[0], 80.0, m_sampleRate);
+    m_secondFormant.tune(formants[1], 120.0, m_sampleRate);
+    m_fricative = std::bernoulli_distribution(0.3)(m_random);
+
+    m_voiced = true;
+    m_segmentLength = seconds(0.12, 0.28);
+    m_segmentRemaining = m_segmentLength;
+}
+
+SignalGenerator::MusicSample SignalGenerator::nextMusicSample() {
+    const double time = static_cast<double>(m_frameIndex++) / m_sampleRate;
+    const double beats = time * BEATS_PER_SECOND;
+    const size_t beat = static_cast<size_t>(beats);
+    const double sinceBeat = (beats - beat) / BEATS_PER_SECOND;  // seconds
+
+    const size_t chord = (beat / BEATS_PER_CHORD) % CHORD_ROOTS.size();
+    const double root = CHORD_ROOTS[chord];
+    const std::array<double, 3> notes = {root, root * (CHORD_IS_MINOR[chord] ? 1.1892 : 1.2599),
+                                         root * 1.4983};
+
+    MusicSample sample = {0.0, 0.0, 0.0};
+    for (size_t i = 0; i < notes.size(); ++i) {
+        m_notePhases[i] += notes[i] / m_sampleRate;
+        m_notePhases[i] -= std::floor(m_notePhases[i]);
+        const double phase = TWO_PI * m_notePhases[i];
+        const double tone =
+            (std::sin(phase) + 0.5 * std::sin(2 * phase) + 0.25 * std::sin(3 * phase)) / 3.0;
+        sample.left += tone * (1.0 - NOTE_PANS[i]) / 2.0;
+        sample.right += tone * (1.0 + NOTE_PANS[i]) / 2.0;
+    }
+
+    m_bassPhase += root / 2.0 / m_sampleRate;
+    m_bassPhase -= std::floor(m_bassPhase);
+    sample.low = 0.4 * std::sin(TWO_PI * m_bassPhase);
+
+    // Kick drum on every beat, a sine sweeping down from 120Hz to 50Hz
+    const double kickFrequency = 50.0 + 70.0 * std::exp(-sinceBeat * 30.0);
+    m_kickPhase += kickFrequency / m_sampleRate;
+    m_kickPhase -= std::floor(m_kickPhase);
+    sample.low += 0.8 * std::exp(-sinceBeat * 12.0) * std::sin(TWO_PI * m_kickPhase);
+
+    // Hi-hat on the off-beats
+    const double sinceOffBeat = sinceBeat - 0.5 / BEATS_PER_SECOND;
+    const double hiHat =
+        sinceOffBeat >= 0.0 ? 0.15 * std::exp(-sinceOffBeat * 60.0) * m_noise(m_random) : 0.0;
+
+    sample.left += sample.low + hiHat;
+    sample.right += sample.low + hiHat;
+    return sample;
+}
+
+}  // namespace MediaProcessor
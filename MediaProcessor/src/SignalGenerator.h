@@ -0,0 +1,85 @@
+#ifndef SIGNALGENERATOR_H
+#define SIGNALGENERATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace MediaProcessor {
+
+constexpr uint32_t DEFAULT_SIGNAL_SEED = 42;
+
+/**
+ * @brief Synthesizes endless speech-plus-music test signals for load and scaling tests.
+ *
+ * Speech is a glottal pulse train shaped by two formant resonators, cut into syllables, words
+ * and sentences with pauses in between. Music is a four-chord progression with bass, kick drum
+ * and hi-hats at 120 BPM. The signal is deterministic for a given seed and independent of the
+ * block sizes it is generated in, so any duration can be reproduced without storing it.
+ *
+ * Channels follow the WAVE order (FL, FR, FC, LFE, BL, BR, ...). Mono mixes everything, stereo
+ * puts speech in the phantom center, and with three or more channels speech is on FC only, as
+ * dialogue is in film and TV mixes.
+ */
+class SignalGenerator {
+   public:
+    SignalGenerator(int sampleRate, int channels, uint32_t seed = DEFAULT_SIGNAL_SEED);
+
+    /**
+     * @brief Writes the next `numFrames` interleaved frames to `output`.
+     */
+    void generate(float* output, size_t numFrames);
+
+    /**
+     * @brief Channel carrying the speech alone, or -1 if speech is mixed into every channel.
+     */
+    static int getDialogueChannel(int channels);
+
+   private:
+    struct Resonator {
+        double b0 = 0.0, a1 = 0.0, a2 = 0.0;
+        double y1 = 0.0, y2 = 0.0;
+
+        void tune(double frequency, double bandwidth, int sampleRate);
+        double process(double input);
+    };
+
+    struct MusicSample {
+        double left;
+        double right;
+        double low;  // bass and kick, also sent to the LFE channel
+    };
+
+    int m_sampleRate;
+    int m_channels;
+    std::mt19937 m_random;
+    std::uniform_real_distribution<double> m_noise{-1.0, 1.0};
+
+    // Speech
+    size_t m_segmentRemaining = 0;  // samples left in the current syllable or pause
+    size_t m_segmentLength = 0;
+    bool m_voiced = false;
+    bool m_fricative = false;
+    int m_syllablesLeftInWord = 0;
+    int m_wordsLeftInSentence = 0;
+    double m_pitch = 160.0;
+    double m_glottalPhase = 0.0;
+    double m_previousNoise = 0.0;
+    Resonator m_firstFormant;
+    Resonator m_secondFormant;
+
+    // Music
+    uint64_t m_frameIndex = 0;
+    std::array<double, 3> m_notePhases{};
+    double m_bassPhase = 0.0;
+    double m_kickPhase = 0.0;
+
+    double nextSpeechSample();
+    MusicSample nextMusicSample();
+    void startSpeechSegment();
+};
+
+}  // namespace MediaProcessor
+
+#endif  // SIGNALGENERATOR_H
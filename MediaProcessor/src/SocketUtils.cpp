@@ -0,0 +1,232 @@
+#include "SocketUtils.h"
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace MediaProcessor::SocketUtils {
+
+namespace {
+
+using AddressList = std::unique_ptr<addrinfo, decltype(&freeaddrinfo)>;
+
+AddressList resolve(const Endpoint& endpoint, int flags) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = flags;
+
+    addrinfo* addresses = nullptr;
+    const std::string port = std::to_string(endpoint.port);
+    int ret = getaddrinfo(endpoint.host.empty() ? nullptr : endpoint.host.c_str(), port.c_str(),
+                          &hints, &addresses);
+    if (ret != 0) {
+        throw std::runtime_error("Could not resolve " + endpoint.toString() + ": " +
+                                 gai_strerror(ret));
+    }
+    return AddressList(addresses, freeaddrinfo);
+}
+
+bool writeFramed(int fd, const void* data, size_t size) {
+    if (size > MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    std::array<unsigned char, 4> header = {
+        static_cast<unsigned char>(size >> 24), static_cast<unsigned char>(size >> 16),
+        static_cast<unsigned char>(size >> 8), static_cast<unsigned char>(size)};
+
+    return writeAll(fd, header.data(), header.size()) && writeAll(fd, data, size);
+}
+
+}  // namespace
+
+std::string Endpoint::toString() const {
+    return host + ":" + std::to_string(port);
+}
+
+Endpoint parseEndpoint(std::string_view endpoint, std::string_view defaultHost) {
+    Endpoint result{std::string(defaultHost), 0};
+    std::string_view port = endpoint;
+
+    size_t separator = endpoint.rfind(':');
+    if (separator != std::string_view::npos) {
+        result.host = endpoint.substr(0, separator);
+        port = endpoint.substr(separator + 1);
+
+        // IPv6 addresses are written in brackets, "[::1]:9000"
+        if (result.host.size() >= 2 && result.host.front() == '[' && result.host.back() == ']') {
+            result.host = result.host.substr(1, result.host.size() - 2);
+        }
+
+        // An empty host would bind every interface, that must be asked for explicitly
+        if (result.host.empty()) {
+            result.host = defaultHost;
+        }
+    }
+
+    auto [end, error] = std::from_chars(port.data(), port.data() + port.size(), result.port);
+    if (port.empty() || error != std::errc() || end != port.data() + port.size()) {
+        throw std::runtime_error("Invalid endpoint '" + std::string(endpoint) +
+                                 "', expected [host:]port.");
+    }
+    return result;
+}
+
+int listenTcp(const Endpoint& endpoint) {
+    AddressList addresses = resolve(endpoint, AI_PASSIVE);
+    std::string error = "no usable address";
+
+    for (addrinfo* address = addresses.get(); address; address = address->ai_next) {
+        int fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC,
+                        address->ai_protocol);
+        if (fd < 0) {
+            error = strerror(errno);
+            continue;
+        }
+
+        // Lets a restarted worker bind while connections of the previous one linger
+        int enable = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        if (bind(fd, address->ai_addr, address->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0) {
+            return fd;
+        }
+        error = strerror(errno);
+        close(fd);
+    }
+
+    throw std::runtime_error("Could not listen on " + endpoint.toString() + ": " + error);
+}
+
+uint16_t getLocalPort(int fd) {
+    sockaddr_storage address{};
+    socklen_t length = sizeof(address);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) < 0) {
+        return 0;
+    }
+    if (address.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<sockaddr_in6*>(&address)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<sockaddr_in*>(&address)->sin_port);
+}
+
+int connectTcp(const Endpoint& endpoint, std::chrono::seconds timeout) {
+    AddressList addresses(nullptr, freeaddrinfo);
+    try {
+        addresses = resolve(endpoint, 0);
+    } catch (const std::runtime_error&) {
+        return -1;
+    }
+
+    for (addrinfo* address = addresses.get(); address; address = address->ai_next) {
+        int fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC,
+                        address->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        if (timeout.count() > 0) {
+            timeval interval{static_cast<time_t>(timeout.count()), 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &interval, sizeof(interval));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &interval, sizeof(interval));
+        }
+
+        if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+            // Requests are small headers followed by a payload, don't hold them back
+            int enable = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+            return fd;
+        }
+        close(fd);
+    }
+
+    return -1;
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        // MSG_NOSIGNAL turns a closed peer into EPIPE instead of killing the process
+        ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0 && errno == ENOTSOCK) {
+            written = write(fd, bytes, size);
+        }
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return true;
+}
+
+bool readAll(int fd, void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t bytesRead = read(fd, bytes, size);
+        if (bytesRead < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytesRead <= 0) {
+            return false;
+        }
+        bytes += bytesRead;
+        size -= bytesRead;
+    }
+    return true;
+}
+
+bool writeMessage(int fd, const std::string& message) {
+    return writeFramed(fd, message.data(), message.size());
+}
+
+std::optional<std::string> readMessage(int fd) {
+    std::array<unsigned char, 4> header;
+    if (!readAll(fd, header.data(), header.size())) {
+        return std::nullopt;
+    }
+
+    const uint32_t size = (static_cast<uint32_t>(header[0]) << 24) |
+                          (static_cast<uint32_t>(header[1]) << 16) |
+                          (static_cast<uint32_t>(header[2]) << 8) | header[3];
+    if (size > MAX_MESSAGE_SIZE) {
+        return std::nullopt;
+    }
+
+    std::string message(size, '\0');
+    if (!readAll(fd, message.data(), message.size())) {
+        return std::nullopt;
+    }
+    return message;
+}
+
+bool writeSamples(int fd, std::span<const float> samples) {
+    return writeFramed(fd, samples.data(), samples.size_bytes());
+}
+
+std::optional<std::vector<float>> readSamples(int fd) {
+    auto message = readMessage(fd);
+    if (!message || message->size() % sizeof(float) != 0) {
+        return std::nullopt;
+    }
+
+    std::vector<float> samples(message->size() / sizeof(float));
+    std::memcpy(samples.data(), message->data(), message->size());
+    return samples;
+}
+
+}  // namespace MediaProcessor::SocketUtils
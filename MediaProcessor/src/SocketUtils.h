@@ -0,0 +1,102 @@
+#ifndef SOCKETUTILS_H
+#define SOCKETUTILS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace MediaProcessor::SocketUtils {
+
+/**
+ * @brief Largest message accepted by `readMessage()`.
+ */
+constexpr uint32_t MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+/**
+ * @brief Host and TCP port of a remote peer.
+ */
+struct Endpoint {
+    std::string host;
+    uint16_t port = 0;
+
+    std::string toString() const;
+};
+
+/**
+ * @brief Parses "host:port", or just "port" or ":port" which use `defaultHost`.
+ *
+ * @throws std::runtime_error if the port is missing or not within [0, 65535].
+ */
+Endpoint parseEndpoint(std::string_view endpoint, std::string_view defaultHost);
+
+/**
+ * @brief Binds a listening TCP socket on the addresses of `endpoint.host`, port 0 picks a free
+ *        port.
+ *
+ * @throws std::runtime_error if the host cannot be resolved or the socket cannot be bound.
+ */
+int listenTcp(const Endpoint& endpoint);
+
+/**
+ * @brief Port a bound socket listens on.
+ */
+uint16_t getLocalPort(int fd);
+
+/**
+ * @brief Connects to a TCP endpoint with Nagle's algorithm disabled.
+ *
+ * @param timeout Applied to the connection's reads and writes, 0 for none.
+ *
+ * @return The connected socket, or -1 if the endpoint is unreachable.
+ */
+int connectTcp(const Endpoint& endpoint, std::chrono::seconds timeout);
+
+/**
+ * @brief Writes a message framed by its length as a 4-byte big-endian prefix.
+ *
+ * @return true if the whole message was written, false otherwise.
+ */
+bool writeMessage(int fd, const std::string& message);
+
+/**
+ * @brief Reads a message written by `writeMessage()`.
+ *
+ * @return The message, or std::nullopt on end of stream, on error, or if the announced length
+ *         exceeds `MAX_MESSAGE_SIZE`.
+ */
+std::optional<std::string> readMessage(int fd);
+
+/**
+ * @brief Writes PCM samples as a single message, in host byte order.
+ *
+ * @return true if the whole message was written, false otherwise.
+ */
+bool writeSamples(int fd, std::span<const float> samples);
+
+/**
+ * @brief Reads PCM samples written by `writeSamples()`.
+ *
+ * @return The samples, or std::nullopt if no well-formed message could be read.
+ */
+std::optional<std::vector<float>> readSamples(int fd);
+
+/**
+ * @brief Writes exactly `size` bytes, retrying on partial writes and interrupts.
+ */
+bool writeAll(int fd, const void* data, size_t size);
+
+/**
+ * @brief Reads exactly `size` bytes, retrying on partial reads and interrupts.
+ *
+ * @return false on end of stream or error.
+ */
+bool readAll(int fd, void* data, size_t size);
+
+}  // namespace MediaProcessor::SocketUtils
+
+#endif  // SOCKETUTILS_H
@@ -0,0 +1,106 @@
+#include "Tracer.h"
+
+#include <unistd.h>
+
+#include <fstream>
+
+namespace MediaProcessor {
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::enable() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_epoch == Clock::time_point()) {
+        m_epoch = Clock::now();
+    }
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::record(const char* name, Clock::time_point start, Clock::time_point end,
+                    const char* argName, int64_t argValue) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({name, argName, argValue, start, end});
+}
+
+size_t Tracer::getEventCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t count = 0;
+    for (const auto& buffer : m_threadBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        count += buffer->events.size();
+    }
+    return count;
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& buffer : m_threadBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->events.clear();
+    }
+}
+
+nlohmann::json Tracer::toChromeTrace() const {
+    using Microseconds = std::chrono::duration<double, std::micro>;
+    const int pid = getpid();
+
+    nlohmann::json events = nlohmann::json::array();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& buffer : m_threadBuffers) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        if (buffer->events.empty()) {
+            continue;
+        }
+
+        events.push_back({{"name", "thread_name"},
+                          {"ph", "M"},
+                          {"pid", pid},
+                          {"tid", buffer->threadId},
+                          {"args", {{"name", "thread " + std::to_string(buffer->threadId)}}}});
+
+        // Complete events, one per span
+        for (const Event& event : buffer->events) {
+            nlohmann::json traceEvent = {
+                {"name", event.name},
+                {"ph", "X"},
+                {"pid", pid},
+                {"tid", buffer->threadId},
+                {"ts", Microseconds(event.start - m_epoch).count()},
+                {"dur", Microseconds(event.end - event.start).count()}};
+            if (event.argName) {
+                traceEvent["args"] = {{event.argName, event.argValue}};
+            }
+            events.push_back(std::move(traceEvent));
+        }
+    }
+
+    return {{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+}
+
+bool Tracer::writeChromeTrace(const fs::path& tracePath) const {
+    std::ofstream file(tracePath);
+    file << toChromeTrace().dump() << std::endl;
+    return static_cast<bool>(file);
+}
+
+Tracer::ThreadBuffer& Tracer::getThreadBuffer() {
+    // Registered on the first span of each thread, later spans skip the tracer's lock
+    thread_local ThreadBuffer* threadBuffer = nullptr;
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& buffer = m_threadBuffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buffer->threadId = static_cast<uint32_t>(m_threadBuffers.size());
+        threadBuffer = buffer.get();
+    }
+    return *threadBuffer;
+}
+
+}  // namespace MediaProcessor
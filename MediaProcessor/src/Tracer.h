@@ -0,0 +1,143 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Process-wide recorder of timed spans, exported as Chrome trace-event JSON.
+ *
+ * Spans are recorded by `TRACE_SCOPE` into per-thread buffers, so worker threads never contend
+ * on a shared lock. The export loads into chrome://tracing or https://ui.perfetto.dev with one
+ * track per thread. While tracing is disabled, a span costs a single relaxed atomic load.
+ */
+class Tracer {
+   public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Retrieves the process-wide tracer.
+     */
+    static Tracer& getInstance();
+
+    /**
+     * @brief Starts recording; timestamps are relative to the first call.
+     */
+    void enable();
+    void disable();
+
+    bool isEnabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Records a completed span on the calling thread.
+     *
+     * `name` and `argName` must be string literals or otherwise outlive the tracer, they are not
+     * copied. `argName` may be nullptr if the span has no argument.
+     */
+    void record(const char* name, Clock::time_point start, Clock::time_point end,
+                const char* argName = nullptr, int64_t argValue = 0);
+
+    /**
+     * @brief Number of spans recorded across all threads.
+     */
+    size_t getEventCount() const;
+
+    /**
+     * @brief Discards the recorded spans.
+     */
+    void clear();
+
+    /**
+     * @brief Recorded spans as a Chrome trace-event document.
+     */
+    nlohmann::json toChromeTrace() const;
+
+    /**
+     * @brief Writes `toChromeTrace()` to `tracePath`.
+     *
+     * @return false if the file cannot be written.
+     */
+    bool writeChromeTrace(const fs::path& tracePath) const;
+
+   private:
+    struct Event {
+        const char* name;
+        const char* argName;
+        int64_t argValue;
+        Clock::time_point start;
+        Clock::time_point end;
+    };
+
+    // Owned by the tracer so that spans outlive the threads that recorded them
+    struct ThreadBuffer {
+        uint32_t threadId;
+        std::mutex mutex;  // only contended while exporting
+        std::vector<Event> events;
+    };
+
+    Tracer() = default;
+
+    ThreadBuffer& getThreadBuffer();
+
+    std::atomic<bool> m_enabled = false;
+    Clock::time_point m_epoch;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a span, if tracing is enabled when it starts.
+ */
+class TraceScope {
+   public:
+    explicit TraceScope(const char* name, const char* argName = nullptr, int64_t argValue = 0)
+        : m_name(Tracer::getInstance().isEnabled() ? name : nullptr),
+          m_argName(argName),
+          m_argValue(argValue) {
+        if (m_name) {
+            m_start = Tracer::Clock::now();
+        }
+    }
+
+    ~TraceScope() {
+        if (m_name) {
+            Tracer::getInstance().record(m_name, m_start, Tracer::Clock::now(), m_argName,
+                                         m_argValue);
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+   private:
+    const char* m_name;
+    const char* m_argName;
+    int64_t m_argValue;
+    Tracer::Clock::time_point m_start;
+};
+
+}  // namespace MediaProcessor
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+/**
+ * @brief Traces the enclosing scope, optionally with one numeric argument:
+ *        `TRACE_SCOPE("filter unit", "unit", unitIndex);`
+ */
+#define TRACE_SCOPE(...) \
+    ::MediaProcessor::TraceScope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+
+#endif  // TRACER_H
@@ -1,7 +1,5 @@
 #include "Utils.h"
 
-#include <array>
-#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -10,59 +8,40 @@
 #include <string_view>
 
 #include "CommandBuilder.h"
+#include "CommandRunner.h"
 #include "FFmpegSettingsManager.h"
 
 namespace MediaProcessor::Utils {
 
-bool runCommand(const std::string& command) {
-    std::array<char, 128> buffer;
-    std::string result;
-    std::string fullCommand = command + " 2>&1";  // Redirect stderr to stdout
-    FILE* pipe = popen(fullCommand.c_str(), "r");
-    if (!pipe) {
-        std::cerr << "Error: Failed to run command: " << command << std::endl;
-        return false;
-    }
-
-    while (fgets(buffer.data(), buffer.size(), pipe) != nullptr) {
-        result += buffer.data();
-    }
+namespace {
 
-    int returnCode = pclose(pipe);
-    if (returnCode != 0) {
-        std::cerr << "Command failed with return code " << returnCode << ":" << std::endl;
-        std::cerr << result << std::endl;
-        return false;
+std::optional<CommandRunner::CommandResult> runAndReport(const ICommandBuilder& command) {
+    try {
+        CommandRunner::CommandResult result = CommandRunner::run(command.buildArgv());
+        if (!result.succeeded()) {
+            std::cerr << "Command failed with return code " << result.exitCode << ":" << std::endl;
+            std::cerr << result.standardOutput << result.standardError << std::endl;
+            return std::nullopt;
+        }
+        return result;
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Error: Failed to run command: " << ex.what() << std::endl;
+        return std::nullopt;
     }
-    return true;
 }
 
-std::optional<std::string> runCommand(const std::string& command, bool captureOutput) {
-    if (!captureOutput) {
-        return runCommand(command) ? std::optional<std::string>{} : std::nullopt;
-    }
+}  // namespace
 
-    std::array<char, 128> buffer;
-    std::string result;
-    auto pipe = std::unique_ptr<FILE, decltype(&pclose)>(popen(command.c_str(), "r"), pclose);
-
-    if (!pipe) {
-        std::cerr << "Error: Failed to run command: " << command << std::endl;
-        return std::nullopt;
-    }
-
-    while (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-        result += buffer.data();
-    }
+bool runCommand(const ICommandBuilder& command) {
+    return runAndReport(command).has_value();
+}
 
-    int returnCode = pclose(pipe.release());
-    if (returnCode != 0) {
-        std::cerr << "Command failed with return code " << returnCode << ":" << std::endl;
-        std::cerr << result << std::endl;
+std::optional<std::string> runCommand(const ICommandBuilder& command, bool captureOutput) {
+    std::optional<CommandRunner::CommandResult> result = runAndReport(command);
+    if (!result || !captureOutput || result->standardOutput.empty()) {
         return std::nullopt;
     }
-
-    return result.empty() ? std::nullopt : std::make_optional(result);
+    return result->standardOutput;
 }
 
 std::pair<std::filesystem::path, std::filesystem::path> prepareOutputPaths(
@@ -110,36 +89,6 @@ std::string trimTrailingSpace(const std::string& str) {
     return str.substr(0, str.size() - 1);
 }
 
-double getMediaDuration(const fs::path& mediaPath) {
-    // Prepare ffprobe command
-    CommandBuilder cmd;
-    cmd.addArgument("ffprobe");
-    cmd.addFlag("-v", "error");
-    cmd.addFlag("-show_entries", "format=duration");
-    cmd.addFlag("-of", "default=noprint_wrappers=1:nokey=1");
-    cmd.addArgument(mediaPath.string());
-
-    FILE* pipe = popen(cmd.build().c_str(), "r");
-    if (!pipe) {
-        std::cerr << "Error: Failed to run ffprobe to get media duration." << std::endl;
-        return -1;
-    }
-
-    char buffer[128];
-    std::string result;
-    while (fgets(buffer, sizeof buffer, pipe) != nullptr) {
-        result += buffer;
-    }
-    pclose(pipe);
-
-    try {
-        return std::stod(result);
-    } catch (const std::exception& e) {
-        std::cerr << "Error: Could not parse media duration." << std::endl;
-        return -1;
-    }
-}
-
 template <typename T>
 std::string enumToString(const T& value, const std::unordered_map<T, std::string>& valueMap) {
     auto it = valueMap.find(value);
@@ -10,6 +10,10 @@
 
 namespace fs = std::filesystem;
 
+namespace MediaProcessor {
+class ICommandBuilder;
+}
+
 namespace MediaProcessor::Utils {
 
 /**
@@ -26,20 +30,22 @@ namespace MediaProcessor::Utils {
     }())
 
 /**
- * @brief Executes a command in the system shell.
+ * @brief Executes a command directly, without a shell.
+ *
+ * The command's output is printed only if it fails.
  *
  * @return true if the command executes successfully, false otherwise.
  */
-bool runCommand(const std::string& command);
+bool runCommand(const ICommandBuilder& command);
 
 /**
- * @brief Executes a shell command and optionally returns its output
+ * @brief Executes a command and optionally returns its standard output.
  *
  * This is used when the output of the command is of interest, and not just a success state.
  *
  * @return std::optional<std::string> possibly containing the command output.
  */
-std::optional<std::string> runCommand(const std::string& command, bool captureOutput);
+std::optional<std::string> runCommand(const ICommandBuilder& command, bool captureOutput);
 
 /**
  * @brief Ensures that a directory exists, making it if necessary.
@@ -83,13 +89,6 @@ fs::path prepareAudioOutputPath(const fs::path& inputPath);
  */
 std::string trimTrailingSpace(const std::string& str);
 
-/**
- * @brief Gets the duration of a media file (audio or video) using ffprobe.
- *
- * @return The duration of the media in seconds, or -1 if an error occurred.
- */
-double getMediaDuration(const fs::path& mediaPath);
-
 /**
  * @brief Checks if a value is within a specified range (inclusive).
  *
@@ -1,48 +1,71 @@
 #include "VideoProcessor.h"
 
 #include <iostream>
+#include <vector>
 
-#include "CommandBuilder.h"
-#include "ConfigManager.h"
-#include "Utils.h"
+#include "AudioBuffer.h"
+#include "AudioDecoder.h"
+#include "MediaMuxer.h"
+#include "Tracer.h"
 
 namespace fs = std::filesystem;
 
 namespace MediaProcessor {
 
+namespace {
+
+// Frames decoded and muxed at a time
+constexpr size_t MERGE_BLOCK_FRAMES = 1 << 14;
+
+}  // namespace
+
 VideoProcessor::VideoProcessor(const fs::path& videoPath, const fs::path& audioPath,
                                const fs::path& outputPath)
-    : m_videoPath(fs::absolute(videoPath)),
+    : VideoProcessor(MediaInfo::probe(videoPath), audioPath, outputPath) {}
+
+VideoProcessor::VideoProcessor(const MediaInfo& videoInfo, const fs::path& audioPath,
+                               const fs::path& outputPath)
+    : m_videoInfo(videoInfo),
+      m_videoPath(fs::absolute(videoInfo.path)),
       m_audioPath(fs::absolute(audioPath)),
-      m_outputPath(fs::absolute(outputPath)),
-      m_ffmpegPath(ConfigManager::getInstance().getFFmpegPath()) {}
+      m_outputPath(fs::absolute(outputPath)) {}
 
 bool VideoProcessor::mergeMedia() {
-    Utils::removeFileIfExists(m_outputPath);  // to avoid interactive ffmpeg prompt
+    TRACE_SCOPE("mux");
+    if (!m_videoInfo.hasVideo()) {
+        std::cerr << "Error: No video stream found in " << m_videoPath << std::endl;
+        return false;
+    }
 
     std::cout << "Merging video and audio..." << std::endl;
 
-    // Prepare FFmpeg command
-    CommandBuilder cmd;
-    cmd.addArgument(m_ffmpegPath.string());
-    cmd.addFlag("-y");  // overwrite enabled
-    cmd.addFlag("-i", m_videoPath.string());
-    cmd.addFlag("-i", m_audioPath.string());
-    cmd.addFlag("-c:v", "copy");
-    cmd.addFlag("-c:a", "aac");
-    cmd.addFlag("-strict", "experimental");
-    cmd.addFlag("-map", "0:v:0");
-    cmd.addFlag("-map", "1:a:0");
-    cmd.addFlag("-shortest");
-    cmd.addArgument(m_outputPath.string());
-
-    std::string ffmpegCommand = cmd.build();
-
-    std::cout << "Running FFmpeg command: " << ffmpegCommand << std::endl;
-    bool success = Utils::runCommand(ffmpegCommand);
-
-    if (!success) {
-        std::cerr << "Error: Failed to merge audio and video using FFmpeg." << std::endl;
+    try {
+        // Decoded at its own rate and layout, the muxer encodes it unchanged
+        const MediaInfo audioInfo = MediaInfo::probe(m_audioPath);
+        const StreamInfo* audioStream = audioInfo.getAudioStream();
+        if (!audioStream) {
+            throw std::runtime_error("No audio stream found in " + m_audioPath.string());
+        }
+
+        AudioDecoder decoder(audioStream->sampleRate, ChannelMode::Source);
+        decoder.open(m_audioPath, audioInfo.audioStreamIndex);
+        MediaMuxer muxer(m_videoInfo, m_outputPath, audioStream->sampleRate,
+                         decoder.getChannels());
+
+        AudioBuffer block(MERGE_BLOCK_FRAMES, decoder.getChannels());
+        std::vector<float*> channels(block.getChannels());
+        std::vector<const float*> samples(block.getChannels());
+        for (size_t channel = 0; channel < channels.size(); ++channel) {
+            channels[channel] = block.getChannel(channel).data();
+            samples[channel] = channels[channel];
+        }
+
+        while (size_t count = decoder.read(channels, block.getFrames())) {
+            muxer.writePlanar(samples, count);
+        }
+        muxer.close();
+    } catch (const std::runtime_error& ex) {
+        std::cerr << "Error: Failed to merge audio and video: " << ex.what() << std::endl;
         return false;
     }
 
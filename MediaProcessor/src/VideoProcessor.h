@@ -3,6 +3,8 @@
 
 #include <filesystem>
 
+#include "MediaInfo.h"
+
 namespace fs = std::filesystem;
 
 namespace MediaProcessor {
@@ -14,22 +16,33 @@ class VideoProcessor {
    public:
     /**
      * @brief Initializes the VideoProcessor with paths for the video, audio, and output.
+     *
+     * @throws std::runtime_error if the video cannot be probed.
      */
     VideoProcessor(const fs::path& videoPath, const fs::path& audioPath,
                    const fs::path& outputPath);
 
+    /**
+     * @brief Initializes the VideoProcessor with an already probed video.
+     */
+    VideoProcessor(const MediaInfo& videoInfo, const fs::path& audioPath,
+                   const fs::path& outputPath);
+
     /**
      * @brief Merges the audio and video files into a single output file.
      *
+     * Muxed in-process by `MediaMuxer`: the video is stream-copied, the audio is decoded and
+     * encoded to AAC block by block, and the output ends with the shorter of the two.
+     *
      * @return true if the merge is successful, false otherwise.
      */
     bool mergeMedia();
 
    private:
+    MediaInfo m_videoInfo;
     fs::path m_videoPath;
     fs::path m_audioPath;
     fs::path m_outputPath;
-    fs::path m_ffmpegPath;
 };
 
 }  // namespace MediaProcessor
@@ -0,0 +1,90 @@
+#include "WavFileWriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "PcmKernels.h"
+
+namespace MediaProcessor {
+
+namespace {
+
+constexpr size_t BLOCK_SAMPLES = 16384;
+
+}  // namespace
+
+WavFileWriter::WavFileWriter(const fs::path& outputPath, int sampleRate, int channels)
+    : m_outputPath(outputPath), m_channels(static_cast<size_t>(std::max(channels, 1))) {
+    SF_INFO sfInfo{};
+    sfInfo.samplerate = sampleRate;
+    sfInfo.channels = channels;
+    sfInfo.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
+
+    m_file = sf_open(outputPath.c_str(), SFM_WRITE, &sfInfo);
+    if (!m_file) {
+        throw std::runtime_error("Could not open output WAV file: " + outputPath.string());
+    }
+}
+
+WavFileWriter::~WavFileWriter() {
+    close();
+}
+
+void WavFileWriter::write(const float* samples, size_t numFrames) {
+    if (!m_file) {
+        throw std::runtime_error("Write to closed WAV file: " + m_outputPath.string());
+    }
+
+    // Quantize in blocks that stay in cache rather than converting the whole input at once
+    const size_t blockFrames = std::max<size_t>(BLOCK_SAMPLES / m_channels, 1);
+    m_block.resize(std::min(numFrames, blockFrames) * m_channels);
+
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        PcmKernels::convertFromFloat({samples + frame * m_channels, frames * m_channels},
+                                     PcmKernels::SampleFormat::S16, m_block.data());
+        writeBlock(frames);
+    }
+}
+
+void WavFileWriter::writePlanar(std::span<const float* const> channels, size_t numFrames) {
+    if (!m_file) {
+        throw std::runtime_error("Write to closed WAV file: " + m_outputPath.string());
+    }
+    if (channels.size() != m_channels) {
+        throw std::runtime_error("Expected " + std::to_string(m_channels) + " channels for " +
+                                 m_outputPath.string() + ", got " +
+                                 std::to_string(channels.size()) + ".");
+    }
+
+    const size_t blockFrames = std::max<size_t>(BLOCK_SAMPLES / m_channels, 1);
+    m_block.resize(std::min(numFrames, blockFrames) * m_channels);
+    m_planes.resize(m_channels);
+
+    for (size_t frame = 0; frame < numFrames; frame += blockFrames) {
+        const size_t frames = std::min(blockFrames, numFrames - frame);
+        for (size_t channel = 0; channel < m_channels; ++channel) {
+            m_planes[channel] = channels[channel] + frame;
+        }
+        PcmKernels::interleaveFromFloat(m_planes, frames, PcmKernels::SampleFormat::S16,
+                                        m_block.data());
+        writeBlock(frames);
+    }
+}
+
+void WavFileWriter::writeBlock(size_t numFrames) {
+    sf_count_t framesWritten = sf_writef_short(m_file, m_block.data(), numFrames);
+    if (framesWritten != static_cast<sf_count_t>(numFrames)) {
+        throw std::runtime_error("Failed to write audio samples to: " + m_outputPath.string());
+    }
+}
+
+void WavFileWriter::close() {
+    if (m_file) {
+        sf_close(m_file);
+        m_file = nullptr;
+    }
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,67 @@
+#ifndef WAVFILEWRITER_H
+#define WAVFILEWRITER_H
+
+#include <sndfile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "IAudioSink.h"
+
+namespace fs = std::filesystem;
+
+namespace MediaProcessor {
+
+/**
+ * @brief Incrementally writes float samples to a 16-bit PCM WAV file.
+ *
+ * Samples are quantized with the vectorized `PcmKernels`, clamping anything outside [-1, 1).
+ */
+class WavFileWriter : public IAudioSink {
+   public:
+    /**
+     * @brief Opens the output file for writing.
+     *
+     * @throws std::runtime_error if the file cannot be opened.
+     */
+    WavFileWriter(const fs::path& outputPath, int sampleRate, int channels = 1);
+    ~WavFileWriter() override;
+
+    WavFileWriter(const WavFileWriter&) = delete;
+    WavFileWriter& operator=(const WavFileWriter&) = delete;
+
+    /**
+     * @brief Appends interleaved frames to the file.
+     *
+     * @throws std::runtime_error if the samples cannot be written.
+     */
+    void write(const float* samples, size_t numFrames);
+
+    /**
+     * @brief Appends frames given as one buffer per channel, interleaving while quantizing.
+     *
+     * @throws std::runtime_error if the number of buffers is wrong or the samples cannot be
+     *         written.
+     */
+    void writePlanar(std::span<const float* const> channels, size_t numFrames) override;
+
+    /**
+     * @brief Finalizes the file. Called by the destructor if not done explicitly.
+     */
+    void close() override;
+
+   private:
+    fs::path m_outputPath;
+    SNDFILE* m_file = nullptr;
+    size_t m_channels;
+    std::vector<int16_t> m_block;  // quantized samples, reused across writes
+    std::vector<const float*> m_planes;
+
+    void writeBlock(size_t numFrames);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // WAVFILEWRITER_H
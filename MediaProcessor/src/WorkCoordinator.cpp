@@ -0,0 +1,185 @@
+#include "WorkCoordinator.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+
+namespace MediaProcessor {
+
+WorkCoordinator::WorkCoordinator(const std::vector<SocketUtils::Endpoint>& workers) {
+    size_t reachableWorkers = 0;
+    for (const auto& endpoint : workers) {
+        Worker& worker = m_workers.emplace_back();
+        worker.endpoint = endpoint;
+
+        int connection = SocketUtils::connectTcp(endpoint, WORKER_IO_TIMEOUT);
+        std::optional<std::string> reply;
+        if (connection >= 0 &&
+            SocketUtils::writeMessage(connection, nlohmann::json({{"command", "info"}}).dump())) {
+            reply = SocketUtils::readMessage(connection);
+        }
+
+        nlohmann::json info =
+            reply ? nlohmann::json::parse(*reply, nullptr, false) : nlohmann::json();
+        if (!info.is_object() || info.value("status", "") != "ok") {
+            std::cerr << "Warning: worker " << endpoint.toString() << " is unreachable."
+                      << std::endl;
+            if (connection >= 0) {
+                close(connection);
+            }
+            markDead(worker);
+            continue;
+        }
+
+        worker.capacity = std::max<size_t>(info.value("threads", size_t{1}), 1);
+        worker.idleConnections.push_back(connection);
+        ++reachableWorkers;
+    }
+
+    if (reachableWorkers == 0) {
+        throw std::runtime_error("No worker is reachable.");
+    }
+}
+
+WorkCoordinator::~WorkCoordinator() {
+    for (Worker& worker : m_workers) {
+        for (int connection : worker.idleConnections) {
+            close(connection);
+        }
+    }
+}
+
+size_t WorkCoordinator::getCapacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Clock::time_point now = Clock::now();
+    size_t capacity = 0;
+    for (const Worker& worker : m_workers) {
+        if (worker.retryAt <= now) {
+            capacity += worker.capacity;
+        }
+    }
+    return capacity;
+}
+
+std::vector<float> WorkCoordinator::filter(std::span<const float> samples, float attenLimit,
+                                           float postFilterBeta) {
+    std::vector<float> processedSamples;
+    std::string error;
+
+    // Each worker is tried once, a dead one may be back before the unit has been everywhere
+    std::vector<bool> tried(m_workers.size(), false);
+    while (true) {
+        size_t workerIndex = m_workers.size();
+        int connection = -1;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            const Clock::time_point now = Clock::now();
+            double lowestLoad = std::numeric_limits<double>::max();
+            for (size_t i = 0; i < m_workers.size(); ++i) {
+                const Worker& candidate = m_workers[i];
+                double load = static_cast<double>(candidate.unitsInFlight) / candidate.capacity;
+                if (!tried[i] && candidate.retryAt <= now && load < lowestLoad) {
+                    lowestLoad = load;
+                    workerIndex = i;
+                }
+            }
+            if (workerIndex == m_workers.size()) {
+                throw std::runtime_error("No worker left to filter the work unit.");
+            }
+
+            tried[workerIndex] = true;
+            Worker& worker = m_workers[workerIndex];
+            ++worker.unitsInFlight;
+            if (!worker.idleConnections.empty()) {
+                connection = worker.idleConnections.back();
+                worker.idleConnections.pop_back();
+            }
+        }
+        Worker& worker = m_workers[workerIndex];
+
+        ExchangeResult result = ExchangeResult::Failed;
+        if (connection >= 0) {
+            result = exchange(connection, samples, attenLimit, postFilterBeta, processedSamples,
+                              error);
+            if (result == ExchangeResult::Failed) {
+                // A pooled connection may have outlived a restarted worker, retry on a new one
+                close(connection);
+                connection = -1;
+            }
+        }
+        if (result == ExchangeResult::Failed) {
+            connection = SocketUtils::connectTcp(worker.endpoint, WORKER_IO_TIMEOUT);
+            if (connection >= 0) {
+                result = exchange(connection, samples, attenLimit, postFilterBeta,
+                                  processedSamples, error);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --worker.unitsInFlight;
+        if (result == ExchangeResult::Success) {
+            worker.idleConnections.push_back(connection);
+            return processedSamples;
+        }
+        if (result == ExchangeResult::Rejected) {
+            worker.idleConnections.push_back(connection);
+            throw std::runtime_error("Worker " + worker.endpoint.toString() +
+                                     " failed to filter the work unit: " + error);
+        }
+
+        if (connection >= 0) {
+            close(connection);
+        }
+        std::cerr << "Warning: worker " << worker.endpoint.toString()
+                  << " failed, re-dispatching the work unit." << std::endl;
+        markDead(worker);
+    }
+}
+
+WorkCoordinator::ExchangeResult WorkCoordinator::exchange(int connection,
+                                                          std::span<const float> samples,
+                                                          float attenLimit, float postFilterBeta,
+                                                          std::vector<float>& processedSamples,
+                                                          std::string& error) {
+    const nlohmann::json request = {{"command", "filter"},
+                                    {"attenuation_limit", attenLimit},
+                                    {"post_filter_beta", postFilterBeta}};
+    if (!SocketUtils::writeMessage(connection, request.dump()) ||
+        !SocketUtils::writeSamples(connection, samples)) {
+        return ExchangeResult::Failed;
+    }
+
+    auto reply = SocketUtils::readMessage(connection);
+    if (!reply) {
+        return ExchangeResult::Failed;
+    }
+    nlohmann::json status = nlohmann::json::parse(*reply, nullptr, false);
+    if (!status.is_object()) {
+        return ExchangeResult::Failed;
+    }
+    if (status.value("status", "") != "ok") {
+        error = status.value("message", "unknown error");
+        return ExchangeResult::Rejected;
+    }
+
+    auto result = SocketUtils::readSamples(connection);
+    if (!result || result->size() != samples.size()) {
+        return ExchangeResult::Failed;
+    }
+    processedSamples = std::move(*result);
+    return ExchangeResult::Success;
+}
+
+void WorkCoordinator::markDead(Worker& worker) {
+    worker.retryAt = Clock::now() + WORKER_RETRY_INTERVAL;
+    for (int connection : worker.idleConnections) {
+        close(connection);
+    }
+    worker.idleConnections.clear();
+}
+
+}  // namespace MediaProcessor
@@ -0,0 +1,94 @@
+#ifndef WORKCOORDINATOR_H
+#define WORKCOORDINATOR_H
+
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "SocketUtils.h"
+
+namespace MediaProcessor {
+
+// A worker that does not answer within this time is considered dead
+constexpr std::chrono::seconds WORKER_IO_TIMEOUT{60};
+
+// Dead workers are tried again after this interval
+constexpr std::chrono::seconds WORKER_RETRY_INTERVAL{10};
+
+/**
+ * @brief Dispatches work units to `WorkerServer` processes on other nodes.
+ *
+ * Every worker is kept busy with as many units as it filters at once, over pooled connections.
+ * A unit whose worker disconnects or times out is re-dispatched to another worker, and the dead
+ * worker is skipped for `WORKER_RETRY_INTERVAL`. A worker that replies with an error is alive,
+ * the unit itself failed.
+ */
+class WorkCoordinator {
+   public:
+    /**
+     * @brief Queries the capacity of every worker.
+     *
+     * @throws std::runtime_error if no worker is reachable.
+     */
+    explicit WorkCoordinator(const std::vector<SocketUtils::Endpoint>& workers);
+    ~WorkCoordinator();
+
+    WorkCoordinator(const WorkCoordinator&) = delete;
+    WorkCoordinator& operator=(const WorkCoordinator&) = delete;
+
+    /**
+     * @brief Number of units the workers filter at once, in total.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Filters a work unit on the least loaded worker. Blocks until it is done.
+     *
+     * Thread-safe, meant to be called concurrently for up to `getCapacity()` units. Each worker
+     * is tried at most once per unit.
+     *
+     * @throws std::runtime_error if a worker replied with an error, or every worker died.
+     */
+    std::vector<float> filter(std::span<const float> samples, float attenLimit,
+                              float postFilterBeta);
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Worker {
+        SocketUtils::Endpoint endpoint;
+        size_t capacity = 1;
+        size_t unitsInFlight = 0;
+        std::vector<int> idleConnections;
+        Clock::time_point retryAt;  // dead until then
+    };
+
+    enum class ExchangeResult {
+        Success,
+        Rejected,  // the worker replied with an error, the connection is still usable
+        Failed     // the connection broke or timed out
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<Worker> m_workers;
+
+    /**
+     * @brief Sends the unit over `connection` and receives the filtered unit.
+     *
+     * @param error Set to the worker's message if the unit is rejected.
+     */
+    ExchangeResult exchange(int connection, std::span<const float> samples, float attenLimit,
+                            float postFilterBeta, std::vector<float>& processedSamples,
+                            std::string& error);
+
+    /**
+     * @brief Closes the worker's connections and skips it until the retry interval has passed.
+     */
+    void markDead(Worker& worker);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // WORKCOORDINATOR_H
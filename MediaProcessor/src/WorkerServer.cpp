@@ -0,0 +1,168 @@
+#include "WorkerServer.h"
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+#include "AudioBuffer.h"
+#include "ConfigManager.h"
+#include "DFStatePool.h"
+#include "Tracer.h"
+
+namespace MediaProcessor {
+
+namespace {
+
+nlohmann::json failure(const std::string& message) {
+    return {{"status", "failed"}, {"message", message}};
+}
+
+}  // namespace
+
+WorkerServer::WorkerServer(const SocketUtils::Endpoint& endpoint, unsigned int numThreads)
+    : m_endpoint(endpoint),
+      m_numThreads(std::max(numThreads, 1u)),
+      m_filterSlots(m_numThreads) {}
+
+WorkerServer::~WorkerServer() {
+    stop();
+}
+
+void WorkerServer::run() {
+    const int listenFd = SocketUtils::listenTcp(m_endpoint);
+    m_port = SocketUtils::getLocalPort(listenFd);
+    m_listenFd = listenFd;
+    std::cout << "INFO: worker listening on " << m_endpoint.host << ":" << m_port << std::endl;
+
+    while (!m_stopping) {
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (!m_stopping) {
+                std::cerr << "Error: Failed to accept connection: " << strerror(errno)
+                          << std::endl;
+            }
+            break;
+        }
+
+        int enable = 1;
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        {
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            m_clientFds.insert(clientFd);
+        }
+
+        std::thread([this, clientFd]() {
+            handleConnection(clientFd);
+
+            // Notify under the lock, `run()` may return as soon as the last connection is gone
+            std::lock_guard<std::mutex> lock(m_connectionsMutex);
+            close(clientFd);
+            m_clientFds.erase(clientFd);
+            m_connectionsDone.notify_all();
+        }).detach();
+    }
+
+    // Coordinators see the connections close and re-dispatch their queued units elsewhere
+    std::unique_lock<std::mutex> lock(m_connectionsMutex);
+    for (int clientFd : m_clientFds) {
+        shutdown(clientFd, SHUT_RD);
+    }
+    m_connectionsDone.wait(lock, [this]() { return m_clientFds.empty(); });
+
+    m_listenFd = -1;
+    close(listenFd);
+}
+
+void WorkerServer::stop() {
+    m_stopping = true;
+
+    // Unblocks accept() in `run()`
+    int listenFd = m_listenFd;
+    if (listenFd >= 0) {
+        shutdown(listenFd, SHUT_RDWR);
+    }
+}
+
+uint16_t WorkerServer::getPort() const {
+    return m_port;
+}
+
+void WorkerServer::handleConnection(int clientFd) {
+    while (auto message = SocketUtils::readMessage(clientFd)) {
+        nlohmann::json request;
+        try {
+            request = nlohmann::json::parse(*message);
+        } catch (const nlohmann::json::exception& ex) {
+            SocketUtils::writeMessage(clientFd,
+                                      failure("Invalid request: " + std::string(ex.what())).dump());
+            return;
+        }
+
+        if (!handleRequest(request, clientFd)) {
+            return;
+        }
+    }
+}
+
+bool WorkerServer::handleRequest(const nlohmann::json& request, int clientFd) {
+    const std::string command = request.value("command", "");
+
+    if (command == "filter") {
+        return filterUnit(request, clientFd);
+    }
+
+    nlohmann::json reply;
+    if (command == "info") {
+        reply = {{"status", "ok"}, {"threads", m_numThreads}};
+    } else if (command == "ping") {
+        reply = {{"status", "ok"}};
+    } else {
+        reply = failure("Unknown command '" + command + "'.");
+    }
+    return SocketUtils::writeMessage(clientFd, reply.dump());
+}
+
+bool WorkerServer::filterUnit(const nlohmann::json& request, int clientFd) {
+    auto samples = SocketUtils::readSamples(clientFd);
+    if (!samples) {
+        return false;
+    }
+
+    AudioBuffer processedSamples(samples->size());
+    std::string error;
+
+    m_filterSlots.acquire();
+    try {
+        const float attenLimit = request.value("attenuation_limit", 100.0f);
+        const float postFilterBeta = request.value("post_filter_beta", 0.0f);
+
+        TRACE_SCOPE("filter unit", "samples", static_cast<int64_t>(samples->size()));
+        DFStatePool::Lease lease = DFStatePool::getInstance().acquire(
+            ConfigManager::getInstance().getDeepFilterTarballPath(), attenLimit, postFilterBeta);
+        lease.process(*samples, processedSamples.getChannel());
+    } catch (const std::exception& ex) {
+        error = ex.what();
+    }
+    m_filterSlots.release();
+
+    if (!error.empty()) {
+        std::cerr << "Error: Failed to filter work unit: " << error << std::endl;
+        return SocketUtils::writeMessage(clientFd, failure(error).dump());
+    }
+
+    return SocketUtils::writeMessage(clientFd, nlohmann::json({{"status", "ok"}}).dump()) &&
+           SocketUtils::writeSamples(clientFd, processedSamples.getChannel());
+}
+
+}  // namespace MediaProcessor
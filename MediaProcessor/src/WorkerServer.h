@@ -0,0 +1,86 @@
+#ifndef WORKERSERVER_H
+#define WORKERSERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <semaphore>
+#include <set>
+
+#include "SocketUtils.h"
+
+namespace MediaProcessor {
+
+// Loopback only, listening on other interfaces takes an explicit host such as 0.0.0.0
+constexpr const char* DEFAULT_WORKER_HOST = "127.0.0.1";
+
+/**
+ * @brief Filters work units for a `WorkCoordinator` running on another process or node.
+ *
+ * Workers only see PCM: the coordinator decodes, plans and merges, and ships each work unit over
+ * TCP. Messages are framed by `SocketUtils::writeMessage()`:
+ *
+ *   {"command": "info"} -> {"status": "ok", "threads": <units filtered at once>}
+ *   {"command": "filter", "attenuation_limit": 100.0, "post_filter_beta": 0.0}, then the unit
+ *       as `SocketUtils::writeSamples()` -> {"status": "ok"}, then the filtered unit,
+ *       or {"status": "failed", "message": "<reason>"}
+ *   {"command": "ping"} -> {"status": "ok"}
+ *
+ * The model is the worker's own `deep_filter_tarball_path`. Each connection filters one unit at
+ * a time, and at most `numThreads` units are filtered at once across connections. The protocol
+ * has no authentication or encryption: anyone who can connect may have units filtered and sees
+ * their samples, so workers are meant for a trusted network.
+ */
+class WorkerServer {
+   public:
+    WorkerServer(const SocketUtils::Endpoint& endpoint, unsigned int numThreads);
+    ~WorkerServer();
+
+    WorkerServer(const WorkerServer&) = delete;
+    WorkerServer& operator=(const WorkerServer&) = delete;
+
+    /**
+     * @brief Binds the endpoint and serves connections until `stop()` is called.
+     *
+     * Returns once the units being filtered are done.
+     *
+     * @throws std::runtime_error if the endpoint cannot be bound.
+     */
+    void run();
+
+    /**
+     * @brief Stops accepting connections. Async-signal-safe.
+     */
+    void stop();
+
+    /**
+     * @brief Port the server listens on, 0 until `run()` has bound it.
+     */
+    uint16_t getPort() const;
+
+   private:
+    SocketUtils::Endpoint m_endpoint;
+    unsigned int m_numThreads;
+    std::counting_semaphore<> m_filterSlots;
+
+    std::atomic<int> m_listenFd{-1};
+    std::atomic<uint16_t> m_port{0};
+    std::atomic<bool> m_stopping{false};
+
+    std::mutex m_connectionsMutex;
+    std::condition_variable m_connectionsDone;
+    std::set<int> m_clientFds;
+
+    void handleConnection(int clientFd);
+
+    /**
+     * @return false if the connection is no longer usable.
+     */
+    bool handleRequest(const nlohmann::json& request, int clientFd);
+    bool filterUnit(const nlohmann::json& request, int clientFd);
+};
+
+}  // namespace MediaProcessor
+
+#endif  // WORKERSERVER_H
@@ -1,9 +1,170 @@
+#include <csignal>
 #include <iostream>
+#include <string_view>
+#include <vector>
 
+#include "BatchProcessor.h"
+#include "ConfigManager.h"
 #include "Engine.h"
+#include "JobServer.h"
+#include "PerfCounters.h"
+#include "Tracer.h"
+#include "WorkerServer.h"
 
 using namespace MediaProcessor;
 
+namespace {
+
+JobServer* g_jobServer = nullptr;
+WorkerServer* g_workerServer = nullptr;
+
+/**
+ * @brief Runs the job server until it is asked to shut down or receives SIGINT/SIGTERM.
+ *
+ * @return Exit status code (0 for success, non-zero for failure).
+ */
+int serve(const fs::path& socketPath) {
+    ConfigManager& configManager = ConfigManager::getInstance();
+    try {
+        configManager.loadConfig("config.json");
+
+        JobServer jobServer(socketPath, configManager.getOptimalThreadCount(),
+                            configManager.getSchedulerLatencySlo(),
+                            configManager.getSchedulerBatchNiceness());
+        g_jobServer = &jobServer;
+
+        auto handleSignal = [](int) { g_jobServer->stop(); };
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        jobServer.run();
+
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        g_jobServer = nullptr;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Filters work units for remote coordinators until SIGINT/SIGTERM.
+ *
+ * @return Exit status code (0 for success, non-zero for failure).
+ */
+int runWorker(std::string_view endpoint) {
+    ConfigManager& configManager = ConfigManager::getInstance();
+    try {
+        configManager.loadConfig("config.json");
+
+        WorkerServer workerServer(SocketUtils::parseEndpoint(endpoint, DEFAULT_WORKER_HOST),
+                                  configManager.getOptimalThreadCount());
+        g_workerServer = &workerServer;
+
+        auto handleSignal = [](int) { g_workerServer->stop(); };
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        workerServer.run();
+
+        std::signal(SIGINT, SIG_DFL);
+        std::signal(SIGTERM, SIG_DFL);
+        g_workerServer = nullptr;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Processes all files of a batch on one shared worker pool.
+ *
+ * @return Exit status code (0 if every file succeeded, non-zero otherwise).
+ */
+int processBatch(std::vector<fs::path> mediaPaths, bool streamingMode) {
+    ConfigManager& configManager = ConfigManager::getInstance();
+    try {
+        configManager.loadConfig("config.json");
+
+        BatchProcessor batchProcessor(std::move(mediaPaths),
+                                      configManager.getOptimalThreadCount(),
+                                      configManager.getBatchConcurrentJobs());
+        batchProcessor.setStreamingMode(streamingMode);
+        return batchProcessor.processAll() ? 0 : 1;
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return 1;
+    }
+}
+
+void printUsage(const char* executable) {
+    std::cerr << "Usage: " << executable << " [options] <media_file_path>" << std::endl;
+    std::cerr << "       " << executable << " [options] --batch <media_file_path>..." << std::endl;
+    std::cerr << "       " << executable << " [options] --manifest <manifest_path>" << std::endl;
+    std::cerr << "       " << executable
+              << " [--trace <trace_path>] [--perf-counters] --serve [socket_path]" << std::endl;
+    std::cerr << "       " << executable << " [--trace <trace_path>] --worker [host:]port"
+              << std::endl;
+    std::cerr << "Options: --streaming, --trace <trace_path>, --perf-counters" << std::endl;
+    std::cerr << "The job socket defaults to " << getDefaultSocketPath().string()
+              << " ($XDG_RUNTIME_DIR, or /tmp if unset)." << std::endl;
+    std::cerr << "Workers listen on " << DEFAULT_WORKER_HOST
+              << " unless a host is given, and have no authentication." << std::endl;
+}
+
+/**
+ * @brief Runs the mode selected by the arguments following the options.
+ *
+ * @return Exit status code (0 for success, non-zero for failure).
+ */
+int run(int argc, char* argv[], int argIndex, bool streamingMode) {
+    const int remainingArgs = argc - argIndex;
+
+    if (remainingArgs >= 1 && remainingArgs <= 2 && std::string_view(argv[argIndex]) == "--serve") {
+        return serve(remainingArgs == 2 ? argv[argIndex + 1] : getDefaultSocketPath());
+    }
+
+    if (remainingArgs == 2 && std::string_view(argv[argIndex]) == "--worker") {
+        return runWorker(argv[argIndex + 1]);
+    }
+
+    if (remainingArgs >= 2 && std::string_view(argv[argIndex]) == "--batch") {
+        return processBatch({argv + argIndex + 1, argv + argc}, streamingMode);
+    }
+
+    if (remainingArgs == 2 && std::string_view(argv[argIndex]) == "--manifest") {
+        std::vector<fs::path> mediaPaths;
+        try {
+            mediaPaths = BatchProcessor::readManifest(argv[argIndex + 1]);
+        } catch (const std::exception& ex) {
+            std::cerr << "Error: " << ex.what() << std::endl;
+            return 1;
+        }
+        return processBatch(std::move(mediaPaths), streamingMode);
+    }
+
+    if (remainingArgs != 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    MediaProcessor::Engine engine(argv[argIndex]);
+    engine.setStreamingMode(streamingMode);
+    if (!engine.processMedia()) {
+        std::cerr << "Media processing failed." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
     /**
      * @brief Processes a media file (audio or video) to isolate vocals and output the processed
@@ -26,23 +187,66 @@ int main(int argc, char* argv[]) {
      * @param argv Array of command-line argument strings.
      * @return Exit status code (0 for success, non-zero for failure).
      *
-     * Usage: <executable> <media_file_path>
+     * Usage: <executable> [options] <media_file_path>
+     *        <executable> [options] --batch <media_file_path>...
+     *        <executable> [options] --manifest <manifest_path>
+     *        <executable> [--trace <trace_path>] [--perf-counters] --serve [socket_path]
+     *        <executable> [--trace <trace_path>] --worker [host:]port
+     *
+     * Options:
+     *   --streaming  Process the audio in constant memory, for arbitrarily long inputs.
+     *                Can also be enabled with `use_streaming_mode` in "config.json".
+     *   --trace      Record the time spent in each stage and write it as Chrome trace-event
+     *                JSON on exit, viewable in chrome://tracing or https://ui.perfetto.dev.
+     *   --perf-counters
+     *                Count CPU cycles, instructions, cache misses and context switches per stage
+     *                and add the totals to each job's report. Needs perf events to be permitted
+     *                (kernel.perf_event_paranoid); unavailable counters are skipped.
+     *   --batch      Process several files in one process, sharing workers and models.
+     *   --manifest   Like --batch, with the files listed one per line in a manifest file.
+     *   --serve      Stay resident and accept jobs over a Unix domain socket (see JobServer.h),
+     *                by default at $XDG_RUNTIME_DIR/MediaProcessor.sock, or at
+     *                /tmp/MediaProcessor.sock if XDG_RUNTIME_DIR is unset.
+     *   --worker     Filter work units shipped over TCP by coordinators listing this worker in
+     *                `distributed_workers` (see WorkerServer.h).
      *
      * Example:
      *   - For video: <executable> input_video.mp4
      *   - For audio: <executable> input_audio.wav
      */
 
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <media_file_path>" << std::endl;
-        return 1;
+    int argIndex = 1;
+    bool streamingMode = false;
+    fs::path tracePath;
+    while (argIndex < argc) {
+        std::string_view option(argv[argIndex]);
+        if (option == "--streaming") {
+            streamingMode = true;
+            ++argIndex;
+        } else if (option == "--perf-counters") {
+            PerfCounters::getInstance().enable();
+            ++argIndex;
+        } else if (option == "--trace" && argIndex + 1 < argc) {
+            tracePath = argv[argIndex + 1];
+            argIndex += 2;
+        } else {
+            break;
+        }
     }
 
-    MediaProcessor::Engine engine(argv[1]);
-    if (!engine.processMedia()) {
-        std::cerr << "Media processing failed." << std::endl;
-        return 1;
+    if (!tracePath.empty()) {
+        Tracer::getInstance().enable();
     }
 
-    return 0;
+    int status = run(argc, argv, argIndex, streamingMode);
+
+    if (!tracePath.empty()) {
+        if (Tracer::getInstance().writeChromeTrace(tracePath)) {
+            std::cout << "INFO: trace written to " << tracePath << "." << std::endl;
+        } else {
+            std::cerr << "Error: Could not write trace to " << tracePath << "." << std::endl;
+        }
+    }
+
+    return status;
 }
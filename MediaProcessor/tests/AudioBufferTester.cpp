@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "../src/AudioBuffer.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class AudioBufferTester : public ::testing::Test {
+   protected:
+    AudioBufferPool& pool = AudioBufferPool::getInstance();
+
+    void SetUp() override {
+        pool.clear();
+        pool.setMaxIdleBytes(64 * 1024 * 1024);
+        pool.setHugePages(false);
+    }
+
+    void TearDown() override {
+        pool.clear();
+        pool.setHugePages(false);
+    }
+
+    static bool isAligned(const void* pointer, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+    }
+};
+
+TEST_F(AudioBufferTester, GetClassSize_LargeRequest_WastesAtMostAQuarter) {
+    EXPECT_EQ(AudioBufferPool::getClassSize(1), 4096u);
+    EXPECT_EQ(AudioBufferPool::getClassSize(4 * 1024 * 1024), 4 * 1024 * 1024u);
+    EXPECT_EQ(AudioBufferPool::getClassSize(4 * 1024 * 1024 + 1), 5 * 1024 * 1024u);
+
+    for (size_t bytes = 4097; bytes < 64 * 1024 * 1024; bytes = bytes * 3 / 2) {
+        const size_t classSize = AudioBufferPool::getClassSize(bytes);
+        EXPECT_GE(classSize, bytes);
+        EXPECT_LE(classSize, bytes + bytes / 4);
+    }
+}
+
+TEST_F(AudioBufferTester, Constructor_SeveralChannels_AlignsEveryChannel) {
+    AudioBuffer buffer(1001, 6);
+
+    EXPECT_EQ(buffer.getFrames(), 1001u);
+    EXPECT_EQ(buffer.getChannels(), 6u);
+    for (size_t channel = 0; channel < buffer.getChannels(); ++channel) {
+        EXPECT_TRUE(isAligned(buffer.getChannel(channel).data(), AUDIO_BUFFER_ALIGNMENT));
+        EXPECT_EQ(buffer.getChannel(channel).size(), 1001u);
+    }
+    EXPECT_GE(buffer.getChannel(1).data() - buffer.getChannel(0).data(), 1001);
+}
+
+TEST_F(AudioBufferTester, Constructor_ReleasedBufferOfSameClass_ReusesMemory) {
+    const float* memory;
+    {
+        AudioBuffer buffer(48000 * 10);
+        memory = buffer.getChannel().data();
+    }
+    const size_t allocationCount = pool.getAllocationCount();
+    EXPECT_GT(pool.getIdleBytes(), 0u);
+
+    AudioBuffer buffer(48000 * 10 - 100);
+
+    EXPECT_EQ(buffer.getChannel().data(), memory);
+    EXPECT_EQ(pool.getAllocationCount(), allocationCount);
+    EXPECT_EQ(pool.getIdleBytes(), 0u);
+}
+
+TEST_F(AudioBufferTester, Release_PoolFull_ReturnsMemoryToSystem) {
+    pool.setMaxIdleBytes(0);
+    {
+        AudioBuffer buffer(48000);
+    }
+
+    EXPECT_EQ(pool.getIdleBytes(), 0u);
+}
+
+TEST_F(AudioBufferTester, Resize_BeyondCapacity_KeepsSamples) {
+    AudioBuffer buffer(100, 2);
+    std::iota(buffer.getChannel(0).begin(), buffer.getChannel(0).end(), 0.0f);
+    std::iota(buffer.getChannel(1).begin(), buffer.getChannel(1).end(), 1000.0f);
+
+    buffer.resize(10000);
+
+    ASSERT_EQ(buffer.getFrames(), 10000u);
+    EXPECT_GE(buffer.getCapacity(), 10000u);
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(buffer.getChannel(0)[i], static_cast<float>(i));
+        EXPECT_EQ(buffer.getChannel(1)[i], static_cast<float>(1000 + i));
+    }
+}
+
+TEST_F(AudioBufferTester, Constructor_HugePages_AlignsLargeBuffersToHugePages) {
+    pool.setHugePages(true);
+    AudioBuffer buffer(4 * 1024 * 1024);
+    std::fill(buffer.getChannel().begin(), buffer.getChannel().end(), 1.0f);
+
+#ifdef __linux__
+    EXPECT_TRUE(isAligned(buffer.getChannel().data(), 2 * 1024 * 1024));
+#endif
+    EXPECT_EQ(buffer.getChannel().back(), 1.0f);
+}
+
+}  // namespace MediaProcessor::Tests
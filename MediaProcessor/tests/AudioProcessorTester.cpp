@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
+#include <sndfile.h>
 
 #include <filesystem>
 #include <nlohmann/json.hpp>
+#include <vector>
 
+#include "../src/AudioDecoder.h"
 #include "../src/AudioProcessor.h"
 #include "../src/ConfigManager.h"
+#include "../src/SignalGenerator.h"
+#include "../src/WavFileWriter.h"
 #include "TestUtils.h"
 
 namespace fs = std::filesystem;
@@ -60,4 +65,80 @@ TEST_F(AudioProcessorTester, IsolateVocals_FiltersAudioCorrectly) {
         TestUtils::CompareFiles::compareAudioFiles(testAudioOutputPath, testAudioProcessedPath));
 }
 
+TEST_F(AudioProcessorTester, IsolateVocalsStreaming_FiltersAudioCorrectly) {
+    ConfigManager& configManager = ConfigManager::getInstance();
+    ASSERT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()))
+        << "Unable to Load TestConfigFile";
+
+    fs::path testAudioOutputPath = testOutputDir / "test_output_audio_streamed.wav";
+    AudioProcessor audioProcessor(testVideoPath, testAudioOutputPath);
+
+    EXPECT_EQ(audioProcessor.isolateVocalsStreaming(), true);
+
+    EXPECT_TRUE(fs::exists(testAudioOutputPath));
+
+    EXPECT_TRUE(
+        TestUtils::CompareFiles::compareAudioFiles(testAudioOutputPath, testAudioProcessedPath));
+}
+
+TEST_F(AudioProcessorTester, IsolateVocals_SourceChannelMode_KeepsChannels) {
+    testConfigFile.changeConfigOptions("audio_channel_mode", "source");
+    ConfigManager& configManager = ConfigManager::getInstance();
+    ASSERT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()))
+        << "Unable to Load TestConfigFile";
+
+    // Stereo speech over music, long enough for several work units
+    constexpr int channels = 2;
+    constexpr size_t numFrames = 12 * DEFAULT_DECODE_SAMPLE_RATE;
+    std::vector<float> samples(channels * numFrames);
+    SignalGenerator(DEFAULT_DECODE_SAMPLE_RATE, channels).generate(samples.data(), numFrames);
+
+    fs::path testStereoPath = testOutputDir / "test_stereo.wav";
+    {
+        WavFileWriter writer(testStereoPath, DEFAULT_DECODE_SAMPLE_RATE, channels);
+        writer.write(samples.data(), numFrames);
+    }
+
+    fs::path testAudioOutputPath = testOutputDir / "test_output_stereo.wav";
+    AudioProcessor audioProcessor(testStereoPath, testAudioOutputPath);
+    EXPECT_TRUE(audioProcessor.isolateVocals());
+
+    SF_INFO sfInfo{};
+    SNDFILE* file = sf_open(testAudioOutputPath.c_str(), SFM_READ, &sfInfo);
+    ASSERT_NE(file, nullptr);
+    sf_close(file);
+    EXPECT_EQ(sfInfo.channels, channels);
+    EXPECT_EQ(sfInfo.frames, static_cast<sf_count_t>(numFrames));
+}
+
+TEST_F(AudioProcessorTester, IsolateVocals_RestoreSourceSampleRate_KeepsRate) {
+    testConfigFile.changeConfigOptions("restore_source_sample_rate", true);
+    ConfigManager& configManager = ConfigManager::getInstance();
+    ASSERT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()))
+        << "Unable to Load TestConfigFile";
+
+    // Filtered at 48kHz in between, the podcast rate and length come back out
+    constexpr int sampleRate = 44100;
+    constexpr size_t numFrames = 12 * sampleRate + 17;
+    std::vector<float> samples(numFrames);
+    SignalGenerator(sampleRate, 1).generate(samples.data(), numFrames);
+
+    fs::path testPodcastPath = testOutputDir / "test_podcast.wav";
+    {
+        WavFileWriter writer(testPodcastPath, sampleRate);
+        writer.write(samples.data(), numFrames);
+    }
+
+    fs::path testAudioOutputPath = testOutputDir / "test_output_podcast.wav";
+    AudioProcessor audioProcessor(testPodcastPath, testAudioOutputPath);
+    EXPECT_TRUE(audioProcessor.isolateVocalsStreaming());
+
+    SF_INFO sfInfo{};
+    SNDFILE* file = sf_open(testAudioOutputPath.c_str(), SFM_READ, &sfInfo);
+    ASSERT_NE(file, nullptr);
+    sf_close(file);
+    EXPECT_EQ(sfInfo.samplerate, sampleRate);
+    EXPECT_EQ(sfInfo.frames, static_cast<sf_count_t>(numFrames));
+}
+
 }  // namespace MediaProcessor::Tests
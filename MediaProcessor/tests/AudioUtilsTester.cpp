@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "../src/AudioUtils.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST(AudioUtilsTester, Crossfade_RampsLinearlyBetweenInputs) {
+    std::vector<float> fadeOut(4, 1.0f);
+    std::vector<float> fadeIn(4, 0.0f);
+    std::vector<float> output(4);
+
+    AudioUtils::crossfade(fadeOut.data(), fadeIn.data(), output.data(), output.size());
+
+    EXPECT_FLOAT_EQ(output[0], 1.0f);
+    EXPECT_FLOAT_EQ(output[1], 0.75f);
+    EXPECT_FLOAT_EQ(output[2], 0.5f);
+    EXPECT_FLOAT_EQ(output[3], 0.25f);
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "../src/BatchProcessor.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class BatchProcessorTester : public ::testing::Test {
+   protected:
+    fs::path testDir = fs::temp_directory_path() / "BatchProcessorTester";
+
+    void SetUp() override {
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+};
+
+TEST_F(BatchProcessorTester, ReadManifest_CommentsAndRelativePaths_ResolvesAgainstManifestDir) {
+    fs::path manifestPath = testDir / "manifest.txt";
+    std::ofstream(manifestPath) << "# batch of test files\n"
+                                << "first.mp4\n"
+                                << "\n"
+                                << "/absolute/second.wav  \n";
+
+    std::vector<fs::path> mediaPaths = BatchProcessor::readManifest(manifestPath);
+
+    ASSERT_EQ(mediaPaths.size(), 2);
+    EXPECT_EQ(mediaPaths[0], testDir / "first.mp4");
+    EXPECT_EQ(mediaPaths[1], fs::path("/absolute/second.wav"));
+}
+
+TEST_F(BatchProcessorTester, ReadManifest_MissingFile_ThrowsException) {
+    EXPECT_THROW(BatchProcessor::readManifest(testDir / "missing.txt"), std::runtime_error);
+}
+
+TEST_F(BatchProcessorTester, ProcessAll_MissingMediaFiles_ReportsEveryFailure) {
+    std::vector<fs::path> mediaPaths = {testDir / "missing1.mp4", testDir / "missing2.mp4",
+                                        testDir / "missing3.mp4"};
+    BatchProcessor batchProcessor(mediaPaths, 2, 2);
+
+    EXPECT_FALSE(batchProcessor.processAll());
+    EXPECT_EQ(batchProcessor.getFailedPaths(), mediaPaths);
+}
+
+}  // namespace MediaProcessor::Tests
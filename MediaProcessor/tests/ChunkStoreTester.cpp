@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <vector>
+
+#include "../src/ChunkStore.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class ChunkStoreTester : public ::testing::Test {
+   protected:
+    fs::path testDir = fs::temp_directory_path() / "ChunkStoreTester";
+    fs::path storeDir = testDir / "chunks";
+    fs::path modelPath = testDir / "model.tar.gz";
+    std::vector<float> samples = {0.1f, -0.2f, 0.3f, -0.4f};
+
+    void SetUp() override {
+        fs::create_directories(testDir);
+        std::ofstream(modelPath) << "model";
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    ChunkStore openStore(float attenLimit = 100.0f) {
+        return ChunkStore(storeDir, 1024 * 1024, modelPath, attenLimit, 0.0f);
+    }
+};
+
+TEST_F(ChunkStoreTester, Load_SavedUnit_ReturnsProcessedSamples) {
+    ChunkStore store = openStore();
+    std::string fingerprint = store.fingerprint(samples);
+    std::vector<float> processedSamples = {1.0f, 2.0f, 3.0f, 4.0f};
+    ASSERT_TRUE(store.save(fingerprint, processedSamples));
+
+    std::vector<float> loadedSamples(samples.size());
+    ASSERT_TRUE(openStore().load(fingerprint, loadedSamples));
+
+    EXPECT_EQ(loadedSamples, processedSamples);
+}
+
+TEST_F(ChunkStoreTester, Fingerprint_DifferentSettingsOrSamples_Differs) {
+    std::string fingerprint = openStore().fingerprint(samples);
+
+    EXPECT_EQ(openStore().fingerprint(samples), fingerprint);
+    EXPECT_NE(openStore(50.0f).fingerprint(samples), fingerprint);
+
+    samples[2] = 0.5f;
+    EXPECT_NE(openStore().fingerprint(samples), fingerprint);
+}
+
+TEST_F(ChunkStoreTester, Load_UnexpectedLength_ReturnsFalse) {
+    ChunkStore store = openStore();
+    std::string fingerprint = store.fingerprint(samples);
+    ASSERT_TRUE(store.save(fingerprint, samples));
+
+    std::vector<float> loadedSamples(samples.size() + 1);
+    EXPECT_FALSE(store.load(fingerprint, loadedSamples));
+    EXPECT_FALSE(store.load(store.fingerprint({}), {}));
+}
+
+TEST_F(ChunkStoreTester, Constructor_MissingModel_ThrowsException) {
+    EXPECT_THROW(ChunkStore(storeDir, 1024, testDir / "missing.tar.gz", 100.0f, 0.0f),
+                 std::runtime_error);
+}
+
+}  // namespace MediaProcessor::Tests
@@ -15,4 +15,12 @@ TEST(CommandBuilderTest, BuildCommand_ConstructsExpectedCommandString) {
     EXPECT_EQ(command, "arg1 flag arg2 flag2 value");
 }
 
+TEST(CommandBuilderTest, BuildArgv_KeepsArgumentsUnquoted) {
+    CommandBuilder builder;
+    builder.addArgument("arg1");
+    builder.addFlag("-i", "path with spaces.mp4");
+    std::vector<std::string> argv = builder.buildArgv();
+    EXPECT_EQ(argv, (std::vector<std::string>{"arg1", "-i", "path with spaces.mp4"}));
+}
+
 }  // namespace MediaProcessor::Testing
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "../src/CommandBuilder.h"
+#include "../src/CommandRunner.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST(CommandRunnerTester, Run_ArgumentWithSpaces_PassedVerbatim) {
+    CommandBuilder cmd;
+    cmd.addArgument("echo");
+    cmd.addArgument("path with spaces/and \"quotes\"");
+
+    auto result = CommandRunner::run(cmd.buildArgv());
+
+    EXPECT_TRUE(result.succeeded());
+    EXPECT_EQ(result.standardOutput, "path with spaces/and \"quotes\"\n");
+    EXPECT_TRUE(result.standardError.empty());
+}
+
+TEST(CommandRunnerTester, Run_FailingCommand_ReportsExitCodeAndStandardError) {
+    auto result = CommandRunner::run({"sh", "-c", "echo failure >&2; exit 3"});
+
+    EXPECT_FALSE(result.succeeded());
+    EXPECT_EQ(result.exitCode, 3);
+    EXPECT_EQ(result.standardError, "failure\n");
+}
+
+TEST(CommandRunnerTester, Run_LargeOutputOnBothStreams_DoesNotDeadlock) {
+    auto result = CommandRunner::run(
+        {"sh", "-c", "head -c 1000000 /dev/zero; head -c 2000000 /dev/zero >&2"});
+
+    EXPECT_TRUE(result.succeeded());
+    EXPECT_EQ(result.standardOutput.size(), 1000000u);
+    EXPECT_EQ(result.standardError.size(), 2000000u);
+}
+
+TEST(CommandRunnerTester, Run_MissingProgram_Throws) {
+    EXPECT_THROW(CommandRunner::run({"/nonexistent/program"}), std::runtime_error);
+    EXPECT_THROW(CommandRunner::run({}), std::runtime_error);
+}
+
+TEST(CommandRunnerTester, RunAsync_SeveralCommands_RunConcurrently) {
+    std::vector<std::future<CommandRunner::CommandResult>> results;
+    for (int i = 0; i < 4; ++i) {
+        results.push_back(
+            CommandRunner::runAsync({"sh", "-c", "sleep 0.2; echo " + std::to_string(i)}));
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        auto result = results[i].get();
+        EXPECT_TRUE(result.succeeded());
+        EXPECT_EQ(result.standardOutput, std::to_string(i) + "\n");
+    }
+}
+
+}  // namespace MediaProcessor::Tests
@@ -88,4 +88,21 @@ TEST_F(ConfigManagerTest, LoadInvalidConfigOptions) {
     EXPECT_THROW(configManager.getOptimalThreadCount(), std::runtime_error);
 }
 
+TEST_F(ConfigManagerTest, GetAudioChannelMode_ParsesModes) {
+    EXPECT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()));
+    EXPECT_EQ(configManager.getAudioChannelMode(), ChannelMode::Mono);
+
+    testConfigFile.changeConfigOptions("audio_channel_mode", "source");
+    EXPECT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()));
+    EXPECT_EQ(configManager.getAudioChannelMode(), ChannelMode::Source);
+
+    testConfigFile.changeConfigOptions("audio_channel_mode", "dialogue");
+    EXPECT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()));
+    EXPECT_EQ(configManager.getAudioChannelMode(), ChannelMode::Dialogue);
+
+    testConfigFile.changeConfigOptions("audio_channel_mode", "5.1");
+    EXPECT_TRUE(configManager.loadConfig(testConfigFile.getFilePath()));
+    EXPECT_THROW(configManager.getAudioChannelMode(), std::runtime_error);
+}
+
 }  // namespace MediaProcessor::Tests
\ No newline at end of file
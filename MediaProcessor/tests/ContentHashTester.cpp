@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "../src/ContentHash.h"
+
+namespace MediaProcessor::Tests {
+
+std::string hashOf(const std::string& text) {
+    ContentHash hash;
+    hash.update(text.data(), text.size());
+    return hash.finalize();
+}
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST(ContentHashTester, Finalize_KnownInputs_MatchesSha256Vectors) {
+    EXPECT_EQ(hashOf(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hashOf("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(hashOf("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(hashOf(std::string(1000000, 'a')),
+              "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(ContentHashTester, Update_SplitInput_MatchesSingleUpdate) {
+    std::string text(1000, 'x');
+    for (size_t i = 0; i < text.size(); ++i) {
+        text[i] = static_cast<char>(i * 31);
+    }
+
+    for (size_t split : {0, 1, 55, 56, 64, 65, 999}) {
+        ContentHash hash;
+        hash.update(text.data(), split);
+        hash.update(text.data() + split, text.size() - split);
+        EXPECT_EQ(hash.finalize(), hashOf(text)) << split;
+    }
+}
+
+TEST(ContentHashTester, UpdateString_ShiftedFieldBoundary_ChangesDigest) {
+    ContentHash first;
+    first.updateString("ab");
+    first.updateString("c");
+
+    ContentHash second;
+    second.updateString("a");
+    second.updateString("bc");
+
+    EXPECT_NE(first.finalize(), second.finalize());
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include "../src/DiskCache.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class DiskCacheTester : public ::testing::Test {
+   protected:
+    fs::path testDir = fs::temp_directory_path() / "DiskCacheTester";
+    fs::path cacheDir = testDir / "cache";
+
+    void SetUp() override {
+        fs::create_directories(testDir);
+    }
+
+    void TearDown() override {
+        fs::remove_all(testDir);
+    }
+
+    fs::path writeFile(const std::string& name, size_t size) {
+        fs::path path = testDir / name;
+        std::ofstream(path, std::ios::binary) << std::string(size, name.front());
+        return path;
+    }
+
+    // Keeps the modification times of consecutive operations apart
+    void waitForClockTick() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+};
+
+TEST_F(DiskCacheTester, Retrieve_StoredEntry_PlacesCopyAtDestination) {
+    DiskCache cache(cacheDir, 1024);
+    ASSERT_TRUE(cache.store("key", writeFile("source", 100)));
+
+    fs::path destination = testDir / "destination";
+    ASSERT_TRUE(cache.retrieve("key", destination));
+
+    EXPECT_EQ(fs::file_size(destination), 100);
+    EXPECT_EQ(cache.getSize(), 100);
+}
+
+TEST_F(DiskCacheTester, Store_InMemoryData_WritesEntry) {
+    DiskCache cache(cacheDir, 1024);
+    std::string data = "processed";
+    ASSERT_TRUE(cache.store("key", std::span<const char>(data.data(), data.size())));
+
+    auto entryPath = cache.lookup("key");
+    ASSERT_TRUE(entryPath.has_value());
+    EXPECT_EQ(fs::file_size(*entryPath), data.size());
+}
+
+TEST_F(DiskCacheTester, Retrieve_MissingKey_ReturnsFalse) {
+    DiskCache cache(cacheDir, 1024);
+
+    EXPECT_FALSE(cache.lookup("missing").has_value());
+    EXPECT_FALSE(cache.retrieve("missing", testDir / "destination"));
+    EXPECT_FALSE(fs::exists(testDir / "destination"));
+}
+
+TEST_F(DiskCacheTester, Store_OverSizeCap_EvictsLeastRecentlyUsed) {
+    DiskCache cache(cacheDir, 250);
+    ASSERT_TRUE(cache.store("first", writeFile("a", 100)));
+    waitForClockTick();
+    ASSERT_TRUE(cache.store("second", writeFile("b", 100)));
+    waitForClockTick();
+    ASSERT_TRUE(cache.lookup("first").has_value());
+    waitForClockTick();
+
+    ASSERT_TRUE(cache.store("third", writeFile("c", 100)));
+
+    EXPECT_TRUE(cache.lookup("first").has_value());
+    EXPECT_FALSE(cache.lookup("second").has_value());
+    EXPECT_TRUE(cache.lookup("third").has_value());
+    EXPECT_EQ(cache.getSize(), 200);
+}
+
+TEST_F(DiskCacheTester, Store_OverSizeCap_TrimsBelowCapOnce) {
+    DiskCache cache(cacheDir, 1000);
+    for (int i = 0; i < 11; ++i) {
+        ASSERT_TRUE(cache.store("entry" + std::to_string(i), writeFile("source", 100)));
+        waitForClockTick();
+    }
+
+    // Trimmed to 90% of the cap, so the next store fits without evicting
+    EXPECT_EQ(cache.getSize(), 900);
+    EXPECT_FALSE(cache.lookup("entry1").has_value());
+    ASSERT_TRUE(cache.store("entry11", writeFile("source", 100)));
+    EXPECT_EQ(cache.getSize(), 1000);
+    EXPECT_TRUE(cache.lookup("entry2").has_value());
+}
+
+TEST_F(DiskCacheTester, Store_FileLargerThanCap_IsNotStored) {
+    DiskCache cache(cacheDir, 50);
+
+    EXPECT_FALSE(cache.store("key", writeFile("source", 100)));
+    EXPECT_FALSE(cache.lookup("key").has_value());
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST_F(DiskCacheTester, Commit_StagedFile_PublishedOnlyOnCommit) {
+    DiskCache cache(cacheDir, 1024);
+    const fs::path stagingPath = cache.getStagingPath("key");
+    std::ofstream(stagingPath, std::ios::binary) << std::string(100, 's');
+
+    EXPECT_FALSE(cache.lookup("key").has_value());
+    EXPECT_EQ(cache.getSize(), 0);
+
+    ASSERT_TRUE(cache.commit("key", stagingPath));
+    EXPECT_TRUE(cache.lookup("key").has_value());
+    EXPECT_FALSE(fs::exists(stagingPath));
+    EXPECT_EQ(cache.getSize(), 100);
+}
+
+TEST_F(DiskCacheTester, Commit_StagedFileLargerThanCap_IsRemoved) {
+    DiskCache cache(cacheDir, 50);
+    const fs::path stagingPath = cache.getStagingPath("key");
+    std::ofstream(stagingPath, std::ios::binary) << std::string(100, 's');
+
+    EXPECT_FALSE(cache.commit("key", stagingPath));
+    EXPECT_FALSE(cache.lookup("key").has_value());
+    EXPECT_FALSE(fs::exists(stagingPath));
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "../src/JobMetrics.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+using namespace std::chrono_literals;
+using Stage = JobMetrics::Stage;
+
+TEST(JobMetricsTester, Add_ConcurrentThreads_AccumulatesCoreSeconds) {
+    JobMetrics metrics;
+    metrics.setAudioDuration(10.0);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&metrics] {
+            for (int j = 0; j < 100; ++j) {
+                metrics.add(Stage::Filter, 10ms);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_DOUBLE_EQ(metrics.getStageSeconds(Stage::Filter), 4.0);
+    EXPECT_DOUBLE_EQ(metrics.getRealTimeFactor(Stage::Filter), 0.4);
+    EXPECT_DOUBLE_EQ(metrics.getStageSeconds(Stage::Merge), 0.0);
+}
+
+TEST(JobMetricsTester, GetRealTimeFactor_UnknownAudioDuration_ReturnsZero) {
+    JobMetrics metrics;
+    metrics.add(Stage::Decode, 1s);
+
+    EXPECT_EQ(metrics.getRealTimeFactor(), 0.0);
+    EXPECT_EQ(metrics.getRealTimeFactor(Stage::Decode), 0.0);
+}
+
+TEST(JobMetricsTester, Finish_CalledTwice_KeepsFirstWallTime) {
+    JobMetrics metrics;
+    {
+        JobMetrics::ScopedTimer timer(&metrics, Stage::Probe);
+        std::this_thread::sleep_for(5ms);
+    }
+    metrics.finish();
+    const double wallSeconds = metrics.getWallSeconds();
+    std::this_thread::sleep_for(5ms);
+    metrics.finish();
+
+    EXPECT_EQ(metrics.getWallSeconds(), wallSeconds);
+    EXPECT_GE(metrics.getStageSeconds(Stage::Probe), 0.005);
+    EXPECT_LE(metrics.getStageSeconds(Stage::Probe), wallSeconds);
+}
+
+TEST(JobMetricsTester, ToJson_AllStages_ReportsEveryStageRtf) {
+    JobMetrics metrics;
+    metrics.setAudioDuration(2.0);
+    metrics.add(Stage::Mux, 1s);
+    metrics.finish();
+
+    const nlohmann::json json = metrics.toJson();
+
+    EXPECT_DOUBLE_EQ(json["audio_seconds"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(json["rtf"].get<double>(), json["wall_seconds"].get<double>() / 2.0);
+    for (const char* stage : {"probe", "decode", "filter", "merge", "mux"}) {
+        EXPECT_TRUE(json["stage_rtf"].contains(stage)) << stage;
+    }
+    EXPECT_DOUBLE_EQ(json["stage_rtf"]["mux"].get<double>(), 0.5);
+    EXPECT_NE(metrics.formatReport().find("mux 0.500"), std::string::npos);
+}
+
+TEST(JobMetricsTester, AddCounters_NoneRecorded_OmitsCounters) {
+    JobMetrics metrics;
+    metrics.add(Stage::Filter, 1s);
+
+    EXPECT_FALSE(metrics.toJson().contains("counters"));
+    EXPECT_EQ(metrics.formatReport().find('\n'), std::string::npos);
+}
+
+TEST(JobMetricsTester, AddCounters_SeveralUnits_AccumulatesPerStage) {
+    JobMetrics metrics;
+    metrics.addCounters(Stage::Filter, {100, 200, 3, 1});
+    metrics.addCounters(Stage::Filter, {50, 100, 2, 0});
+
+    EXPECT_EQ(metrics.getStageCounter(Stage::Filter, PerfCounters::Counter::Cycles), 150u);
+    EXPECT_EQ(metrics.getStageCounter(Stage::Filter, PerfCounters::Counter::Instructions), 300u);
+    EXPECT_EQ(metrics.getStageCounter(Stage::Filter, PerfCounters::Counter::CacheMisses), 5u);
+    EXPECT_EQ(metrics.getStageCounter(Stage::Merge, PerfCounters::Counter::Cycles), 0u);
+    EXPECT_TRUE(metrics.toJson().contains("counters"));
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "../src/JobScheduler.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST(JobSchedulerTester, Admit_SingleJob_GetsEveryCore) {
+    JobScheduler scheduler(8, 0.0, 0);
+
+    auto lease = scheduler.admit(JobPriority::Batch, 60.0);
+    ASSERT_TRUE(lease.has_value());
+    EXPECT_EQ(lease->getCoreShare(), 8);
+}
+
+TEST(JobSchedulerTester, Admit_InteractiveAndBatch_SharesWeightedByPriority) {
+    JobScheduler scheduler(10, 0.0, 0);
+
+    auto batchLease = scheduler.admit(JobPriority::Batch, 60.0);
+    auto interactiveLease = scheduler.admit(JobPriority::Interactive, 60.0);
+    ASSERT_TRUE(batchLease && interactiveLease);
+
+    EXPECT_EQ(interactiveLease->getCoreShare(), 8);
+    EXPECT_EQ(batchLease->getCoreShare(), 2);
+    EXPECT_NE(&interactiveLease->getThreadPool(), &batchLease->getThreadPool());
+
+    interactiveLease.reset();
+    EXPECT_EQ(batchLease->getCoreShare(), 10);
+}
+
+TEST(JobSchedulerTester, Admit_ManyJobs_EveryJobKeepsOneCore) {
+    JobScheduler scheduler(2, 0.0, 0);
+
+    auto first = scheduler.admit(JobPriority::Batch, 0.0);
+    auto second = scheduler.admit(JobPriority::Batch, 0.0);
+    auto third = scheduler.admit(JobPriority::Batch, 0.0);
+
+    EXPECT_EQ(first->getCoreShare(), 1);
+    EXPECT_EQ(second->getCoreShare(), 1);
+    EXPECT_EQ(third->getCoreShare(), 1);
+}
+
+TEST(JobSchedulerTester, Admit_InteractiveBacklogOverSlo_Rejected) {
+    // 1 core, 400s of media cost about 100 core-seconds with the default estimate
+    JobScheduler scheduler(1, 150.0, 0);
+
+    auto running = scheduler.admit(JobPriority::Interactive, 400.0);
+    ASSERT_TRUE(running.has_value());
+
+    EXPECT_FALSE(scheduler.admit(JobPriority::Interactive, 400.0).has_value());
+    EXPECT_TRUE(scheduler.admit(JobPriority::Interactive, 40.0).has_value());
+}
+
+TEST(JobSchedulerTester, Admit_BatchBacklogOverSlo_WaitsForRunningJobs) {
+    JobScheduler scheduler(1, 150.0, 0);
+
+    auto running = scheduler.admit(JobPriority::Interactive, 400.0);
+    std::atomic<bool> admitted = false;
+    std::thread batchJob([&]() {
+        auto lease = scheduler.admit(JobPriority::Batch, 400.0);
+        admitted = lease.has_value();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(admitted);
+
+    running.reset();
+    batchJob.join();
+    EXPECT_TRUE(admitted);
+}
+
+TEST(JobSchedulerTester, Lease_BatchJob_RunsOnNicedWorkers) {
+    JobScheduler scheduler(2, 0.0, 5);
+
+    auto batchLease = scheduler.admit(JobPriority::Batch, 0.0);
+    auto interactiveLease = scheduler.admit(JobPriority::Interactive, 0.0);
+    const int baseNiceness = getpriority(PRIO_PROCESS, 0);
+
+    auto niceness = []() { return getpriority(PRIO_PROCESS, 0); };
+    EXPECT_EQ(batchLease->getThreadPool().enqueue(niceness).get(), std::min(baseNiceness + 5, 19));
+    EXPECT_EQ(interactiveLease->getThreadPool().enqueue(niceness).get(), baseNiceness);
+}
+
+}  // namespace MediaProcessor::Tests
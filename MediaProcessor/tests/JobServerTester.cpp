@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <thread>
+
+#include "../src/JobServer.h"
+#include "../src/SocketUtils.h"
+
+namespace MediaProcessor::Tests {
+
+class JobServerTester : public ::testing::Test {
+   protected:
+    fs::path socketPath = fs::temp_directory_path() / "MediaProcessorTest.sock";
+    JobServer server{socketPath, 2, 0.0, 0};
+    std::thread serverThread;
+
+    void SetUp() override {
+        serverThread = std::thread([this]() { server.run(); });
+    }
+
+    void TearDown() override {
+        server.stop();
+        if (serverThread.joinable()) {
+            serverThread.join();
+        }
+    }
+
+    int connectToServer() {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+        // The server binds asynchronously
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0) {
+                return fd;
+            }
+            close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return -1;
+    }
+
+    nlohmann::json request(int fd, const nlohmann::json& message) {
+        EXPECT_TRUE(SocketUtils::writeMessage(fd, message.dump()));
+        auto reply = SocketUtils::readMessage(fd);
+        return reply ? nlohmann::json::parse(*reply) : nlohmann::json();
+    }
+};
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST_F(JobServerTester, Run_Ping_RepliesOk) {
+    int fd = connectToServer();
+    ASSERT_GE(fd, 0);
+
+    EXPECT_EQ(request(fd, {{"command", "ping"}})["status"], "ok");
+    EXPECT_EQ(request(fd, {{"command", "ping"}})["status"], "ok");
+    close(fd);
+}
+
+TEST_F(JobServerTester, Run_InvalidRequests_ReplyFailed) {
+    int fd = connectToServer();
+    ASSERT_GE(fd, 0);
+
+    EXPECT_EQ(request(fd, {{"command", "unknown"}})["status"], "failed");
+    EXPECT_EQ(request(fd, {{"command", "process"}})["status"], "failed");
+
+    ASSERT_TRUE(SocketUtils::writeMessage(fd, "not json"));
+    auto reply = SocketUtils::readMessage(fd);
+    ASSERT_TRUE(reply.has_value());
+    EXPECT_EQ(nlohmann::json::parse(*reply)["status"], "failed");
+    close(fd);
+}
+
+TEST_F(JobServerTester, Run_Listening_SocketIsPrivateToUser) {
+    int fd = connectToServer();
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    struct stat status;
+    ASSERT_EQ(stat(socketPath.c_str(), &status), 0);
+    EXPECT_EQ(status.st_mode & 0777, 0600u);
+}
+
+TEST_F(JobServerTester, Run_RegularFileAtSocketPath_ThrowsAndKeepsFile) {
+    const fs::path filePath = fs::temp_directory_path() / "MediaProcessorTest.notasocket";
+    std::ofstream(filePath) << "data";
+
+    JobServer otherServer{filePath, 1, 0.0, 0};
+    EXPECT_THROW(otherServer.run(), std::runtime_error);
+    EXPECT_TRUE(fs::is_regular_file(filePath));
+    fs::remove(filePath);
+}
+
+TEST_F(JobServerTester, Run_Shutdown_StopsServerAndRemovesSocket) {
+    int fd = connectToServer();
+    ASSERT_GE(fd, 0);
+
+    EXPECT_EQ(request(fd, {{"command", "shutdown"}})["status"], "ok");
+    close(fd);
+
+    serverThread.join();
+    EXPECT_FALSE(fs::exists(socketPath));
+    serverThread = std::thread();
+}
+
+}  // namespace MediaProcessor::Tests
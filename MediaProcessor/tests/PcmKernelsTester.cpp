@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../src/PcmKernels.h"
+
+namespace MediaProcessor::Tests {
+
+using namespace PcmKernels;
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class PcmKernelsTester : public ::testing::Test {
+   protected:
+    SimdLevel initialLevel = getSimdLevel();
+
+    void TearDown() override {
+        setSimdLevel(initialLevel);
+    }
+
+    /**
+     * @return Every level the CPU supports, scalar first.
+     */
+    static std::vector<SimdLevel> getSupportedLevels() {
+        std::vector<SimdLevel> levels;
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2,
+                                SimdLevel::AVX512, SimdLevel::NEON}) {
+            const SimdLevel previous = getSimdLevel();
+            if (setSimdLevel(level)) {
+                levels.push_back(level);
+            }
+            setSimdLevel(previous);
+        }
+        return levels;
+    }
+
+    /**
+     * @brief Random samples, partly out of range, with the edge cases the kernels must agree on.
+     */
+    static std::vector<float> generateSamples(size_t count) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-1.5f, 1.5f);
+        std::vector<float> samples(count);
+        for (float& sample : samples) {
+            sample = distribution(generator);
+        }
+
+        const std::array<float, 8> edgeCases = {
+            -1.0f, 1.0f, 32767.0f / 32768.0f, 0.5f / 32768.0f, 1.5f / 32768.0f, 0.0f, -0.0f,
+            std::numeric_limits<float>::quiet_NaN()};
+        for (size_t i = 0; i < edgeCases.size() && i < count; ++i) {
+            samples[i * 7 % count] = edgeCases[i];
+        }
+        return samples;
+    }
+};
+
+TEST_F(PcmKernelsTester, SetSimdLevel_Scalar_AlwaysSupported) {
+    EXPECT_TRUE(setSimdLevel(SimdLevel::Scalar));
+    EXPECT_EQ(getSimdLevel(), SimdLevel::Scalar);
+
+    EXPECT_TRUE(setSimdLevel(getSupportedSimdLevel()));
+    EXPECT_EQ(getSimdLevel(), getSupportedSimdLevel());
+}
+
+TEST_F(PcmKernelsTester, SetSimdLevel_UnsupportedLevel_KeepsSelection) {
+    const SimdLevel unsupported =
+        getSupportedSimdLevel() == SimdLevel::NEON ? SimdLevel::AVX2 : SimdLevel::NEON;
+    setSimdLevel(SimdLevel::Scalar);
+
+    EXPECT_FALSE(setSimdLevel(unsupported));
+    EXPECT_EQ(getSimdLevel(), SimdLevel::Scalar);
+}
+
+TEST_F(PcmKernelsTester, ConvertFromFloat_EverySimdLevel_MatchesScalar) {
+    // Odd length, so the scalar tails of the vector loops run as well
+    const std::vector<float> samples = generateSamples(1027);
+
+    setSimdLevel(SimdLevel::Scalar);
+    std::vector<int16_t> expected16(samples.size());
+    std::vector<int32_t> expected32(samples.size());
+    convertFromFloat(samples, SampleFormat::S16, expected16.data());
+    convertFromFloat(samples, SampleFormat::S32, expected32.data());
+
+    for (SimdLevel level : getSupportedLevels()) {
+        ASSERT_TRUE(setSimdLevel(level));
+        std::vector<int16_t> actual16(samples.size());
+        std::vector<int32_t> actual32(samples.size());
+        convertFromFloat(samples, SampleFormat::S16, actual16.data());
+        convertFromFloat(samples, SampleFormat::S32, actual32.data());
+
+        EXPECT_EQ(actual16, expected16) << getSimdLevelName(level);
+        EXPECT_EQ(actual32, expected32) << getSimdLevelName(level);
+    }
+
+    EXPECT_EQ(expected16[0], -32768);  // the -1.0 edge case
+    EXPECT_EQ(expected16[7], 32767);   // 1.0 clamps to the largest value
+}
+
+TEST_F(PcmKernelsTester, ConvertToFloat_EverySimdLevel_MatchesScalar) {
+    std::vector<int16_t> samples16(1029);
+    std::vector<int32_t> samples32(samples16.size());
+    std::mt19937 generator(7);
+    for (size_t i = 0; i < samples16.size(); ++i) {
+        samples16[i] = static_cast<int16_t>(generator());
+        samples32[i] = static_cast<int32_t>(generator());
+    }
+
+    setSimdLevel(SimdLevel::Scalar);
+    std::vector<float> expected16(samples16.size());
+    std::vector<float> expected32(samples32.size());
+    convertToFloat(samples16.data(), SampleFormat::S16, expected16);
+    convertToFloat(samples32.data(), SampleFormat::S32, expected32);
+
+    for (SimdLevel level : getSupportedLevels()) {
+        ASSERT_TRUE(setSimdLevel(level));
+        std::vector<float> actual16(samples16.size());
+        std::vector<float> actual32(samples32.size());
+        convertToFloat(samples16.data(), SampleFormat::S16, actual16);
+        convertToFloat(samples32.data(), SampleFormat::S32, actual32);
+
+        EXPECT_EQ(actual16, expected16) << getSimdLevelName(level);
+        EXPECT_EQ(actual32, expected32) << getSimdLevelName(level);
+    }
+}
+
+TEST_F(PcmKernelsTester, ConvertFromFloat_IntegerRoundTrip_IsExact) {
+    std::vector<int16_t> samples16(65536);
+    for (size_t i = 0; i < samples16.size(); ++i) {
+        samples16[i] = static_cast<int16_t>(static_cast<int32_t>(i) - 32768);
+    }
+    std::vector<float> floats(samples16.size());
+    std::vector<int16_t> roundTrip16(samples16.size());
+    convertToFloat(samples16.data(), SampleFormat::S16, floats);
+    convertFromFloat(floats, SampleFormat::S16, roundTrip16.data());
+    EXPECT_EQ(roundTrip16, samples16);
+
+    // Packed 24-bit, including both extremes
+    std::vector<uint8_t> samples24(3 * 4099);
+    std::mt19937 generator(3);
+    for (uint8_t& byte : samples24) {
+        byte = static_cast<uint8_t>(generator());
+    }
+    const std::array<uint8_t, 6> extremes = {0x00, 0x00, 0x80, 0xFF, 0xFF, 0x7F};
+    std::memcpy(samples24.data(), extremes.data(), extremes.size());
+
+    std::vector<float> floats24(samples24.size() / 3);
+    std::vector<uint8_t> roundTrip24(samples24.size());
+    convertToFloat(samples24.data(), SampleFormat::S24, floats24);
+    convertFromFloat(floats24, SampleFormat::S24, roundTrip24.data());
+    EXPECT_EQ(roundTrip24, samples24);
+    EXPECT_FLOAT_EQ(floats24[0], -1.0f);
+}
+
+TEST_F(PcmKernelsTester, InterleaveFromFloat_SixChannels_RoundTrips) {
+    constexpr size_t channels = 6;
+    constexpr size_t numFrames = 3001;  // spans several scratch blocks
+
+    std::vector<std::vector<float>> planes(channels, std::vector<float>(numFrames));
+    std::vector<const float*> inputs;
+    for (size_t channel = 0; channel < channels; ++channel) {
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            // Distinct per channel and exactly representable in 16 bits
+            const int value = static_cast<int>(frame % 1000 * 6 + channel) - 3000;
+            planes[channel][frame] = static_cast<float>(value) / 32768.0f;
+        }
+        inputs.push_back(planes[channel].data());
+    }
+
+    std::vector<int16_t> interleaved(channels * numFrames);
+    interleaveFromFloat(inputs, numFrames, SampleFormat::S16, interleaved.data());
+    EXPECT_EQ(interleaved[1], static_cast<int16_t>(1 - 3000));
+    EXPECT_EQ(interleaved[channels * 2 + 5], static_cast<int16_t>(2 * 6 + 5 - 3000));
+
+    std::vector<std::vector<float>> decoded(channels, std::vector<float>(numFrames));
+    std::vector<float*> outputs;
+    for (auto& plane : decoded) {
+        outputs.push_back(plane.data());
+    }
+    deinterleaveToFloat(interleaved.data(), SampleFormat::S16, numFrames, outputs);
+    EXPECT_EQ(decoded, planes);
+}
+
+TEST_F(PcmKernelsTester, InterleaveFromFloat_Dither_StaysWithinOneLsb) {
+    std::vector<float> samples(10000);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = static_cast<float>(static_cast<int>(i % 2001) - 1000) / 32768.0f;
+    }
+    const float* input = samples.data();
+
+    Dither dither(123);
+    std::vector<int16_t> output(samples.size());
+    interleaveFromFloat({&input, 1}, samples.size(), SampleFormat::S16, output.data(), &dither);
+
+    size_t changed = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const int expected = static_cast<int>(i % 2001) - 1000;
+        EXPECT_LE(std::abs(output[i] - expected), 1);
+        changed += output[i] != expected;
+    }
+    // Triangular noise of +/-1 LSB moves about a quarter of exact samples
+    EXPECT_GT(changed, samples.size() / 10);
+    EXPECT_LT(changed, samples.size() / 2);
+}
+
+TEST_F(PcmKernelsTester, Mix_EverySimdLevel_MatchesScalar) {
+    const std::vector<float> input = generateSamples(1031);
+    std::vector<float> base(input.size());
+    for (size_t i = 0; i < base.size(); ++i) {
+        base[i] = static_cast<float>(i) / 2048.0f - 0.25f;
+    }
+
+    setSimdLevel(SimdLevel::Scalar);
+    std::vector<float> expected = base;
+    mix(expected, input, 0.7071f);
+    std::vector<float> expectedGain = input;
+    applyGain(expectedGain, 0.3f);
+    std::vector<float> expectedClamp = input;
+    clamp(expectedClamp);
+
+    for (SimdLevel level : getSupportedLevels()) {
+        ASSERT_TRUE(setSimdLevel(level));
+        std::vector<float> mixed = base;
+        mix(mixed, input, 0.7071f);
+        std::vector<float> gained = input;
+        applyGain(gained, 0.3f);
+        std::vector<float> clamped = input;
+        clamp(clamped);
+
+        // Compared bitwise, NaN != NaN
+        EXPECT_EQ(std::memcmp(mixed.data(), expected.data(), mixed.size() * sizeof(float)), 0)
+            << getSimdLevelName(level);
+        EXPECT_EQ(std::memcmp(gained.data(), expectedGain.data(), gained.size() * sizeof(float)),
+                  0)
+            << getSimdLevelName(level);
+        EXPECT_EQ(clamped, expectedClamp) << getSimdLevelName(level);
+    }
+
+    for (float sample : expectedClamp) {
+        EXPECT_GE(sample, -1.0f);
+        EXPECT_LE(sample, 1.0f);
+    }
+}
+
+TEST_F(PcmKernelsTester, DotProduct_EverySimdLevel_MatchesReference) {
+    // Past the edge cases, one of them is NaN; odd length for the scalar tails
+    const std::vector<float> samples = generateSamples(1097);
+    const std::span<const float> a = std::span<const float>(samples).subspan(64);
+    std::vector<float> b(a.size());
+    double expected = 0.0;
+    for (size_t i = 0; i < b.size(); ++i) {
+        b[i] = std::sin(static_cast<float>(i) * 0.1f);
+        expected += static_cast<double>(a[i]) * b[i];
+    }
+
+    for (SimdLevel level : getSupportedLevels()) {
+        ASSERT_TRUE(setSimdLevel(level));
+        // Each variant sums in its own order, equal only up to rounding
+        EXPECT_NEAR(dotProduct(a, b.data()), expected, 1e-3) << getSimdLevelName(level);
+        EXPECT_EQ(dotProduct(a.first(0), b.data()), 0.0f) << getSimdLevelName(level);
+    }
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "../src/PerfCounters.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+using namespace std::chrono_literals;
+using Counter = PerfCounters::Counter;
+
+class PerfCountersTester : public ::testing::Test {
+   protected:
+    PerfCounters& perfCounters = PerfCounters::getInstance();
+
+    void TearDown() override {
+        perfCounters.disable();
+    }
+};
+
+TEST_F(PerfCountersTester, ReadThread_Disabled_ReturnsZeros) {
+    EXPECT_EQ(perfCounters.readThread(), PerfCounters::Values{});
+}
+
+TEST_F(PerfCountersTester, Enable_Probed_EnabledOnlyWithAvailableCounters) {
+    const bool enabled = perfCounters.enable();
+
+    bool anyAvailable = false;
+    for (size_t i = 0; i < PerfCounters::COUNTER_COUNT; ++i) {
+        anyAvailable |= perfCounters.isAvailable(static_cast<Counter>(i));
+    }
+    EXPECT_EQ(enabled, anyAvailable);
+    EXPECT_EQ(perfCounters.isEnabled(), anyAvailable);
+}
+
+TEST_F(PerfCountersTester, ReadThread_AcrossWork_CountsOnlyAvailableCounters) {
+    // Kernels may forbid perf events entirely, e.g. in containers
+    if (!perfCounters.enable()) {
+        GTEST_SKIP() << "perf events are not permitted here";
+    }
+
+    const PerfCounters::Values before = perfCounters.readThread();
+    volatile double sum = 0.0;
+    for (int i = 0; i < 1'000'000; ++i) {
+        sum = sum + i * 0.5;
+    }
+    std::this_thread::sleep_for(5ms);  // a voluntary context switch
+    const PerfCounters::Values after = perfCounters.readThread();
+
+    for (size_t i = 0; i < PerfCounters::COUNTER_COUNT; ++i) {
+        const Counter counter = static_cast<Counter>(i);
+        if (!perfCounters.isAvailable(counter)) {
+            EXPECT_EQ(after[i], 0u) << PerfCounters::getCounterName(counter);
+        } else if (counter != Counter::CacheMisses) {
+            EXPECT_GT(after[i], before[i]) << PerfCounters::getCounterName(counter);
+        }
+    }
+}
+
+TEST_F(PerfCountersTester, ReadThread_OtherThreadBusy_DoesNotCountIt) {
+    if (!perfCounters.enable() || !perfCounters.isAvailable(Counter::ContextSwitches)) {
+        GTEST_SKIP() << "context switch counter is not available here";
+    }
+
+    const PerfCounters::Values before = perfCounters.readThread();
+    std::thread([] {
+        for (int i = 0; i < 20; ++i) {
+            std::this_thread::sleep_for(1ms);
+        }
+    }).join();
+    const PerfCounters::Values after = perfCounters.readThread();
+
+    // Joining blocks this thread once or a few times, never once per sleep of the other thread
+    const size_t index = static_cast<size_t>(Counter::ContextSwitches);
+    EXPECT_LT(after[index] - before[index], 20u);
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../src/PolyphaseResampler.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class PolyphaseResamplerTester : public ::testing::Test {
+   protected:
+    static std::vector<float> generateSine(double frequency, int sampleRate, size_t count) {
+        std::vector<float> samples(count);
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] = static_cast<float>(
+                0.5 * std::sin(2.0 * std::numbers::pi * frequency * static_cast<double>(i) /
+                               sampleRate));
+        }
+        return samples;
+    }
+
+    /**
+     * @brief Resamples `input` in blocks of `blockSize`, the last one followed by a flush.
+     */
+    static std::vector<float> resample(PolyphaseResampler& resampler,
+                                       const std::vector<float>& input, size_t blockSize) {
+        std::vector<float> output;
+        for (size_t offset = 0; offset < input.size(); offset += blockSize) {
+            const std::span<const float> block(input.data() + offset,
+                                               std::min(blockSize, input.size() - offset));
+            const size_t start = output.size();
+            output.resize(start + resampler.getMaxOutputFrames(block.size()));
+            output.resize(start + resampler.process(block, output.data() + start));
+        }
+
+        const size_t start = output.size();
+        output.resize(start + resampler.getMaxOutputFrames(0));
+        output.resize(start + resampler.flush(output.data() + start));
+        return output;
+    }
+};
+
+TEST_F(PolyphaseResamplerTester, Process_EqualRates_CopiesInput) {
+    PolyphaseResampler resampler(48000, 48000);
+    EXPECT_TRUE(resampler.isPassthrough());
+
+    const std::vector<float> input = generateSine(440.0, 48000, 1000);
+    EXPECT_EQ(resample(resampler, input, 300), input);
+}
+
+TEST_F(PolyphaseResamplerTester, Process_44100To48000_MatchesSine) {
+    constexpr size_t inputFrames = 44100;
+    PolyphaseResampler resampler(44100, 48000);
+    const std::vector<float> output =
+        resample(resampler, generateSine(1000.0, 44100, inputFrames), 4096);
+
+    ASSERT_EQ(output.size(), (inputFrames * 160 + 146) / 147);
+
+    // Without delay compensation the output would lag by half the filter
+    const std::vector<float> expected = generateSine(1000.0, 48000, output.size());
+    const size_t margin = resampler.getTapsPerPhase();
+    for (size_t i = margin; i < output.size() - margin; ++i) {
+        ASSERT_NEAR(output[i], expected[i], 1e-3) << i;
+    }
+}
+
+TEST_F(PolyphaseResamplerTester, Process_BlockSizes_ProduceIdenticalOutput) {
+    const std::vector<float> input = generateSine(3000.0, 44100, 20011);
+
+    PolyphaseResampler resampler(44100, 48000);
+    const std::vector<float> expected = resample(resampler, input, input.size());
+
+    // The state is reset by the flush, so the same instance resamples every split
+    for (size_t blockSize : {1, 7, 480, 4096}) {
+        EXPECT_EQ(resample(resampler, input, blockSize), expected) << blockSize;
+    }
+}
+
+TEST_F(PolyphaseResamplerTester, Process_48000To44100_RejectsAliasingTones) {
+    PolyphaseResampler resampler(48000, 44100);
+
+    // Above the output's Nyquist frequency, folds back to 21.1kHz without filtering
+    const std::vector<float> output = resample(resampler, generateSine(23000.0, 48000, 48000), 512);
+
+    const size_t margin = resampler.getTapsPerPhase();
+    double energy = 0.0;
+    for (size_t i = margin; i < output.size() - margin; ++i) {
+        energy += output[i] * output[i];
+    }
+    const double rms = std::sqrt(energy / static_cast<double>(output.size() - 2 * margin));
+    EXPECT_LT(rms, 0.5 * 0.01);  // 40dB below the input
+}
+
+TEST_F(PolyphaseResamplerTester, Process_RoundTrip_RestoresSignal) {
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<double> frequencies(100.0, 8000.0);
+    std::vector<float> input(44100 * 2, 0.0f);
+    for (int tone = 0; tone < 4; ++tone) {
+        const std::vector<float> sine = generateSine(frequencies(generator), 44100, input.size());
+        for (size_t i = 0; i < input.size(); ++i) {
+            input[i] += sine[i] / 4.0f;
+        }
+    }
+
+    PolyphaseResampler upsampler(44100, 48000);
+    PolyphaseResampler downsampler(48000, 44100);
+    const std::vector<float> output =
+        resample(downsampler, resample(upsampler, input, 1000), 1000);
+
+    ASSERT_EQ(output.size(), input.size());
+    const size_t margin = 2 * upsampler.getTapsPerPhase();
+    for (size_t i = margin; i < input.size() - margin; ++i) {
+        ASSERT_NEAR(output[i], input[i], 2e-3) << i;
+    }
+}
+
+TEST_F(PolyphaseResamplerTester, Constructor_UnsupportedRatio_Throws) {
+    EXPECT_FALSE(PolyphaseResampler::supports(44099, 48000));
+    EXPECT_TRUE(PolyphaseResampler::supports(11025, 48000));
+    EXPECT_THROW(PolyphaseResampler(44099, 48000), std::runtime_error);
+    EXPECT_THROW(PolyphaseResampler(0, 48000), std::runtime_error);
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../src/SignalGenerator.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+
+std::vector<float> generate(int channels, size_t numFrames, uint32_t seed = DEFAULT_SIGNAL_SEED) {
+    std::vector<float> samples(numFrames * channels);
+    SignalGenerator(SAMPLE_RATE, channels, seed).generate(samples.data(), numFrames);
+    return samples;
+}
+
+double getChannelRms(const std::vector<float>& samples, int channels, int channel) {
+    double sum = 0.0;
+    for (size_t i = channel; i < samples.size(); i += channels) {
+        sum += samples[i] * samples[i];
+    }
+    return std::sqrt(sum / (samples.size() / channels));
+}
+
+}  // namespace
+
+TEST(SignalGeneratorTester, Generate_DifferentBlockSizes_ProducesIdenticalSignal) {
+    const size_t numFrames = 3 * SAMPLE_RATE;
+    const std::vector<float> expected = generate(2, numFrames);
+
+    SignalGenerator generator(SAMPLE_RATE, 2);
+    std::vector<float> actual(numFrames * 2);
+    for (size_t offset = 0, block = 1; offset < numFrames; block = block * 7 % 10007) {
+        const size_t frames = std::min(block, numFrames - offset);
+        generator.generate(actual.data() + offset * 2, frames);
+        offset += frames;
+    }
+
+    EXPECT_EQ(actual, expected);
+}
+
+TEST(SignalGeneratorTester, Generate_Seed_SelectsSignal) {
+    EXPECT_EQ(generate(1, SAMPLE_RATE, 7), generate(1, SAMPLE_RATE, 7));
+    EXPECT_NE(generate(1, SAMPLE_RATE, 7), generate(1, SAMPLE_RATE, 8));
+}
+
+TEST(SignalGeneratorTester, Generate_LongSignal_StaysAudibleAndUnclipped) {
+    const std::vector<float> samples = generate(1, 20 * SAMPLE_RATE);
+
+    const auto [minimum, maximum] = std::minmax_element(samples.begin(), samples.end());
+    EXPECT_GE(*minimum, -1.0f);
+    EXPECT_LE(*maximum, 1.0f);
+    EXPECT_GT(getChannelRms(samples, 1, 0), 0.01);
+}
+
+TEST(SignalGeneratorTester, GetDialogueChannel_SurroundLayout_PutsSpeechOnCenterOnly) {
+    EXPECT_EQ(SignalGenerator::getDialogueChannel(1), -1);
+    EXPECT_EQ(SignalGenerator::getDialogueChannel(2), -1);
+    EXPECT_EQ(SignalGenerator::getDialogueChannel(6), 2);
+
+    // Speech pauses between sentences, music does not, so FC is the channel with silent spans
+    const int channels = 6;
+    const std::vector<float> samples = generate(channels, 20 * SAMPLE_RATE);
+    auto hasSilentSpan = [&](int channel) {
+        size_t quietRun = 0;
+        for (size_t i = channel; i < samples.size(); i += channels) {
+            quietRun = std::abs(samples[i]) < 1e-4f ? quietRun + 1 : 0;
+            if (quietRun > SAMPLE_RATE / 10) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    EXPECT_TRUE(hasSilentSpan(SignalGenerator::getDialogueChannel(channels)));
+    for (int channel : {0, 1, 4, 5}) {
+        EXPECT_FALSE(hasSilentSpan(channel)) << "channel " << channel;
+        EXPECT_GT(getChannelRms(samples, channels, channel), 0.01) << "channel " << channel;
+    }
+    EXPECT_GT(getChannelRms(samples, channels, 3), 0.01);  // LFE
+}
+
+}  // namespace MediaProcessor::Tests
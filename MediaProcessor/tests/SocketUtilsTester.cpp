@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/SocketUtils.h"
+
+namespace MediaProcessor::Tests {
+
+class SocketUtilsTester : public ::testing::Test {
+   protected:
+    int fds[2] = {-1, -1};
+
+    void SetUp() override { ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0); }
+
+    void TearDown() override {
+        for (int fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+};
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST_F(SocketUtilsTester, WriteMessage_ReadMessage_RoundTripsMessages) {
+    ASSERT_TRUE(SocketUtils::writeMessage(fds[0], R"({"command": "ping"})"));
+    ASSERT_TRUE(SocketUtils::writeMessage(fds[0], ""));
+
+    EXPECT_EQ(SocketUtils::readMessage(fds[1]), R"({"command": "ping"})");
+    EXPECT_EQ(SocketUtils::readMessage(fds[1]), "");
+}
+
+TEST_F(SocketUtilsTester, ReadMessage_ClosedPeer_ReturnsNullopt) {
+    // Truncated message: the header announces more bytes than are sent
+    const unsigned char header[] = {0, 0, 0, 10};
+    ASSERT_TRUE(SocketUtils::writeAll(fds[0], header, sizeof(header)));
+    close(fds[0]);
+    fds[0] = -1;
+
+    EXPECT_FALSE(SocketUtils::readMessage(fds[1]).has_value());
+}
+
+TEST_F(SocketUtilsTester, ReadMessage_OversizedMessage_ReturnsNullopt) {
+    const unsigned char header[] = {0xff, 0xff, 0xff, 0xff};
+    ASSERT_TRUE(SocketUtils::writeAll(fds[0], header, sizeof(header)));
+
+    EXPECT_FALSE(SocketUtils::readMessage(fds[1]).has_value());
+}
+
+TEST_F(SocketUtilsTester, WriteSamples_ReadSamples_RoundTripsSamples) {
+    std::vector<float> samples = {0.0f, -1.0f, 0.5f, 1e-7f};
+    ASSERT_TRUE(SocketUtils::writeSamples(fds[0], samples));
+
+    auto received = SocketUtils::readSamples(fds[1]);
+    ASSERT_TRUE(received.has_value());
+    EXPECT_EQ(*received, samples);
+}
+
+TEST(SocketUtilsEndpointTester, ParseEndpoint_HostAndPort_Parsed) {
+    auto endpoint = SocketUtils::parseEndpoint("worker1.local:9000", "127.0.0.1");
+    EXPECT_EQ(endpoint.host, "worker1.local");
+    EXPECT_EQ(endpoint.port, 9000);
+
+    endpoint = SocketUtils::parseEndpoint("[::1]:9001", "127.0.0.1");
+    EXPECT_EQ(endpoint.host, "::1");
+    EXPECT_EQ(endpoint.port, 9001);
+
+    endpoint = SocketUtils::parseEndpoint("9002", "127.0.0.1");
+    EXPECT_EQ(endpoint.host, "127.0.0.1");
+    EXPECT_EQ(endpoint.port, 9002);
+
+    endpoint = SocketUtils::parseEndpoint(":9003", "127.0.0.1");
+    EXPECT_EQ(endpoint.host, "127.0.0.1");
+    EXPECT_EQ(endpoint.port, 9003);
+}
+
+TEST(SocketUtilsEndpointTester, ParseEndpoint_InvalidPort_ThrowsException) {
+    EXPECT_THROW(SocketUtils::parseEndpoint("localhost:", ""), std::runtime_error);
+    EXPECT_THROW(SocketUtils::parseEndpoint("localhost:http", ""), std::runtime_error);
+    EXPECT_THROW(SocketUtils::parseEndpoint("localhost:70000", ""), std::runtime_error);
+}
+
+}  // namespace MediaProcessor::Tests
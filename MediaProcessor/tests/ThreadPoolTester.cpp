@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/ThreadPool.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST(ThreadPoolTester, Enqueue_ReturnsResultsThroughFutures) {
+    ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 1000; ++i) {
+        results.emplace_back(pool.enqueue([](int a, int b) { return a * b; }, i, 2));
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(results[i].get(), i * 2);
+    }
+}
+
+TEST(ThreadPoolTester, Enqueue_MoveOnlyArguments_AreForwarded) {
+    ThreadPool pool(2);
+    auto result = pool.enqueue([](std::unique_ptr<int> value) { return *value; },
+                               std::make_unique<int>(42));
+    EXPECT_EQ(result.get(), 42);
+}
+
+TEST(ThreadPoolTester, Enqueue_ThrowingTask_PropagatesThroughFuture) {
+    ThreadPool pool(2);
+    auto result = pool.enqueue([]() -> int { throw std::runtime_error("failed"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+TEST(ThreadPoolTester, Submit_NestedTasks_AllRunBeforeDestruction) {
+    std::atomic<int> counter = 0;
+    {
+        ThreadPool pool(4);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&pool, &counter] {
+                // Tasks pushed from a worker go to its own deque and get stolen by the others
+                for (int j = 0; j < 100; ++j) {
+                    pool.submit([&counter] { ++counter; });
+                }
+            });
+        }
+    }
+    EXPECT_EQ(counter, 100 * 100);
+}
+
+TEST(ThreadPoolTester, ParallelFor_VisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10007);
+
+    pool.parallel_for(0, visits.size(), 16, [&](size_t i) { ++visits[i]; });
+
+    for (const auto& count : visits) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(ThreadPoolTester, ParallelFor_NestedInWorker_Completes) {
+    ThreadPool pool(2);
+    std::vector<int> sums(8);
+
+    pool.parallel_for(0, sums.size(), 1, [&](size_t i) {
+        std::vector<int> values(1000);
+        pool.parallel_for(0, values.size(), 10, [&](size_t j) { values[j] = 1; });
+        sums[i] = std::accumulate(values.begin(), values.end(), 0);
+    });
+
+    for (int sum : sums) {
+        EXPECT_EQ(sum, 1000);
+    }
+}
+
+TEST(ThreadPoolTester, ParallelFor_ThrowingBody_RethrowsInCaller) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallel_for(0, 1000, 1,
+                                   [](size_t i) {
+                                       if (i == 500) {
+                                           throw std::runtime_error("failed");
+                                       }
+                                   }),
+                 std::runtime_error);
+}
+
+}  // namespace MediaProcessor::Tests
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <set>
+#include <thread>
+
+#include "../src/Tracer.h"
+
+namespace MediaProcessor::Tests {
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+
+class TracerTester : public ::testing::Test {
+   protected:
+    Tracer& tracer = Tracer::getInstance();
+
+    void SetUp() override {
+        tracer.clear();
+    }
+
+    void TearDown() override {
+        tracer.disable();
+        tracer.clear();
+    }
+};
+
+TEST_F(TracerTester, TraceScope_Disabled_RecordsNothing) {
+    {
+        TRACE_SCOPE("disabled");
+    }
+
+    EXPECT_EQ(tracer.getEventCount(), 0);
+}
+
+TEST_F(TracerTester, TraceScope_NestedScopes_RecordsContainedSpans) {
+    tracer.enable();
+    {
+        TRACE_SCOPE("outer");
+        TRACE_SCOPE("inner", "unit", 7);
+    }
+
+    nlohmann::json events = tracer.toChromeTrace()["traceEvents"];
+    nlohmann::json outer, inner;
+    for (const auto& event : events) {
+        if (event["ph"] == "X") {
+            (event["name"] == "outer" ? outer : inner) = event;
+        }
+    }
+
+    ASSERT_FALSE(outer.is_null());
+    ASSERT_FALSE(inner.is_null());
+    EXPECT_EQ(inner["args"]["unit"], 7);
+    EXPECT_GE(inner["ts"].get<double>(), outer["ts"].get<double>());
+    EXPECT_LE(inner["ts"].get<double>() + inner["dur"].get<double>(),
+              outer["ts"].get<double>() + outer["dur"].get<double>());
+}
+
+TEST_F(TracerTester, ToChromeTrace_SeveralThreads_SeparatesTracks) {
+    tracer.enable();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 3; ++i) {
+        threads.emplace_back([]() { TRACE_SCOPE("worker"); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    nlohmann::json trace = tracer.toChromeTrace();
+    std::set<uint32_t> threadIds;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X") {
+            threadIds.insert(event["tid"].get<uint32_t>());
+        }
+    }
+
+    EXPECT_EQ(threadIds.size(), 3);
+}
+
+TEST_F(TracerTester, WriteChromeTrace_RecordedSpans_WritesParsableJson) {
+    fs::path tracePath = fs::temp_directory_path() / "TracerTester.json";
+    tracer.enable();
+    {
+        TRACE_SCOPE("written");
+    }
+
+    ASSERT_TRUE(tracer.writeChromeTrace(tracePath));
+    nlohmann::json trace = nlohmann::json::parse(std::ifstream(tracePath));
+    fs::remove(tracePath);
+
+    EXPECT_EQ(trace["traceEvents"].size(), 2);  // thread name and span
+}
+
+}  // namespace MediaProcessor::Tests
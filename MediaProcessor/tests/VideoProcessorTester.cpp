@@ -1,10 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include "../src/ConfigManager.h"
-#include "../src/Utils.h"
+#include "../src/MediaInfo.h"
+#include "../src/MediaMuxer.h"
+#include "../src/SignalGenerator.h"
 #include "../src/VideoProcessor.h"
 #include "TestUtils.h"
 
@@ -69,10 +73,44 @@ TEST_F(VideoProcessorTester, MergeMedia_MergesAudioAndVideoCorrectly) {
     EXPECT_EQ(videoProcessor.mergeMedia(), true);
     EXPECT_TRUE(fs::exists(testOutputVideoPath));
 
-    double originalDuration = MediaProcessor::Utils::getMediaDuration(testVideoPath);
-    double outputDuration = MediaProcessor::Utils::getMediaDuration(testOutputVideoPath);
+    double originalDuration = MediaInfo::probe(testVideoPath).duration;
+    double outputDuration = MediaInfo::probe(testOutputVideoPath).duration;
     EXPECT_NEAR(originalDuration, outputDuration, 0.5)
         << "Duration of the merged video differs significantly from the original.";
 }
 
+TEST_F(VideoProcessorTester, MediaMuxer_StreamedAudio_EndsWithAudio) {
+    constexpr int sampleRate = 44100;
+    constexpr int channels = 2;
+    constexpr size_t numFrames = sampleRate * 2;
+
+    std::vector<float> interleaved(numFrames * channels);
+    SignalGenerator(sampleRate, channels).generate(interleaved.data(), numFrames);
+    std::vector<std::vector<float>> planes(channels, std::vector<float>(numFrames));
+    for (size_t frame = 0; frame < numFrames; ++frame) {
+        for (size_t channel = 0; channel < channels; ++channel) {
+            planes[channel][frame] = interleaved[frame * channels + channel];
+        }
+    }
+
+    // Blocks that are not a multiple of the encoder's frame size, like merged work units
+    fs::path testOutputVideoPath = testOutputDir / "test_muxed_video.mp4";
+    const MediaInfo videoInfo = MediaInfo::probe(testVideoPath);
+    MediaMuxer muxer(videoInfo, testOutputVideoPath, sampleRate, channels);
+    constexpr size_t blockFrames = 3001;
+    for (size_t offset = 0; offset < numFrames; offset += blockFrames) {
+        const std::vector<const float*> block = {planes[0].data() + offset,
+                                                 planes[1].data() + offset};
+        muxer.writePlanar(block, std::min(blockFrames, numFrames - offset));
+    }
+    muxer.close();
+
+    const MediaInfo outputInfo = MediaInfo::probe(testOutputVideoPath);
+    ASSERT_TRUE(outputInfo.hasVideo());
+    ASSERT_NE(outputInfo.getAudioStream(), nullptr);
+    EXPECT_EQ(outputInfo.getAudioStream()->sampleRate, sampleRate);
+    EXPECT_EQ(outputInfo.getAudioStream()->channels, channels);
+    EXPECT_NEAR(outputInfo.duration, 2.0, 0.2) << "The video should be cut where the audio ends.";
+}
+
 }  // namespace MediaProcessor::Tests
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <thread>
+#include <vector>
+
+#include "../src/ConfigManager.h"
+#include "../src/WorkCoordinator.h"
+#include "../src/WorkerServer.h"
+#include "TestUtils.h"
+
+namespace MediaProcessor::Tests {
+
+constexpr size_t NUM_WORKERS = 3;
+constexpr size_t UNIT_SAMPLES = 48000;
+
+class WorkCoordinatorTester : public ::testing::Test {
+   protected:
+    TestUtils::TestConfigFile testConfigFile;
+    std::vector<std::unique_ptr<WorkerServer>> workers;
+    std::vector<std::thread> workerThreads;
+    std::vector<SocketUtils::Endpoint> endpoints;
+
+    void SetUp() override {
+        ASSERT_TRUE(ConfigManager::getInstance().loadConfig(testConfigFile.getFilePath()));
+
+        for (size_t i = 0; i < NUM_WORKERS; ++i) {
+            workers.push_back(std::make_unique<WorkerServer>(
+                SocketUtils::Endpoint{"127.0.0.1", 0}, 2));
+            workerThreads.emplace_back([worker = workers.back().get()]() { worker->run(); });
+        }
+
+        // Workers bind asynchronously
+        for (auto& worker : workers) {
+            for (int attempt = 0; attempt < 100 && worker->getPort() == 0; ++attempt) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            ASSERT_NE(worker->getPort(), 0);
+            endpoints.push_back({"127.0.0.1", worker->getPort()});
+        }
+    }
+
+    void TearDown() override {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            stopWorker(i);
+        }
+    }
+
+    void stopWorker(size_t index) {
+        workers[index]->stop();
+        if (workerThreads[index].joinable()) {
+            workerThreads[index].join();
+        }
+    }
+
+    static std::vector<float> makeUnit() {
+        std::vector<float> samples(UNIT_SAMPLES);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = 0.5f * std::sin(static_cast<float>(i) * 0.01f);
+        }
+        return samples;
+    }
+};
+
+// ClassName_MethodName_StateUnderTest_ExpectedBehavior gtest std naming convention
+TEST_F(WorkCoordinatorTester, Constructor_ReachableWorkers_SumsCapacity) {
+    WorkCoordinator coordinator(endpoints);
+    EXPECT_EQ(coordinator.getCapacity(), NUM_WORKERS * 2);
+}
+
+TEST_F(WorkCoordinatorTester, Constructor_NoReachableWorker_ThrowsException) {
+    for (size_t i = 0; i < workers.size(); ++i) {
+        stopWorker(i);
+    }
+    EXPECT_THROW(WorkCoordinator coordinator(endpoints), std::runtime_error);
+}
+
+TEST_F(WorkCoordinatorTester, Filter_ConcurrentUnits_ReturnsFilteredUnits) {
+    WorkCoordinator coordinator(endpoints);
+    const std::vector<float> unit = makeUnit();
+
+    std::vector<std::vector<float>> results(coordinator.getCapacity());
+    std::vector<std::thread> threads;
+    for (auto& result : results) {
+        threads.emplace_back([&]() { result = coordinator.filter(unit, 100.0f, 0.0f); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& result : results) {
+        EXPECT_EQ(result.size(), unit.size());
+    }
+}
+
+TEST_F(WorkCoordinatorTester, Filter_WorkerDied_RedispatchesToOtherWorkers) {
+    WorkCoordinator coordinator(endpoints);
+    const std::vector<float> unit = makeUnit();
+
+    // The coordinator still holds pooled connections to the stopped worker
+    stopWorker(0);
+
+    for (size_t i = 0; i < NUM_WORKERS * 2; ++i) {
+        EXPECT_EQ(coordinator.filter(unit, 100.0f, 0.0f).size(), unit.size());
+    }
+    EXPECT_EQ(coordinator.getCapacity(), (NUM_WORKERS - 1) * 2);
+}
+
+TEST_F(WorkCoordinatorTester, Filter_AllWorkersDied_ThrowsException) {
+    WorkCoordinator coordinator(endpoints);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        stopWorker(i);
+    }
+
+    EXPECT_THROW(coordinator.filter(makeUnit(), 100.0f, 0.0f), std::runtime_error);
+}
+
+TEST_F(WorkCoordinatorTester, Filter_WorkerRejectsUnit_ThrowsAndKeepsWorker) {
+    // A worker that is alive but fails every unit, on a single connection
+    const int listenFd = SocketUtils::listenTcp({"127.0.0.1", 0});
+    const SocketUtils::Endpoint endpoint{"127.0.0.1", SocketUtils::getLocalPort(listenFd)};
+    std::thread fakeWorker([listenFd]() {
+        const int fd = accept(listenFd, nullptr, nullptr);
+        while (auto message = SocketUtils::readMessage(fd)) {
+            if (nlohmann::json::parse(*message)["command"] == "filter") {
+                SocketUtils::readSamples(fd);
+                SocketUtils::writeMessage(fd, R"({"status": "failed", "message": "test"})");
+            } else {
+                SocketUtils::writeMessage(fd, R"({"status": "ok", "threads": 1})");
+            }
+        }
+        close(fd);
+    });
+
+    {
+        WorkCoordinator coordinator({endpoint});
+        EXPECT_THROW(coordinator.filter(makeUnit(), 100.0f, 0.0f), std::runtime_error);
+        EXPECT_THROW(coordinator.filter(makeUnit(), 100.0f, 0.0f), std::runtime_error);
+        EXPECT_EQ(coordinator.getCapacity(), 1u);
+    }
+
+    // Closing the coordinator's connection ends the fake worker
+    fakeWorker.join();
+    close(listenFd);
+}
+
+}  // namespace MediaProcessor::Tests
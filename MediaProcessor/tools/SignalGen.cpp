@@ -0,0 +1,111 @@
+#include <sndfile.h>
+
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "../src/AudioDecoder.h"
+#include "../src/SignalGenerator.h"
+
+namespace fs = std::filesystem;
+using namespace MediaProcessor;
+
+namespace {
+
+constexpr size_t BLOCK_FRAMES = 48000;
+
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+void printUsage(const char* executable) {
+    std::cerr << "Usage: " << executable
+              << " --duration <seconds> [--channels <count>] [--sample-rate <hz>] [--seed <n>]"
+                 " <output.wav>"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    /**
+     * @brief Writes a synthetic speech-plus-music signal of any length, see SignalGenerator.h.
+     *
+     * Long outputs are written as RF64, which lifts WAV's 4GB limit for multi-hour signals and
+     * falls back to a plain WAV header when the file stays below it.
+     *
+     * Example: <executable> --duration 36000 --channels 6 ten_hours_5.1.wav
+     */
+    double duration = 0.0;
+    int channels = 1;
+    int sampleRate = DEFAULT_DECODE_SAMPLE_RATE;
+    uint32_t seed = DEFAULT_SIGNAL_SEED;
+    fs::path outputPath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool valid = true;
+        if (arg == "--duration" && i + 1 < argc) {
+            valid = parseNumber(argv[++i], duration) && duration > 0.0;
+        } else if (arg == "--channels" && i + 1 < argc) {
+            valid = parseNumber(argv[++i], channels) && channels >= 1 && channels <= 8;
+        } else if (arg == "--sample-rate" && i + 1 < argc) {
+            valid = parseNumber(argv[++i], sampleRate) && sampleRate > 0;
+        } else if (arg == "--seed" && i + 1 < argc) {
+            valid = parseNumber(argv[++i], seed);
+        } else if (outputPath.empty() && !arg.starts_with("--")) {
+            outputPath = arg;
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (duration <= 0.0 || outputPath.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    SF_INFO sfInfo = {};
+    sfInfo.samplerate = sampleRate;
+    sfInfo.channels = channels;
+    sfInfo.format = SF_FORMAT_RF64 | SF_FORMAT_PCM_16;
+
+    SNDFILE* file = sf_open(outputPath.c_str(), SFM_WRITE, &sfInfo);
+    if (!file) {
+        std::cerr << "Error: Could not open " << outputPath << ": " << sf_strerror(nullptr)
+                  << std::endl;
+        return 1;
+    }
+    sf_command(file, SFC_RF64_AUTO_DOWNGRADE, nullptr, SF_TRUE);
+
+    SignalGenerator generator(sampleRate, channels, seed);
+    std::vector<float> block(BLOCK_FRAMES * channels);
+    const auto totalFrames = static_cast<size_t>(std::llround(duration * sampleRate));
+
+    for (size_t written = 0; written < totalFrames;) {
+        const size_t frames = std::min(BLOCK_FRAMES, totalFrames - written);
+        generator.generate(block.data(), frames);
+        if (sf_writef_float(file, block.data(), frames) != static_cast<sf_count_t>(frames)) {
+            std::cerr << "Error: Could not write " << outputPath << ": " << sf_strerror(file)
+                      << std::endl;
+            sf_close(file);
+            return 1;
+        }
+        written += frames;
+    }
+
+    sf_close(file);
+    std::cout << "Generated " << duration << "s of " << channels << "-channel audio: "
+              << outputPath << std::endl;
+    return 0;
+}
@@ -2,6 +2,8 @@ import json
 import logging
 import os
 import re
+import socket
+import struct
 import subprocess
 from urllib.parse import urlparse
 
@@ -35,6 +37,13 @@ BASE_DIR = os.path.abspath(os.path.dirname(__file__))
 DOWNLOADS_PATH = os.path.abspath(config["downloads_path"])
 UPLOADS_PATH = os.path.abspath(config.get("uploads_path", os.path.join(BASE_DIR, "uploads")))
 
+# Socket of a resident `MediaProcessor --serve` daemon, used when it is running. The default
+# matches the daemon's: the private runtime directory of the user, or /tmp if there is none.
+MEDIA_PROCESSOR_SOCKET = config.get(
+    "media_processor_socket",
+    os.path.join(os.environ.get("XDG_RUNTIME_DIR") or "/tmp", "MediaProcessor.sock"),
+)
+
 DEEPFILTERNET_PATH = os.path.abspath(config["deep_filter_path"])
 FFMPEG_PATH = os.path.abspath(config["ffmpeg_path"])
 
@@ -145,9 +154,58 @@ class MediaHandler:
             logging.error(f"Error detecting media type: {e.stderr}")
             return None
 
+    @staticmethod
+    def _send_message(sock, message):
+        payload = json.dumps(message).encode()
+        sock.sendall(struct.pack(">I", len(payload)) + payload)
+
+    @staticmethod
+    def _receive_message(sock):
+        def receive_exactly(size):
+            data = b""
+            while len(data) < size:
+                chunk = sock.recv(size - len(data))
+                if not chunk:
+                    raise ConnectionError("MediaProcessor daemon closed the connection.")
+                data += chunk
+            return data
+
+        (size,) = struct.unpack(">I", receive_exactly(4))
+        return json.loads(receive_exactly(size))
+
+    @staticmethod
+    def process_with_daemon(media_path):
+        """Process the given file with a resident MediaProcessor daemon, see `JobServer.h`."""
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+            sock.connect(MEDIA_PROCESSOR_SOCKET)
+            MediaHandler._send_message(sock, {"command": "process", "path": str(media_path)})
+
+            while True:
+                reply = MediaHandler._receive_message(sock)
+                if reply["status"] == "completed":
+                    processed_media_path = os.path.abspath(reply["output_path"])
+                    logging.info(f"Processed media path returned: {processed_media_path}")
+                    if "metrics" in reply:
+                        logging.info(f"Real-time factor: {reply['metrics']['rtf']:.3f}")
+                    return processed_media_path
+                if reply["status"] == "failed":
+                    logging.error(f"MediaProcessor daemon failed: {reply.get('message')}")
+                    return None
+                if reply["status"] == "rejected":
+                    logging.error(f"MediaProcessor daemon is too busy: {reply.get('message')}")
+                    return None
+
     @staticmethod
     def process_with_media_processor(media_path):
         """Process the given file with the MediaProcessor (C++ binary)."""
+        if os.path.exists(MEDIA_PROCESSOR_SOCKET):
+            try:
+                logging.info(f"Processing media file with daemon: {media_path}")
+                return MediaHandler.process_with_daemon(media_path)
+            except (OSError, ValueError, KeyError) as e:
+                # Also covers truncated or malformed replies, json.JSONDecodeError is a ValueError
+                logging.warning(f"MediaProcessor daemon unavailable, spawning binary instead: {e}")
+
         try:
             logging.info(f"Processing media file with path: {media_path}")
 
@@ -165,6 +223,8 @@ class MediaHandler:
 
             # Parse output
             for line in result.stdout.splitlines():
+                if line.startswith("INFO: RTF "):
+                    logging.info(f"MediaProcessor {line[len('INFO: '):]}")
                 if "Video processed successfully" in line or "Audio processed successfully" in line:
                     processed_media_path = line.split(": ", 1)[1].strip()
 